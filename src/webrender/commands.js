@@ -0,0 +1,616 @@
+// Opcodes must match the enum in wasm/commandBuffer.h
+export const SCISSOR = 1;
+export const VIEWPORT = 2;
+export const ACTIVE_TEXTURE = 3;
+export const BLEND_COLOR = 4;
+export const BLEND_EQUATION = 5;
+export const BLEND_EQUATION_SEPARATE = 6;
+export const BLEND_FUNC = 7;
+export const BLEND_FUNC_SEPARATE = 8;
+export const CLEAR_COLOR = 9;
+export const CLEAR_DEPTH = 10;
+export const CLEAR_STENCIL = 11;
+export const COLOR_MASK = 12;
+export const CULL_FACE = 13;
+export const DEPTH_FUNC = 14;
+export const DEPTH_MASK = 15;
+export const DEPTH_RANGE = 16;
+export const DISABLE = 17;
+export const ENABLE = 18;
+export const FRONT_FACE = 19;
+export const HINT = 20;
+export const LINE_WIDTH = 21;
+export const PIXEL_STOREI = 22;
+export const POLYGON_OFFSET = 23;
+export const SAMPLE_COVERAGE = 24;
+export const STENCIL_FUNC = 25;
+export const STENCIL_FUNC_SEPARATE = 26;
+export const STENCIL_MASK = 27;
+export const STENCIL_MASK_SEPARATE = 28;
+export const STENCIL_OP = 29;
+export const STENCIL_OP_SEPARATE = 30;
+export const BIND_BUFFER = 31;
+export const CREATE_BUFFER = 32;
+export const DELETE_BUFFER = 33;
+export const COPY_BUFFER_SUB_DATA = 34;
+export const BIND_FRAMEBUFFER = 35;
+export const CREATE_FRAMEBUFFER = 36;
+export const DELETE_FRAMEBUFFER = 37;
+export const FRAMEBUFFER_RENDERBUFFER = 38;
+export const FRAMEBUFFER_TEXTURE2_D = 39;
+export const READ_PIXELS_BUFFER = 40;
+export const BLIT_FRAMEBUFFER = 41;
+export const FRAMEBUFFER_TEXTURE_LAYER = 42;
+export const INVALIDATE_FRAMEBUFFER = 43;
+export const INVALIDATE_SUB_FRAMEBUFFER = 44;
+export const READ_BUFFER = 45;
+export const BIND_RENDERBUFFER = 46;
+export const CREATE_RENDERBUFFER = 47;
+export const DELETE_RENDERBUFFER = 48;
+export const RENDERBUFFER_STORAGE = 49;
+export const RENDERBUFFER_STORAGE_MULTISAMPLE = 50;
+export const BIND_TEXTURE = 51;
+export const COPY_TEX_SUB_IMAGE2_D = 52;
+export const CREATE_TEXTURE = 53;
+export const DELETE_TEXTURE = 54;
+export const GENERATE_MIPMAP = 55;
+export const TEX_SUB_IMAGE2_D_BUFFER = 56;
+export const TEX_PARAMETERI = 57;
+export const TEX_PARAMETERF = 58;
+export const TEX_STORAGE2_D = 59;
+export const TEX_STORAGE3_D = 60;
+export const TEX_SUB_IMAGE3_D_BUFFER = 61;
+export const ATTACH_SHADER = 62;
+export const COMPILE_SHADER = 63;
+export const CREATE_PROGRAM = 64;
+export const CREATE_SHADER = 65;
+export const DELETE_PROGRAM = 66;
+export const DELETE_SHADER = 67;
+export const DETACH_SHADER = 68;
+export const LINK_PROGRAM = 69;
+export const USE_PROGRAM = 70;
+export const VALIDATE_PROGRAM = 71;
+export const DISABLE_VERTEX_ATTRIB_ARRAY = 72;
+export const ENABLE_VERTEX_ATTRIB_ARRAY = 73;
+export const UNIFORM1F = 74;
+export const UNIFORM2F = 75;
+export const UNIFORM3F = 76;
+export const UNIFORM4F = 77;
+export const UNIFORM1I = 78;
+export const UNIFORM2I = 79;
+export const UNIFORM3I = 80;
+export const UNIFORM4I = 81;
+export const UNIFORM1UI = 82;
+export const UNIFORM2UI = 83;
+export const UNIFORM3UI = 84;
+export const UNIFORM4UI = 85;
+export const UNIFORM1FV = 86;
+export const UNIFORM2FV = 87;
+export const UNIFORM3FV = 88;
+export const UNIFORM4FV = 89;
+export const UNIFORM1IV = 90;
+export const UNIFORM2IV = 91;
+export const UNIFORM3IV = 92;
+export const UNIFORM4IV = 93;
+export const UNIFORM1UIV = 94;
+export const UNIFORM2UIV = 95;
+export const UNIFORM3UIV = 96;
+export const UNIFORM4UIV = 97;
+export const UNIFORM_MATRIX2FV = 98;
+export const UNIFORM_MATRIX3FV = 99;
+export const UNIFORM_MATRIX4FV = 100;
+export const UNIFORM_MATRIX2X3FV = 101;
+export const UNIFORM_MATRIX3X2FV = 102;
+export const UNIFORM_MATRIX2X4FV = 103;
+export const UNIFORM_MATRIX4X2FV = 104;
+export const UNIFORM_MATRIX3X4FV = 105;
+export const UNIFORM_MATRIX4X3FV = 106;
+export const VERTEX_ATTRIB1F = 107;
+export const VERTEX_ATTRIB2F = 108;
+export const VERTEX_ATTRIB3F = 109;
+export const VERTEX_ATTRIB4F = 110;
+export const VERTEX_ATTRIB_POINTER = 111;
+export const VERTEX_ATTRIB_I4I = 112;
+export const VERTEX_ATTRIB_I4UI = 113;
+export const VERTEX_ATTRIB_I_POINTER = 114;
+export const CLEAR = 115;
+export const DRAW_ARRAYS = 116;
+export const DRAW_ELEMENTS = 117;
+export const FLUSH = 118;
+export const VERTEX_ATTRIB_DIVISOR = 119;
+export const DRAW_ARRAYS_INSTANCED = 120;
+export const DRAW_ELEMENTS_INSTANCED = 121;
+export const DRAW_RANGE_ELEMENTS = 122;
+export const DRAW_BUFFERS = 123;
+export const CLEAR_BUFFERIV = 124;
+export const CLEAR_BUFFERUIV = 125;
+export const CLEAR_BUFFERFV = 126;
+export const CLEAR_BUFFERFI = 127;
+export const CREATE_QUERY = 128;
+export const DELETE_QUERY = 129;
+export const BEGIN_QUERY = 130;
+export const END_QUERY = 131;
+export const CREATE_SAMPLER = 132;
+export const DELETE_SAMPLER = 133;
+export const BIND_SAMPLER = 134;
+export const SAMPLER_PARAMETERI = 135;
+export const SAMPLER_PARAMETERF = 136;
+export const FENCE_SYNC = 137;
+export const DELETE_SYNC = 138;
+export const BIND_BUFFER_BASE = 139;
+export const BIND_BUFFER_RANGE = 140;
+export const UNIFORM_BLOCK_BINDING = 141;
+export const CREATE_VERTEX_ARRAY = 142;
+export const DELETE_VERTEX_ARRAY = 143;
+export const BIND_VERTEX_ARRAY = 144;
+export const QUERY_COUNTER = 145;
+export const MULTI_DRAW_ARRAYS = 146;
+export const MULTI_DRAW_ELEMENTS = 147;
+export const MULTI_DRAW_ELEMENTS_INSTANCED = 148;
+
+export default function createCommandDecoder(bindings, memory) {
+  const {
+    int32View,
+    uint32View,
+    float32View,
+  } = memory;
+
+  return function glExecuteCommands(data, size) {
+    const i32 = int32View(), u32 = uint32View(), f32 = float32View();
+    let pos = data >> 2;
+    const end = pos + size;
+    while (pos < end) {
+      const header = u32[pos], p = pos + 1;
+      pos = p + (header >>> 8);
+      switch (header & 0xFF) {
+      case SCISSOR:
+        bindings.glScissor(i32[p], i32[p + 1], i32[p + 2], i32[p + 3]);
+        break;
+      case VIEWPORT:
+        bindings.glViewport(i32[p], i32[p + 1], i32[p + 2], i32[p + 3]);
+        break;
+      case ACTIVE_TEXTURE:
+        bindings.glActiveTexture(u32[p]);
+        break;
+      case BLEND_COLOR:
+        bindings.glBlendColor(f32[p], f32[p + 1], f32[p + 2], f32[p + 3]);
+        break;
+      case BLEND_EQUATION:
+        bindings.glBlendEquation(u32[p]);
+        break;
+      case BLEND_EQUATION_SEPARATE:
+        bindings.glBlendEquationSeparate(u32[p], u32[p + 1]);
+        break;
+      case BLEND_FUNC:
+        bindings.glBlendFunc(u32[p], u32[p + 1]);
+        break;
+      case BLEND_FUNC_SEPARATE:
+        bindings.glBlendFuncSeparate(u32[p], u32[p + 1], u32[p + 2], u32[p + 3]);
+        break;
+      case CLEAR_COLOR:
+        bindings.glClearColor(f32[p], f32[p + 1], f32[p + 2], f32[p + 3]);
+        break;
+      case CLEAR_DEPTH:
+        bindings.glClearDepth(f32[p]);
+        break;
+      case CLEAR_STENCIL:
+        bindings.glClearStencil(i32[p]);
+        break;
+      case COLOR_MASK:
+        bindings.glColorMask(u32[p] !== 0, u32[p + 1] !== 0, u32[p + 2] !== 0, u32[p + 3] !== 0);
+        break;
+      case CULL_FACE:
+        bindings.glCullFace(u32[p]);
+        break;
+      case DEPTH_FUNC:
+        bindings.glDepthFunc(u32[p]);
+        break;
+      case DEPTH_MASK:
+        bindings.glDepthMask(u32[p] !== 0);
+        break;
+      case DEPTH_RANGE:
+        bindings.glDepthRange(f32[p], f32[p + 1]);
+        break;
+      case DISABLE:
+        bindings.glDisable(u32[p]);
+        break;
+      case ENABLE:
+        bindings.glEnable(u32[p]);
+        break;
+      case FRONT_FACE:
+        bindings.glFrontFace(u32[p]);
+        break;
+      case HINT:
+        bindings.glHint(u32[p], u32[p + 1]);
+        break;
+      case LINE_WIDTH:
+        bindings.glLineWidth(f32[p]);
+        break;
+      case PIXEL_STOREI:
+        bindings.glPixelStorei(u32[p], i32[p + 1]);
+        break;
+      case POLYGON_OFFSET:
+        bindings.glPolygonOffset(f32[p], f32[p + 1]);
+        break;
+      case SAMPLE_COVERAGE:
+        bindings.glSampleCoverage(f32[p], u32[p + 1] !== 0);
+        break;
+      case STENCIL_FUNC:
+        bindings.glStencilFunc(u32[p], i32[p + 1], u32[p + 2]);
+        break;
+      case STENCIL_FUNC_SEPARATE:
+        bindings.glStencilFuncSeparate(u32[p], u32[p + 1], i32[p + 2], u32[p + 3]);
+        break;
+      case STENCIL_MASK:
+        bindings.glStencilMask(u32[p]);
+        break;
+      case STENCIL_MASK_SEPARATE:
+        bindings.glStencilMaskSeparate(u32[p], u32[p + 1]);
+        break;
+      case STENCIL_OP:
+        bindings.glStencilOp(u32[p], u32[p + 1], u32[p + 2]);
+        break;
+      case STENCIL_OP_SEPARATE:
+        bindings.glStencilOpSeparate(u32[p], u32[p + 1], u32[p + 2], u32[p + 3]);
+        break;
+      case BIND_BUFFER:
+        bindings.glBindBuffer(u32[p], u32[p + 1]);
+        break;
+      case CREATE_BUFFER:
+        bindings.glCreateBuffer(u32[p]);
+        break;
+      case DELETE_BUFFER:
+        bindings.glDeleteBuffer(u32[p]);
+        break;
+      case COPY_BUFFER_SUB_DATA:
+        bindings.glCopyBufferSubData(u32[p], u32[p + 1], u32[p + 2], u32[p + 3], u32[p + 4]);
+        break;
+      case BIND_FRAMEBUFFER:
+        bindings.glBindFramebuffer(u32[p], u32[p + 1]);
+        break;
+      case CREATE_FRAMEBUFFER:
+        bindings.glCreateFramebuffer(u32[p]);
+        break;
+      case DELETE_FRAMEBUFFER:
+        bindings.glDeleteFramebuffer(u32[p]);
+        break;
+      case FRAMEBUFFER_RENDERBUFFER:
+        bindings.glFramebufferRenderbuffer(u32[p], u32[p + 1], u32[p + 2], u32[p + 3]);
+        break;
+      case FRAMEBUFFER_TEXTURE2_D:
+        bindings.glFramebufferTexture2D(u32[p], u32[p + 1], u32[p + 2], u32[p + 3], i32[p + 4]);
+        break;
+      case READ_PIXELS_BUFFER:
+        bindings.glReadPixelsBuffer(i32[p], i32[p + 1], i32[p + 2], i32[p + 3], u32[p + 4], u32[p + 5], u32[p + 6]);
+        break;
+      case BLIT_FRAMEBUFFER:
+        bindings.glBlitFramebuffer(i32[p], i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5], i32[p + 6], i32[p + 7], u32[p + 8], u32[p + 9]);
+        break;
+      case FRAMEBUFFER_TEXTURE_LAYER:
+        bindings.glFramebufferTextureLayer(u32[p], u32[p + 1], u32[p + 2], i32[p + 3], i32[p + 4]);
+        break;
+      case INVALIDATE_FRAMEBUFFER:
+        bindings.glInvalidateFramebuffer(u32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case INVALIDATE_SUB_FRAMEBUFFER:
+        bindings.glInvalidateSubFramebuffer(u32[p], i32[p + 1], (p + 6) << 2, i32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5]);
+        break;
+      case READ_BUFFER:
+        bindings.glReadBuffer(u32[p]);
+        break;
+      case BIND_RENDERBUFFER:
+        bindings.glBindRenderbuffer(u32[p], u32[p + 1]);
+        break;
+      case CREATE_RENDERBUFFER:
+        bindings.glCreateRenderbuffer(u32[p]);
+        break;
+      case DELETE_RENDERBUFFER:
+        bindings.glDeleteRenderbuffer(u32[p]);
+        break;
+      case RENDERBUFFER_STORAGE:
+        bindings.glRenderbufferStorage(u32[p], u32[p + 1], i32[p + 2], i32[p + 3]);
+        break;
+      case RENDERBUFFER_STORAGE_MULTISAMPLE:
+        bindings.glRenderbufferStorageMultisample(u32[p], i32[p + 1], u32[p + 2], i32[p + 3], i32[p + 4]);
+        break;
+      case BIND_TEXTURE:
+        bindings.glBindTexture(u32[p], u32[p + 1]);
+        break;
+      case COPY_TEX_SUB_IMAGE2_D:
+        bindings.glCopyTexSubImage2D(u32[p], i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5], i32[p + 6], i32[p + 7]);
+        break;
+      case CREATE_TEXTURE:
+        bindings.glCreateTexture(u32[p]);
+        break;
+      case DELETE_TEXTURE:
+        bindings.glDeleteTexture(u32[p]);
+        break;
+      case GENERATE_MIPMAP:
+        bindings.glGenerateMipmap(u32[p]);
+        break;
+      case TEX_SUB_IMAGE2_D_BUFFER:
+        bindings.glTexSubImage2DBuffer(u32[p], i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5], u32[p + 6], u32[p + 7], u32[p + 8]);
+        break;
+      case TEX_PARAMETERI:
+        bindings.glTexParameteri(u32[p], u32[p + 1], i32[p + 2]);
+        break;
+      case TEX_PARAMETERF:
+        bindings.glTexParameterf(u32[p], u32[p + 1], f32[p + 2]);
+        break;
+      case TEX_STORAGE2_D:
+        bindings.glTexStorage2D(u32[p], i32[p + 1], u32[p + 2], i32[p + 3], i32[p + 4]);
+        break;
+      case TEX_STORAGE3_D:
+        bindings.glTexStorage3D(u32[p], i32[p + 1], u32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5]);
+        break;
+      case TEX_SUB_IMAGE3_D_BUFFER:
+        bindings.glTexSubImage3DBuffer(u32[p], i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4], i32[p + 5], i32[p + 6], i32[p + 7], u32[p + 8], u32[p + 9], u32[p + 10]);
+        break;
+      case ATTACH_SHADER:
+        bindings.glAttachShader(u32[p], u32[p + 1]);
+        break;
+      case COMPILE_SHADER:
+        bindings.glCompileShader(u32[p]);
+        break;
+      case CREATE_PROGRAM:
+        bindings.glCreateProgram(u32[p]);
+        break;
+      case CREATE_SHADER:
+        bindings.glCreateShader(u32[p], u32[p + 1]);
+        break;
+      case DELETE_PROGRAM:
+        bindings.glDeleteProgram(u32[p]);
+        break;
+      case DELETE_SHADER:
+        bindings.glDeleteShader(u32[p]);
+        break;
+      case DETACH_SHADER:
+        bindings.glDetachShader(u32[p], u32[p + 1]);
+        break;
+      case LINK_PROGRAM:
+        bindings.glLinkProgram(u32[p]);
+        break;
+      case USE_PROGRAM:
+        bindings.glUseProgram(u32[p]);
+        break;
+      case VALIDATE_PROGRAM:
+        bindings.glValidateProgram(u32[p]);
+        break;
+      case DISABLE_VERTEX_ATTRIB_ARRAY:
+        bindings.glDisableVertexAttribArray(u32[p]);
+        break;
+      case ENABLE_VERTEX_ATTRIB_ARRAY:
+        bindings.glEnableVertexAttribArray(u32[p]);
+        break;
+      case UNIFORM1F:
+        bindings.glUniform1f(i32[p], f32[p + 1]);
+        break;
+      case UNIFORM2F:
+        bindings.glUniform2f(i32[p], f32[p + 1], f32[p + 2]);
+        break;
+      case UNIFORM3F:
+        bindings.glUniform3f(i32[p], f32[p + 1], f32[p + 2], f32[p + 3]);
+        break;
+      case UNIFORM4F:
+        bindings.glUniform4f(i32[p], f32[p + 1], f32[p + 2], f32[p + 3], f32[p + 4]);
+        break;
+      case UNIFORM1I:
+        bindings.glUniform1i(i32[p], i32[p + 1]);
+        break;
+      case UNIFORM2I:
+        bindings.glUniform2i(i32[p], i32[p + 1], i32[p + 2]);
+        break;
+      case UNIFORM3I:
+        bindings.glUniform3i(i32[p], i32[p + 1], i32[p + 2], i32[p + 3]);
+        break;
+      case UNIFORM4I:
+        bindings.glUniform4i(i32[p], i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4]);
+        break;
+      case UNIFORM1UI:
+        bindings.glUniform1ui(i32[p], u32[p + 1]);
+        break;
+      case UNIFORM2UI:
+        bindings.glUniform2ui(i32[p], u32[p + 1], u32[p + 2]);
+        break;
+      case UNIFORM3UI:
+        bindings.glUniform3ui(i32[p], u32[p + 1], u32[p + 2], u32[p + 3]);
+        break;
+      case UNIFORM4UI:
+        bindings.glUniform4ui(i32[p], u32[p + 1], u32[p + 2], u32[p + 3], u32[p + 4]);
+        break;
+      case UNIFORM1FV:
+        bindings.glUniform1fv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM2FV:
+        bindings.glUniform2fv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM3FV:
+        bindings.glUniform3fv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM4FV:
+        bindings.glUniform4fv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM1IV:
+        bindings.glUniform1iv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM2IV:
+        bindings.glUniform2iv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM3IV:
+        bindings.glUniform3iv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM4IV:
+        bindings.glUniform4iv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM1UIV:
+        bindings.glUniform1uiv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM2UIV:
+        bindings.glUniform2uiv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM3UIV:
+        bindings.glUniform3uiv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM4UIV:
+        bindings.glUniform4uiv(i32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case UNIFORM_MATRIX2FV:
+        bindings.glUniformMatrix2fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX3FV:
+        bindings.glUniformMatrix3fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX4FV:
+        bindings.glUniformMatrix4fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX2X3FV:
+        bindings.glUniformMatrix2x3fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX3X2FV:
+        bindings.glUniformMatrix3x2fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX2X4FV:
+        bindings.glUniformMatrix2x4fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX4X2FV:
+        bindings.glUniformMatrix4x2fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX3X4FV:
+        bindings.glUniformMatrix3x4fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case UNIFORM_MATRIX4X3FV:
+        bindings.glUniformMatrix4x3fv(i32[p], i32[p + 1], u32[p + 2] !== 0, (p + 3) << 2);
+        break;
+      case VERTEX_ATTRIB1F:
+        bindings.glVertexAttrib1f(u32[p], f32[p + 1]);
+        break;
+      case VERTEX_ATTRIB2F:
+        bindings.glVertexAttrib2f(u32[p], f32[p + 1], f32[p + 2]);
+        break;
+      case VERTEX_ATTRIB3F:
+        bindings.glVertexAttrib3f(u32[p], f32[p + 1], f32[p + 2], f32[p + 3]);
+        break;
+      case VERTEX_ATTRIB4F:
+        bindings.glVertexAttrib4f(u32[p], f32[p + 1], f32[p + 2], f32[p + 3], f32[p + 4]);
+        break;
+      case VERTEX_ATTRIB_POINTER:
+        bindings.glVertexAttribPointer(u32[p], i32[p + 1], u32[p + 2], u32[p + 3] !== 0, i32[p + 4], u32[p + 5]);
+        break;
+      case VERTEX_ATTRIB_I4I:
+        bindings.glVertexAttribI4i(u32[p], i32[p + 1], i32[p + 2], i32[p + 3], i32[p + 4]);
+        break;
+      case VERTEX_ATTRIB_I4UI:
+        bindings.glVertexAttribI4ui(u32[p], u32[p + 1], u32[p + 2], u32[p + 3], u32[p + 4]);
+        break;
+      case VERTEX_ATTRIB_I_POINTER:
+        bindings.glVertexAttribIPointer(u32[p], i32[p + 1], u32[p + 2], i32[p + 3], u32[p + 4]);
+        break;
+      case CLEAR:
+        bindings.glClear(u32[p]);
+        break;
+      case DRAW_ARRAYS:
+        bindings.glDrawArrays(u32[p], i32[p + 1], i32[p + 2]);
+        break;
+      case DRAW_ELEMENTS:
+        bindings.glDrawElements(u32[p], i32[p + 1], u32[p + 2], u32[p + 3]);
+        break;
+      case FLUSH:
+        bindings.glFlush();
+        break;
+      case VERTEX_ATTRIB_DIVISOR:
+        bindings.glVertexAttribDivisor(u32[p], u32[p + 1]);
+        break;
+      case DRAW_ARRAYS_INSTANCED:
+        bindings.glDrawArraysInstanced(u32[p], i32[p + 1], i32[p + 2], i32[p + 3]);
+        break;
+      case DRAW_ELEMENTS_INSTANCED:
+        bindings.glDrawElementsInstanced(u32[p], i32[p + 1], u32[p + 2], u32[p + 3], i32[p + 4]);
+        break;
+      case DRAW_RANGE_ELEMENTS:
+        bindings.glDrawRangeElements(u32[p], u32[p + 1], u32[p + 2], i32[p + 3], u32[p + 4], u32[p + 5]);
+        break;
+      case DRAW_BUFFERS:
+        bindings.glDrawBuffers(i32[p], (p + 1) << 2);
+        break;
+      case CLEAR_BUFFERIV:
+        bindings.glClearBufferiv(u32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case CLEAR_BUFFERUIV:
+        bindings.glClearBufferuiv(u32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case CLEAR_BUFFERFV:
+        bindings.glClearBufferfv(u32[p], i32[p + 1], (p + 2) << 2);
+        break;
+      case CLEAR_BUFFERFI:
+        bindings.glClearBufferfi(u32[p], i32[p + 1], f32[p + 2], i32[p + 3]);
+        break;
+      case CREATE_QUERY:
+        bindings.glCreateQuery(u32[p]);
+        break;
+      case DELETE_QUERY:
+        bindings.glDeleteQuery(u32[p]);
+        break;
+      case BEGIN_QUERY:
+        bindings.glBeginQuery(u32[p], u32[p + 1]);
+        break;
+      case END_QUERY:
+        bindings.glEndQuery(u32[p]);
+        break;
+      case CREATE_SAMPLER:
+        bindings.glCreateSampler(u32[p]);
+        break;
+      case DELETE_SAMPLER:
+        bindings.glDeleteSampler(u32[p]);
+        break;
+      case BIND_SAMPLER:
+        bindings.glBindSampler(u32[p], u32[p + 1]);
+        break;
+      case SAMPLER_PARAMETERI:
+        bindings.glSamplerParameteri(u32[p], u32[p + 1], i32[p + 2]);
+        break;
+      case SAMPLER_PARAMETERF:
+        bindings.glSamplerParameterf(u32[p], u32[p + 1], f32[p + 2]);
+        break;
+      case FENCE_SYNC:
+        bindings.glFenceSync(u32[p], u32[p + 1], u32[p + 2]);
+        break;
+      case DELETE_SYNC:
+        bindings.glDeleteSync(u32[p]);
+        break;
+      case BIND_BUFFER_BASE:
+        bindings.glBindBufferBase(u32[p], u32[p + 1], u32[p + 2]);
+        break;
+      case BIND_BUFFER_RANGE:
+        bindings.glBindBufferRange(u32[p], u32[p + 1], u32[p + 2], u32[p + 3], u32[p + 4]);
+        break;
+      case UNIFORM_BLOCK_BINDING:
+        bindings.glUniformBlockBinding(u32[p], u32[p + 1], u32[p + 2]);
+        break;
+      case CREATE_VERTEX_ARRAY:
+        bindings.glCreateVertexArray(u32[p]);
+        break;
+      case DELETE_VERTEX_ARRAY:
+        bindings.glDeleteVertexArray(u32[p]);
+        break;
+      case BIND_VERTEX_ARRAY:
+        bindings.glBindVertexArray(u32[p]);
+        break;
+      case QUERY_COUNTER:
+        bindings.glQueryCounter(u32[p], u32[p + 1]);
+        break;
+      case MULTI_DRAW_ARRAYS:
+        bindings.glMultiDrawArrays(u32[p], (p + 2) << 2, (p + 2 + i32[p + 1]) << 2, i32[p + 1]);
+        break;
+      case MULTI_DRAW_ELEMENTS:
+        bindings.glMultiDrawElements(u32[p], (p + 3) << 2, u32[p + 1], (p + 3 + i32[p + 2]) << 2, i32[p + 2]);
+        break;
+      case MULTI_DRAW_ELEMENTS_INSTANCED:
+        bindings.glMultiDrawElementsInstanced(u32[p], (p + 3) << 2, u32[p + 1], (p + 3 + i32[p + 2]) << 2,
+                                              (p + 3 + i32[p + 2] * 2) << 2, i32[p + 2]);
+        break;
+      default:
+        throw new Error(`invalid command ${header & 0xFF}`);
+      }
+    }
+  };
+}
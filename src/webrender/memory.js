@@ -101,33 +101,33 @@ export default function WasmMemory() {
       view[data + array.length] = 0;
     }
     if (length) {
-      uint32View()[length] = array.length;
+      uint32View()[length >> 2] = array.length;
     }
   }
 
   function writeInt32(value, offset) {
-    if (value.hasOwnProperty("length")) {
+    if (ArrayBuffer.isView(value) || Array.isArray(value)) {
       int32View().set(value, offset >> 2);
     } else {
       int32View()[offset >> 2] = value;
     }
   }
   function writeUint32(value, offset) {
-    if (value.hasOwnProperty("length")) {
+    if (ArrayBuffer.isView(value) || Array.isArray(value)) {
       uint32View().set(value, offset >> 2);
     } else {
       uint32View()[offset >> 2] = value;
     }
   }
   function writeFloat32(value, offset) {
-    if (value.hasOwnProperty("length")) {
+    if (ArrayBuffer.isView(value) || Array.isArray(value)) {
       float32View().set(value, offset >> 2);
     } else {
       float32View()[offset >> 2] = value;
     }
   }
   function writeFloat64(value, offset) {
-    if (value.hasOwnProperty("length")) {
+    if (ArrayBuffer.isView(value) || Array.isArray(value)) {
       float64View().set(value, offset >> 3);
     } else {
       float64View()[offset >> 3] = value;
@@ -1,12 +1,35 @@
 import WasmMemory from './memory';
 import createBindings from './webglapi';
 
+// Fields of FrameStats in wasm/frameStats.h, in order
+const FRAME_STATS = [
+  'frame',
+  'draws',
+  'triangles',
+  'programSwitches',
+  'vertexArrayBinds',
+  'textureBinds',
+  'redundantBinds',
+  'bufferBytes',
+  'textureBytes',
+  'frameBufferSwitches',
+];
+
 export default class WebGLApi {
-  objects_ = new Map();
+  // Indexed by the slot of an object handle, handles_ holds the full handle of the
+  // live object in each slot; slot 0 is the null handle
+  objects_ = [null];
+  handles_ = [0];
   objectsReverse_ = new Map();
-  uniformLocations_ = new Map();
+  uniformLocations_ = [null];
   uniformLocationsReverse_ = new Map();
   extensions_ = {};
+  // Address of the FrameStatsBuffer, 0 if the module was built without stats
+  frameStats_ = 0;
+  // Receives frame captures (wasm/frameCapture.h) as ArrayBuffers
+  onTrace = null;
+  // Receives the objects a debug build found alive at shutdown; logged if unset
+  onLeaks = null;
 
   getExtension(name) {
     if (this.extensions_.hasOwnProperty(name)) {
@@ -15,6 +38,20 @@ export default class WebGLApi {
     return this.extensions_[name] = this.context.getExtension(name);
   }
 
+  // Counters of the last completed frame, read from linear memory without a call
+  // into wasm; null if stats are compiled out
+  frameStats() {
+    if (!this.frameStats_) {
+      return null;
+    }
+    const u32 = this.memory.uint32View();
+    const front = u32[this.frameStats_ >> 2];
+    const base = (this.frameStats_ >> 2) + 1 + front * FRAME_STATS.length;
+    const stats = {};
+    FRAME_STATS.forEach((name, i) => stats[name] = u32[base + i]);
+    return stats;
+  }
+
   constructor(gl) {
     this.context = gl;
     this.memory = WasmMemory();
@@ -1,8 +1,10 @@
 #include "alloc.h"
+#include "malloc.h"
+#include "glbindings.h"
 
 static const size_t PTRSIZE = sizeof(void*);
 
-SizedPool::SizedPool(size_t blockSize, size_t pageSize = 65536)
+SizedPool::SizedPool(size_t blockSize, size_t pageSize)
   : blockSize_(blockSize < PTRSIZE ? PTRSIZE : blockSize)
   , pageSize_((pageSize - PTRSIZE) / blockSize * blockSize + PTRSIZE)
 {
@@ -39,8 +41,50 @@ void SizedPool::free(void* ptr) {
   *(void**)ptr = freeBlock_;
   freeBlock_ = ptr;
 }
+void SizedPool::free(void* first, void* last) {
+  *(void**)last = freeBlock_;
+  freeBlock_ = first;
+}
 void SizedPool::clear() {
   curPage_ = firstPage_;
   pageOffset_ = PTRSIZE;
   freeBlock_ = nullptr;
 }
+
+HandlePool GLBase::handles_;
+
+ui32 HandlePool::alloc() {
+  size_ += 1;
+  if (freeSlot_) {
+    ui32 index = freeSlot_;
+    freeSlot_ = slots_[index] & INDEX_MASK;
+    slots_[index] = (slots_[index] & ~(ui32)INDEX_MASK) | index;
+    return slots_[index];
+  }
+  if (!numSlots_) {
+    numSlots_ = 1;
+  }
+  if (numSlots_ == capacity_ || !slots_) {
+    capacity_ = (capacity_ ? capacity_ * 2 : 1024);
+    slots_ = (ui32*)_mem::realloc(slots_, capacity_ * sizeof(ui32));
+  }
+  assert(numSlots_ <= INDEX_MASK);
+  ui32 index = numSlots_++;
+  slots_[index] = index;
+  return index;
+}
+void HandlePool::collect(ui32* handles) const {
+  for (ui32 index = 1; index < numSlots_; ++index) {
+    if ((slots_[index] & INDEX_MASK) == index) {
+      *handles++ = slots_[index];
+    }
+  }
+}
+void HandlePool::free(ui32 handle) {
+  assert(valid(handle));
+  ui32 index = handle & INDEX_MASK;
+  ui32 generation = (handle >> INDEX_BITS) + 1;
+  slots_[index] = (generation << INDEX_BITS) | freeSlot_;
+  freeSlot_ = index;
+  size_ -= 1;
+}
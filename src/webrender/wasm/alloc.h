@@ -1,10 +1,13 @@
 #pragma once
+#include "common.h"
 
 class SizedPool {
 public:
   SizedPool(size_t blockSize, size_t pageSize = 65536);
   void* alloc();
   void free(void* ptr);
+  // Returns a chain of blocks linked through their first word, from first to last
+  void free(void* first, void* last);
   void clear();
 private:
   size_t blockSize_;
@@ -15,6 +18,38 @@ private:
   void* freeBlock_ = nullptr;
 };
 
+// Dense 32-bit handles: the slot index in the low 24 bits and a generation in the
+// high 8 bits that changes whenever the slot is freed, so a handle of a deleted object
+// never matches the slot's next owner. Slot 0 is never used; handle 0 means null.
+class HandlePool {
+public:
+  enum {
+    INDEX_BITS = 24,
+    INDEX_MASK = (1 << INDEX_BITS) - 1,
+  };
+
+  ui32 alloc();
+  void free(ui32 handle);
+  bool valid(ui32 handle) const {
+    ui32 index = handle & INDEX_MASK;
+    return index && index < numSlots_ && slots_[index] == handle;
+  }
+  size_t size() const {
+    return size_;
+  }
+  // Writes the live handles to handles, which must have room for size() entries
+  void collect(ui32* handles) const;
+
+private:
+  // The handle of live slots; free slots keep their generation and the index of the
+  // next free slot
+  ui32* slots_ = nullptr;
+  ui32 numSlots_ = 0;
+  ui32 capacity_ = 0;
+  ui32 freeSlot_ = 0;
+  size_t size_ = 0;
+};
+
 template<size_t blockSize>
 class SizedAllocator {
 public:
@@ -24,6 +59,9 @@ public:
   static void free(void* ptr) {
     pool_.free(ptr);
   }
+  static SizedPool& pool() {
+    return pool_;
+  }
 private:
   static SizedPool pool_;
 };
@@ -1,5 +1,7 @@
 #pragma once
 #include "webgl.h"
+#include "memoryTracker.h"
+#include "frameStats.h"
 
 namespace WebGL
 {
@@ -14,10 +16,15 @@ public:
     buffer->usage_ = usage;
     WebGL::bindBuffer(target, buffer);
     glBufferData(target, size, data, usage);
+    trackMemory(buffer->memoryCategory(), size, 0);
+    if (data) {
+      FRAME_STAT(bufferBytes, size);
+    }
     return buffer;
   }
   ~Buffer() {
     glDeleteBuffer(this);
+    trackMemory(memoryCategory(), 0, size_);
   }
 
   GLenum target() const {
@@ -29,10 +36,30 @@ public:
   GLenum usage() const {
     return usage_;
   }
+  MemoryCategory memoryCategory() const {
+    switch (target_) {
+    case GL_ARRAY_BUFFER:
+      return MEMORY_VERTEX;
+    case GL_ELEMENT_ARRAY_BUFFER:
+      return MEMORY_INDEX;
+    case GL_UNIFORM_BUFFER:
+      return MEMORY_UNIFORM;
+    default:
+      return MEMORY_OTHER;
+    }
+  }
 
   void setData(size_t offset, size_t size, const void* data) {
     WebGL::bindBuffer(target_, this);
     glBufferSubData(target_, offset, size, data);
+    FRAME_STAT(bufferBytes, size);
+  }
+
+  // Replaces the storage with a new, uninitialized one so the driver doesn't have to
+  // wait for pending draws that use the old contents
+  void orphan() {
+    WebGL::bindBuffer(target_, this);
+    glBufferData(target_, size_, nullptr, usage_);
   }
 
   void getData(size_t offset, size_t size, void* data) {
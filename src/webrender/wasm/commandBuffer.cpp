@@ -0,0 +1,28 @@
+#include "commandBuffer.h"
+
+namespace GLCommands
+{
+
+Stream stream_;
+
+void flush() {
+  if (stream_.size) {
+    if (capturing_) {
+      captureCommands_(stream_.data, stream_.size);
+    }
+    glExecuteCommands(stream_.data, stream_.size);
+    stream_.size = 0;
+    stream_.commands = 0;
+  }
+}
+
+void reserve_(size_t size) {
+  assert(size <= BUFFER_SIZE);
+  if (!stream_.data) {
+    stream_.data = (ui32*)sbrk(sizeof(ui32) * BUFFER_SIZE);
+  } else {
+    flush();
+  }
+}
+
+}
@@ -0,0 +1,1631 @@
+#pragma once
+#include "glbindings.h"
+
+// Command buffer mode: void GL calls are encoded into a buffer in linear memory and
+// executed by a single glExecuteCommands call on flush(). Calls that return values or
+// read client memory flush the pending commands first.
+// Each command is a header word (opcode | argument words << 8) followed by its arguments.
+
+namespace GLCommands
+{
+
+enum {
+  CMD_SCISSOR = 1,
+  CMD_VIEWPORT = 2,
+  CMD_ACTIVE_TEXTURE = 3,
+  CMD_BLEND_COLOR = 4,
+  CMD_BLEND_EQUATION = 5,
+  CMD_BLEND_EQUATION_SEPARATE = 6,
+  CMD_BLEND_FUNC = 7,
+  CMD_BLEND_FUNC_SEPARATE = 8,
+  CMD_CLEAR_COLOR = 9,
+  CMD_CLEAR_DEPTH = 10,
+  CMD_CLEAR_STENCIL = 11,
+  CMD_COLOR_MASK = 12,
+  CMD_CULL_FACE = 13,
+  CMD_DEPTH_FUNC = 14,
+  CMD_DEPTH_MASK = 15,
+  CMD_DEPTH_RANGE = 16,
+  CMD_DISABLE = 17,
+  CMD_ENABLE = 18,
+  CMD_FRONT_FACE = 19,
+  CMD_HINT = 20,
+  CMD_LINE_WIDTH = 21,
+  CMD_PIXEL_STOREI = 22,
+  CMD_POLYGON_OFFSET = 23,
+  CMD_SAMPLE_COVERAGE = 24,
+  CMD_STENCIL_FUNC = 25,
+  CMD_STENCIL_FUNC_SEPARATE = 26,
+  CMD_STENCIL_MASK = 27,
+  CMD_STENCIL_MASK_SEPARATE = 28,
+  CMD_STENCIL_OP = 29,
+  CMD_STENCIL_OP_SEPARATE = 30,
+  CMD_BIND_BUFFER = 31,
+  CMD_CREATE_BUFFER = 32,
+  CMD_DELETE_BUFFER = 33,
+  CMD_COPY_BUFFER_SUB_DATA = 34,
+  CMD_BIND_FRAMEBUFFER = 35,
+  CMD_CREATE_FRAMEBUFFER = 36,
+  CMD_DELETE_FRAMEBUFFER = 37,
+  CMD_FRAMEBUFFER_RENDERBUFFER = 38,
+  CMD_FRAMEBUFFER_TEXTURE2_D = 39,
+  CMD_READ_PIXELS_BUFFER = 40,
+  CMD_BLIT_FRAMEBUFFER = 41,
+  CMD_FRAMEBUFFER_TEXTURE_LAYER = 42,
+  CMD_INVALIDATE_FRAMEBUFFER = 43,
+  CMD_INVALIDATE_SUB_FRAMEBUFFER = 44,
+  CMD_READ_BUFFER = 45,
+  CMD_BIND_RENDERBUFFER = 46,
+  CMD_CREATE_RENDERBUFFER = 47,
+  CMD_DELETE_RENDERBUFFER = 48,
+  CMD_RENDERBUFFER_STORAGE = 49,
+  CMD_RENDERBUFFER_STORAGE_MULTISAMPLE = 50,
+  CMD_BIND_TEXTURE = 51,
+  CMD_COPY_TEX_SUB_IMAGE2_D = 52,
+  CMD_CREATE_TEXTURE = 53,
+  CMD_DELETE_TEXTURE = 54,
+  CMD_GENERATE_MIPMAP = 55,
+  CMD_TEX_SUB_IMAGE2_D_BUFFER = 56,
+  CMD_TEX_PARAMETERI = 57,
+  CMD_TEX_PARAMETERF = 58,
+  CMD_TEX_STORAGE2_D = 59,
+  CMD_TEX_STORAGE3_D = 60,
+  CMD_TEX_SUB_IMAGE3_D_BUFFER = 61,
+  CMD_ATTACH_SHADER = 62,
+  CMD_COMPILE_SHADER = 63,
+  CMD_CREATE_PROGRAM = 64,
+  CMD_CREATE_SHADER = 65,
+  CMD_DELETE_PROGRAM = 66,
+  CMD_DELETE_SHADER = 67,
+  CMD_DETACH_SHADER = 68,
+  CMD_LINK_PROGRAM = 69,
+  CMD_USE_PROGRAM = 70,
+  CMD_VALIDATE_PROGRAM = 71,
+  CMD_DISABLE_VERTEX_ATTRIB_ARRAY = 72,
+  CMD_ENABLE_VERTEX_ATTRIB_ARRAY = 73,
+  CMD_UNIFORM1F = 74,
+  CMD_UNIFORM2F = 75,
+  CMD_UNIFORM3F = 76,
+  CMD_UNIFORM4F = 77,
+  CMD_UNIFORM1I = 78,
+  CMD_UNIFORM2I = 79,
+  CMD_UNIFORM3I = 80,
+  CMD_UNIFORM4I = 81,
+  CMD_UNIFORM1UI = 82,
+  CMD_UNIFORM2UI = 83,
+  CMD_UNIFORM3UI = 84,
+  CMD_UNIFORM4UI = 85,
+  CMD_UNIFORM1FV = 86,
+  CMD_UNIFORM2FV = 87,
+  CMD_UNIFORM3FV = 88,
+  CMD_UNIFORM4FV = 89,
+  CMD_UNIFORM1IV = 90,
+  CMD_UNIFORM2IV = 91,
+  CMD_UNIFORM3IV = 92,
+  CMD_UNIFORM4IV = 93,
+  CMD_UNIFORM1UIV = 94,
+  CMD_UNIFORM2UIV = 95,
+  CMD_UNIFORM3UIV = 96,
+  CMD_UNIFORM4UIV = 97,
+  CMD_UNIFORM_MATRIX2FV = 98,
+  CMD_UNIFORM_MATRIX3FV = 99,
+  CMD_UNIFORM_MATRIX4FV = 100,
+  CMD_UNIFORM_MATRIX2X3FV = 101,
+  CMD_UNIFORM_MATRIX3X2FV = 102,
+  CMD_UNIFORM_MATRIX2X4FV = 103,
+  CMD_UNIFORM_MATRIX4X2FV = 104,
+  CMD_UNIFORM_MATRIX3X4FV = 105,
+  CMD_UNIFORM_MATRIX4X3FV = 106,
+  CMD_VERTEX_ATTRIB1F = 107,
+  CMD_VERTEX_ATTRIB2F = 108,
+  CMD_VERTEX_ATTRIB3F = 109,
+  CMD_VERTEX_ATTRIB4F = 110,
+  CMD_VERTEX_ATTRIB_POINTER = 111,
+  CMD_VERTEX_ATTRIB_I4I = 112,
+  CMD_VERTEX_ATTRIB_I4UI = 113,
+  CMD_VERTEX_ATTRIB_I_POINTER = 114,
+  CMD_CLEAR = 115,
+  CMD_DRAW_ARRAYS = 116,
+  CMD_DRAW_ELEMENTS = 117,
+  CMD_FLUSH = 118,
+  CMD_VERTEX_ATTRIB_DIVISOR = 119,
+  CMD_DRAW_ARRAYS_INSTANCED = 120,
+  CMD_DRAW_ELEMENTS_INSTANCED = 121,
+  CMD_DRAW_RANGE_ELEMENTS = 122,
+  CMD_DRAW_BUFFERS = 123,
+  CMD_CLEAR_BUFFERIV = 124,
+  CMD_CLEAR_BUFFERUIV = 125,
+  CMD_CLEAR_BUFFERFV = 126,
+  CMD_CLEAR_BUFFERFI = 127,
+  CMD_CREATE_QUERY = 128,
+  CMD_DELETE_QUERY = 129,
+  CMD_BEGIN_QUERY = 130,
+  CMD_END_QUERY = 131,
+  CMD_CREATE_SAMPLER = 132,
+  CMD_DELETE_SAMPLER = 133,
+  CMD_BIND_SAMPLER = 134,
+  CMD_SAMPLER_PARAMETERI = 135,
+  CMD_SAMPLER_PARAMETERF = 136,
+  CMD_FENCE_SYNC = 137,
+  CMD_DELETE_SYNC = 138,
+  CMD_BIND_BUFFER_BASE = 139,
+  CMD_BIND_BUFFER_RANGE = 140,
+  CMD_UNIFORM_BLOCK_BINDING = 141,
+  CMD_CREATE_VERTEX_ARRAY = 142,
+  CMD_DELETE_VERTEX_ARRAY = 143,
+  CMD_BIND_VERTEX_ARRAY = 144,
+  CMD_QUERY_COUNTER = 145,
+  CMD_MULTI_DRAW_ARRAYS = 146,
+  CMD_MULTI_DRAW_ELEMENTS = 147,
+  CMD_MULTI_DRAW_ELEMENTS_INSTANCED = 148,
+  NUM_COMMANDS,
+};
+
+enum {
+  BUFFER_SIZE = 65536,
+  // Larger multi-draws are split into several commands
+  MAX_MULTI_DRAW = 4096,
+};
+
+struct Stream {
+  ui32* data;
+  size_t size;
+  size_t commands;
+};
+extern Stream stream_;
+
+void flush();
+void reserve_(size_t size);
+
+inline ui32* begin(ui32 opcode, size_t size) {
+  if (stream_.size + size + 1 > BUFFER_SIZE || !stream_.data) {
+    reserve_(size + 1);
+  }
+  ui32* cmd = stream_.data + stream_.size;
+  cmd[0] = opcode | (size << 8);
+  stream_.size += size + 1;
+  stream_.commands += 1;
+  return cmd + 1;
+}
+
+inline ui32 bits(float value) {
+  union {
+    float f;
+    ui32 u;
+  } cast;
+  cast.f = value;
+  return cast.u;
+}
+inline ui32 handle(GLptr object) {
+  return object.handle;
+}
+
+template<class R, class... P, class... A>
+inline R sync(R (*func)(P...), A... args) {
+  flush();
+  return func(args...);
+}
+
+// Frame capture (frameCapture.cpp). Sync calls that change GL state are passed to a
+// capture function with the same arguments (and the result, if any) while capturing.
+extern bool capturing_;
+void captureCommands_(const ui32* commands, size_t size);
+void captureEndFrame_(ui32 frame);
+void captureBufferData_(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage);
+void captureBufferSubData_(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data);
+void captureCompressedTexImage2D_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                  GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data);
+void captureTexImage2D_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                        GLint border, GLenum format, GLenum type, const GLvoid* data);
+void captureTexSubImage2D_(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                           GLsizei height, GLenum format, GLenum type, const GLvoid* data);
+void captureTexSubImage3D_(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                           GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type,
+                           const GLvoid* data);
+void captureShaderSource_(GLptr shader, const GLchar* source);
+void captureGetUniformLocation_(GLint result, GLptr program, const GLchar* name);
+void captureGetExtension_(GLboolean result, const char* name);
+void captureVertexAttrib4fv_(GLuint index, const GLfloat* value);
+void captureVertexAttrib1fv_(GLuint index, const GLfloat* value);
+void captureVertexAttrib2fv_(GLuint index, const GLfloat* value);
+void captureVertexAttrib3fv_(GLuint index, const GLfloat* value);
+void captureVertexAttribI4iv_(GLuint index, const GLint* values);
+void captureVertexAttribI4uiv_(GLuint index, const GLuint* values);
+void captureBindAttribLocation_(GLptr program, GLuint index, const GLchar* name);
+void captureCopyTexImage2D_(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y,
+                            GLsizei width, GLsizei height, GLint border);
+void captureCompressedTexSubImage2D_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                     GLsizei width, GLsizei height, GLenum format, GLsizei imageSize,
+                                     const GLvoid* data);
+void captureTexImage3D_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                        GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid* data);
+void captureCompressedTexImage3D_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                  GLsizei height, GLsizei depth, GLint border, GLsizei imageSize,
+                                  const GLvoid* data);
+void captureCompressedTexSubImage3D_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                     GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                                     GLenum format, GLsizei imageSize, const GLvoid* data);
+void captureCompressedTexImage2DBuffer_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                        GLsizei height, GLint border, GLsizei imageSize, GLintptr offset);
+void captureCompressedTexSubImage2DBuffer_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                           GLsizei width, GLsizei height, GLenum format, GLsizei imageSize,
+                                           GLintptr offset);
+void captureTexImage2DBuffer_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                              GLint border, GLenum format, GLenum type, GLintptr offset);
+void captureTexImage3DBuffer_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                              GLsizei depth, GLint border, GLenum format, GLenum type, GLintptr offset);
+void captureCompressedTexImage3DBuffer_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                        GLsizei height, GLsizei depth, GLint border, GLsizei imageSize,
+                                        GLintptr offset);
+void captureCompressedTexSubImage3DBuffer_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                           GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                                           GLenum format, GLsizei imageSize, GLintptr offset);
+void captureCreateTransformFeedback_(GLptr transformFeedback);
+void captureDeleteTransformFeedback_(GLptr transformFeedback);
+void captureBindTransformFeedback_(GLenum target, GLptr transformFeedback);
+void captureBeginTransformFeedback_(GLenum primitiveMode);
+void captureEndTransformFeedback_();
+void capturePauseTransformFeedback_();
+void captureResumeTransformFeedback_();
+void captureTransformFeedbackVaryings_(GLptr program, GLsizei count, const char** varyings, GLenum bufferMode);
+
+template<class... P, class... A>
+inline void record(void (*func)(P...), void (*capture)(P...), A... args) {
+  flush();
+  if (capturing_) {
+    capture(args...);
+  }
+  func(args...);
+}
+template<class R, class... P, class... A>
+inline R record(R (*func)(P...), void (*capture)(R, P...), A... args) {
+  flush();
+  R result = func(args...);
+  if (capturing_) {
+    capture(result, args...);
+  }
+  return result;
+}
+
+inline void glScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  ui32* cmd = begin(CMD_SCISSOR, 4);
+  cmd[0] = x;
+  cmd[1] = y;
+  cmd[2] = width;
+  cmd[3] = height;
+}
+
+inline void glViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  ui32* cmd = begin(CMD_VIEWPORT, 4);
+  cmd[0] = x;
+  cmd[1] = y;
+  cmd[2] = width;
+  cmd[3] = height;
+}
+
+inline void glActiveTexture(GLenum texture) {
+  ui32* cmd = begin(CMD_ACTIVE_TEXTURE, 1);
+  cmd[0] = texture;
+}
+
+inline void glBlendColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha) {
+  ui32* cmd = begin(CMD_BLEND_COLOR, 4);
+  cmd[0] = bits(red);
+  cmd[1] = bits(green);
+  cmd[2] = bits(blue);
+  cmd[3] = bits(alpha);
+}
+
+inline void glBlendEquation(GLenum mode) {
+  ui32* cmd = begin(CMD_BLEND_EQUATION, 1);
+  cmd[0] = mode;
+}
+
+inline void glBlendEquationSeparate(GLenum modeRGB, GLenum modeAlpha) {
+  ui32* cmd = begin(CMD_BLEND_EQUATION_SEPARATE, 2);
+  cmd[0] = modeRGB;
+  cmd[1] = modeAlpha;
+}
+
+inline void glBlendFunc(GLenum sfactor, GLenum dfactor) {
+  ui32* cmd = begin(CMD_BLEND_FUNC, 2);
+  cmd[0] = sfactor;
+  cmd[1] = dfactor;
+}
+
+inline void glBlendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+  ui32* cmd = begin(CMD_BLEND_FUNC_SEPARATE, 4);
+  cmd[0] = srcRGB;
+  cmd[1] = dstRGB;
+  cmd[2] = srcAlpha;
+  cmd[3] = dstAlpha;
+}
+
+inline void glClearColor(GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha) {
+  ui32* cmd = begin(CMD_CLEAR_COLOR, 4);
+  cmd[0] = bits(red);
+  cmd[1] = bits(green);
+  cmd[2] = bits(blue);
+  cmd[3] = bits(alpha);
+}
+
+inline void glClearDepth(GLclampf depth) {
+  ui32* cmd = begin(CMD_CLEAR_DEPTH, 1);
+  cmd[0] = bits(depth);
+}
+
+inline void glClearStencil(GLint s) {
+  ui32* cmd = begin(CMD_CLEAR_STENCIL, 1);
+  cmd[0] = s;
+}
+
+inline void glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha) {
+  ui32* cmd = begin(CMD_COLOR_MASK, 4);
+  cmd[0] = red ? 1 : 0;
+  cmd[1] = green ? 1 : 0;
+  cmd[2] = blue ? 1 : 0;
+  cmd[3] = alpha ? 1 : 0;
+}
+
+inline void glCullFace(GLenum mode) {
+  ui32* cmd = begin(CMD_CULL_FACE, 1);
+  cmd[0] = mode;
+}
+
+inline void glDepthFunc(GLenum func) {
+  ui32* cmd = begin(CMD_DEPTH_FUNC, 1);
+  cmd[0] = func;
+}
+
+inline void glDepthMask(GLboolean flag) {
+  ui32* cmd = begin(CMD_DEPTH_MASK, 1);
+  cmd[0] = flag ? 1 : 0;
+}
+
+inline void glDepthRange(GLclampf zNear, GLclampf zFar) {
+  ui32* cmd = begin(CMD_DEPTH_RANGE, 2);
+  cmd[0] = bits(zNear);
+  cmd[1] = bits(zFar);
+}
+
+inline void glDisable(GLenum cap) {
+  ui32* cmd = begin(CMD_DISABLE, 1);
+  cmd[0] = cap;
+}
+
+inline void glEnable(GLenum cap) {
+  ui32* cmd = begin(CMD_ENABLE, 1);
+  cmd[0] = cap;
+}
+
+inline void glFrontFace(GLenum mode) {
+  ui32* cmd = begin(CMD_FRONT_FACE, 1);
+  cmd[0] = mode;
+}
+
+inline void glHint(GLenum target, GLenum mode) {
+  ui32* cmd = begin(CMD_HINT, 2);
+  cmd[0] = target;
+  cmd[1] = mode;
+}
+
+inline void glLineWidth(GLfloat width) {
+  ui32* cmd = begin(CMD_LINE_WIDTH, 1);
+  cmd[0] = bits(width);
+}
+
+inline void glPixelStorei(GLenum pname, GLint param) {
+  ui32* cmd = begin(CMD_PIXEL_STOREI, 2);
+  cmd[0] = pname;
+  cmd[1] = param;
+}
+
+inline void glPolygonOffset(GLfloat factor, GLfloat units) {
+  ui32* cmd = begin(CMD_POLYGON_OFFSET, 2);
+  cmd[0] = bits(factor);
+  cmd[1] = bits(units);
+}
+
+inline void glSampleCoverage(GLclampf value, GLboolean invert) {
+  ui32* cmd = begin(CMD_SAMPLE_COVERAGE, 2);
+  cmd[0] = bits(value);
+  cmd[1] = invert ? 1 : 0;
+}
+
+inline void glStencilFunc(GLenum func, GLint ref, GLuint mask) {
+  ui32* cmd = begin(CMD_STENCIL_FUNC, 3);
+  cmd[0] = func;
+  cmd[1] = ref;
+  cmd[2] = mask;
+}
+
+inline void glStencilFuncSeparate(GLenum face, GLenum func, GLint ref, GLuint mask) {
+  ui32* cmd = begin(CMD_STENCIL_FUNC_SEPARATE, 4);
+  cmd[0] = face;
+  cmd[1] = func;
+  cmd[2] = ref;
+  cmd[3] = mask;
+}
+
+inline void glStencilMask(GLuint mask) {
+  ui32* cmd = begin(CMD_STENCIL_MASK, 1);
+  cmd[0] = mask;
+}
+
+inline void glStencilMaskSeparate(GLenum face, GLuint mask) {
+  ui32* cmd = begin(CMD_STENCIL_MASK_SEPARATE, 2);
+  cmd[0] = face;
+  cmd[1] = mask;
+}
+
+inline void glStencilOp(GLenum fail, GLenum zfail, GLenum zpass) {
+  ui32* cmd = begin(CMD_STENCIL_OP, 3);
+  cmd[0] = fail;
+  cmd[1] = zfail;
+  cmd[2] = zpass;
+}
+
+inline void glStencilOpSeparate(GLenum face, GLenum fail, GLenum zfail, GLenum zpass) {
+  ui32* cmd = begin(CMD_STENCIL_OP_SEPARATE, 4);
+  cmd[0] = face;
+  cmd[1] = fail;
+  cmd[2] = zfail;
+  cmd[3] = zpass;
+}
+
+inline void glBindBuffer(GLenum target, GLptr buffer) {
+  ui32* cmd = begin(CMD_BIND_BUFFER, 2);
+  cmd[0] = target;
+  cmd[1] = handle(buffer);
+}
+
+inline void glCreateBuffer(GLptr buffer) {
+  ui32* cmd = begin(CMD_CREATE_BUFFER, 1);
+  cmd[0] = handle(buffer);
+}
+
+inline void glDeleteBuffer(GLptr buffer) {
+  ui32* cmd = begin(CMD_DELETE_BUFFER, 1);
+  cmd[0] = handle(buffer);
+}
+
+inline void glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, GLintptr readOffset, GLintptr writeOffset, GLsizeiptr size) {
+  ui32* cmd = begin(CMD_COPY_BUFFER_SUB_DATA, 5);
+  cmd[0] = readTarget;
+  cmd[1] = writeTarget;
+  cmd[2] = readOffset;
+  cmd[3] = writeOffset;
+  cmd[4] = size;
+}
+
+inline void glBindFramebuffer(GLenum target, GLptr framebuffer) {
+  ui32* cmd = begin(CMD_BIND_FRAMEBUFFER, 2);
+  cmd[0] = target;
+  cmd[1] = handle(framebuffer);
+}
+
+inline void glCreateFramebuffer(GLptr framebuffer) {
+  ui32* cmd = begin(CMD_CREATE_FRAMEBUFFER, 1);
+  cmd[0] = handle(framebuffer);
+}
+
+inline void glDeleteFramebuffer(GLptr framebuffer) {
+  ui32* cmd = begin(CMD_DELETE_FRAMEBUFFER, 1);
+  cmd[0] = handle(framebuffer);
+}
+
+inline void glFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLptr renderbuffer) {
+  ui32* cmd = begin(CMD_FRAMEBUFFER_RENDERBUFFER, 4);
+  cmd[0] = target;
+  cmd[1] = attachment;
+  cmd[2] = renderbuffertarget;
+  cmd[3] = handle(renderbuffer);
+}
+
+inline void glFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLptr texture, GLint level) {
+  ui32* cmd = begin(CMD_FRAMEBUFFER_TEXTURE2_D, 5);
+  cmd[0] = target;
+  cmd[1] = attachment;
+  cmd[2] = textarget;
+  cmd[3] = handle(texture);
+  cmd[4] = level;
+}
+
+inline void glReadPixelsBuffer(GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLintptr offset) {
+  ui32* cmd = begin(CMD_READ_PIXELS_BUFFER, 7);
+  cmd[0] = x;
+  cmd[1] = y;
+  cmd[2] = width;
+  cmd[3] = height;
+  cmd[4] = format;
+  cmd[5] = type;
+  cmd[6] = offset;
+}
+
+inline void glBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0, GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter) {
+  ui32* cmd = begin(CMD_BLIT_FRAMEBUFFER, 10);
+  cmd[0] = srcX0;
+  cmd[1] = srcY0;
+  cmd[2] = srcX1;
+  cmd[3] = srcY1;
+  cmd[4] = dstX0;
+  cmd[5] = dstY0;
+  cmd[6] = dstX1;
+  cmd[7] = dstY1;
+  cmd[8] = mask;
+  cmd[9] = filter;
+}
+
+inline void glFramebufferTextureLayer(GLenum target, GLenum attachment, GLptr texture, GLint level, GLint layer) {
+  ui32* cmd = begin(CMD_FRAMEBUFFER_TEXTURE_LAYER, 5);
+  cmd[0] = target;
+  cmd[1] = attachment;
+  cmd[2] = handle(texture);
+  cmd[3] = level;
+  cmd[4] = layer;
+}
+
+inline void glInvalidateFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments) {
+  size_t size = numAttachments;
+  ui32* cmd = begin(CMD_INVALIDATE_FRAMEBUFFER, 2 + size);
+  cmd[0] = target;
+  cmd[1] = numAttachments;
+  memcpy(cmd + 2, attachments, size * sizeof(ui32));
+}
+
+inline void glInvalidateSubFramebuffer(GLenum target, GLsizei numAttachments, const GLenum* attachments, GLint x, GLint y, GLsizei width, GLsizei height) {
+  size_t size = numAttachments;
+  ui32* cmd = begin(CMD_INVALIDATE_SUB_FRAMEBUFFER, 6 + size);
+  cmd[0] = target;
+  cmd[1] = numAttachments;
+  cmd[2] = x;
+  cmd[3] = y;
+  cmd[4] = width;
+  cmd[5] = height;
+  memcpy(cmd + 6, attachments, size * sizeof(ui32));
+}
+
+inline void glReadBuffer(GLenum src) {
+  ui32* cmd = begin(CMD_READ_BUFFER, 1);
+  cmd[0] = src;
+}
+
+inline void glBindRenderbuffer(GLenum target, GLptr renderbuffer) {
+  ui32* cmd = begin(CMD_BIND_RENDERBUFFER, 2);
+  cmd[0] = target;
+  cmd[1] = handle(renderbuffer);
+}
+
+inline void glCreateRenderbuffer(GLptr renderbuffer) {
+  ui32* cmd = begin(CMD_CREATE_RENDERBUFFER, 1);
+  cmd[0] = handle(renderbuffer);
+}
+
+inline void glDeleteRenderbuffer(GLptr renderbuffer) {
+  ui32* cmd = begin(CMD_DELETE_RENDERBUFFER, 1);
+  cmd[0] = handle(renderbuffer);
+}
+
+inline void glRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height) {
+  ui32* cmd = begin(CMD_RENDERBUFFER_STORAGE, 4);
+  cmd[0] = target;
+  cmd[1] = internalformat;
+  cmd[2] = width;
+  cmd[3] = height;
+}
+
+inline void glRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height) {
+  ui32* cmd = begin(CMD_RENDERBUFFER_STORAGE_MULTISAMPLE, 5);
+  cmd[0] = target;
+  cmd[1] = samples;
+  cmd[2] = internalformat;
+  cmd[3] = width;
+  cmd[4] = height;
+}
+
+inline void glBindTexture(GLenum target, GLptr texture) {
+  ui32* cmd = begin(CMD_BIND_TEXTURE, 2);
+  cmd[0] = target;
+  cmd[1] = handle(texture);
+}
+
+inline void glCopyTexSubImage2D(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint x, GLint y, GLsizei width, GLsizei height) {
+  ui32* cmd = begin(CMD_COPY_TEX_SUB_IMAGE2_D, 8);
+  cmd[0] = target;
+  cmd[1] = level;
+  cmd[2] = xoffset;
+  cmd[3] = yoffset;
+  cmd[4] = x;
+  cmd[5] = y;
+  cmd[6] = width;
+  cmd[7] = height;
+}
+
+inline void glCreateTexture(GLptr texture) {
+  ui32* cmd = begin(CMD_CREATE_TEXTURE, 1);
+  cmd[0] = handle(texture);
+}
+
+inline void glDeleteTexture(GLptr texture) {
+  ui32* cmd = begin(CMD_DELETE_TEXTURE, 1);
+  cmd[0] = handle(texture);
+}
+
+inline void glGenerateMipmap(GLenum target) {
+  ui32* cmd = begin(CMD_GENERATE_MIPMAP, 1);
+  cmd[0] = target;
+}
+
+inline void glTexSubImage2DBuffer(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, GLintptr offset) {
+  ui32* cmd = begin(CMD_TEX_SUB_IMAGE2_D_BUFFER, 9);
+  cmd[0] = target;
+  cmd[1] = level;
+  cmd[2] = xoffset;
+  cmd[3] = yoffset;
+  cmd[4] = width;
+  cmd[5] = height;
+  cmd[6] = format;
+  cmd[7] = type;
+  cmd[8] = offset;
+}
+
+inline void glTexParameteri(GLenum target, GLenum pname, GLint param) {
+  ui32* cmd = begin(CMD_TEX_PARAMETERI, 3);
+  cmd[0] = target;
+  cmd[1] = pname;
+  cmd[2] = param;
+}
+
+inline void glTexParameterf(GLenum target, GLenum pname, GLfloat param) {
+  ui32* cmd = begin(CMD_TEX_PARAMETERF, 3);
+  cmd[0] = target;
+  cmd[1] = pname;
+  cmd[2] = bits(param);
+}
+
+inline void glTexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height) {
+  ui32* cmd = begin(CMD_TEX_STORAGE2_D, 5);
+  cmd[0] = target;
+  cmd[1] = levels;
+  cmd[2] = internalformat;
+  cmd[3] = width;
+  cmd[4] = height;
+}
+
+inline void glTexStorage3D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height, GLsizei depth) {
+  ui32* cmd = begin(CMD_TEX_STORAGE3_D, 6);
+  cmd[0] = target;
+  cmd[1] = levels;
+  cmd[2] = internalformat;
+  cmd[3] = width;
+  cmd[4] = height;
+  cmd[5] = depth;
+}
+
+inline void glTexSubImage3DBuffer(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, GLintptr offset) {
+  ui32* cmd = begin(CMD_TEX_SUB_IMAGE3_D_BUFFER, 11);
+  cmd[0] = target;
+  cmd[1] = level;
+  cmd[2] = xoffset;
+  cmd[3] = yoffset;
+  cmd[4] = zoffset;
+  cmd[5] = width;
+  cmd[6] = height;
+  cmd[7] = depth;
+  cmd[8] = format;
+  cmd[9] = type;
+  cmd[10] = offset;
+}
+
+inline void glAttachShader(GLptr program, GLptr shader) {
+  ui32* cmd = begin(CMD_ATTACH_SHADER, 2);
+  cmd[0] = handle(program);
+  cmd[1] = handle(shader);
+}
+
+inline void glCompileShader(GLptr shader) {
+  ui32* cmd = begin(CMD_COMPILE_SHADER, 1);
+  cmd[0] = handle(shader);
+}
+
+inline void glCreateProgram(GLptr program) {
+  ui32* cmd = begin(CMD_CREATE_PROGRAM, 1);
+  cmd[0] = handle(program);
+}
+
+inline void glCreateShader(GLptr shader, GLenum type) {
+  ui32* cmd = begin(CMD_CREATE_SHADER, 2);
+  cmd[0] = handle(shader);
+  cmd[1] = type;
+}
+
+inline void glDeleteProgram(GLptr program) {
+  ui32* cmd = begin(CMD_DELETE_PROGRAM, 1);
+  cmd[0] = handle(program);
+}
+
+inline void glDeleteShader(GLptr shader) {
+  ui32* cmd = begin(CMD_DELETE_SHADER, 1);
+  cmd[0] = handle(shader);
+}
+
+inline void glDetachShader(GLptr program, GLptr shader) {
+  ui32* cmd = begin(CMD_DETACH_SHADER, 2);
+  cmd[0] = handle(program);
+  cmd[1] = handle(shader);
+}
+
+inline void glLinkProgram(GLptr program) {
+  ui32* cmd = begin(CMD_LINK_PROGRAM, 1);
+  cmd[0] = handle(program);
+}
+
+inline void glUseProgram(GLptr program) {
+  ui32* cmd = begin(CMD_USE_PROGRAM, 1);
+  cmd[0] = handle(program);
+}
+
+inline void glValidateProgram(GLptr program) {
+  ui32* cmd = begin(CMD_VALIDATE_PROGRAM, 1);
+  cmd[0] = handle(program);
+}
+
+inline void glDisableVertexAttribArray(GLuint index) {
+  ui32* cmd = begin(CMD_DISABLE_VERTEX_ATTRIB_ARRAY, 1);
+  cmd[0] = index;
+}
+
+inline void glEnableVertexAttribArray(GLuint index) {
+  ui32* cmd = begin(CMD_ENABLE_VERTEX_ATTRIB_ARRAY, 1);
+  cmd[0] = index;
+}
+
+inline void glUniform1f(GLint location, GLfloat v0) {
+  ui32* cmd = begin(CMD_UNIFORM1F, 2);
+  cmd[0] = location;
+  cmd[1] = bits(v0);
+}
+
+inline void glUniform2f(GLint location, GLfloat v0, GLfloat v1) {
+  ui32* cmd = begin(CMD_UNIFORM2F, 3);
+  cmd[0] = location;
+  cmd[1] = bits(v0);
+  cmd[2] = bits(v1);
+}
+
+inline void glUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2) {
+  ui32* cmd = begin(CMD_UNIFORM3F, 4);
+  cmd[0] = location;
+  cmd[1] = bits(v0);
+  cmd[2] = bits(v1);
+  cmd[3] = bits(v2);
+}
+
+inline void glUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3) {
+  ui32* cmd = begin(CMD_UNIFORM4F, 5);
+  cmd[0] = location;
+  cmd[1] = bits(v0);
+  cmd[2] = bits(v1);
+  cmd[3] = bits(v2);
+  cmd[4] = bits(v3);
+}
+
+inline void glUniform1i(GLint location, GLint v0) {
+  ui32* cmd = begin(CMD_UNIFORM1I, 2);
+  cmd[0] = location;
+  cmd[1] = v0;
+}
+
+inline void glUniform2i(GLint location, GLint v0, GLint v1) {
+  ui32* cmd = begin(CMD_UNIFORM2I, 3);
+  cmd[0] = location;
+  cmd[1] = v0;
+  cmd[2] = v1;
+}
+
+inline void glUniform3i(GLint location, GLint v0, GLint v1, GLint v2) {
+  ui32* cmd = begin(CMD_UNIFORM3I, 4);
+  cmd[0] = location;
+  cmd[1] = v0;
+  cmd[2] = v1;
+  cmd[3] = v2;
+}
+
+inline void glUniform4i(GLint location, GLint v0, GLint v1, GLint v2, GLint v3) {
+  ui32* cmd = begin(CMD_UNIFORM4I, 5);
+  cmd[0] = location;
+  cmd[1] = v0;
+  cmd[2] = v1;
+  cmd[3] = v2;
+  cmd[4] = v3;
+}
+
+inline void glUniform1ui(GLint location, GLuint v0) {
+  ui32* cmd = begin(CMD_UNIFORM1UI, 2);
+  cmd[0] = location;
+  cmd[1] = v0;
+}
+
+inline void glUniform2ui(GLint location, GLuint v0, GLuint v1) {
+  ui32* cmd = begin(CMD_UNIFORM2UI, 3);
+  cmd[0] = location;
+  cmd[1] = v0;
+  cmd[2] = v1;
+}
+
+inline void glUniform3ui(GLint location, GLuint v0, GLuint v1, GLuint v2) {
+  ui32* cmd = begin(CMD_UNIFORM3UI, 4);
+  cmd[0] = location;
+  cmd[1] = v0;
+  cmd[2] = v1;
+  cmd[3] = v2;
+}
+
+inline void glUniform4ui(GLint location, GLuint v0, GLuint v1, GLuint v2, GLuint v3) {
+  ui32* cmd = begin(CMD_UNIFORM4UI, 5);
+  cmd[0] = location;
+  cmd[1] = v0;
+  cmd[2] = v1;
+  cmd[3] = v2;
+  cmd[4] = v3;
+}
+
+inline void glUniform1fv(GLint location, GLsizei count, const GLfloat* value) {
+  size_t size = count * 1;
+  ui32* cmd = begin(CMD_UNIFORM1FV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform2fv(GLint location, GLsizei count, const GLfloat* value) {
+  size_t size = count * 2;
+  ui32* cmd = begin(CMD_UNIFORM2FV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform3fv(GLint location, GLsizei count, const GLfloat* value) {
+  size_t size = count * 3;
+  ui32* cmd = begin(CMD_UNIFORM3FV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform4fv(GLint location, GLsizei count, const GLfloat* value) {
+  size_t size = count * 4;
+  ui32* cmd = begin(CMD_UNIFORM4FV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform1iv(GLint location, GLsizei count, const GLint* value) {
+  size_t size = count * 1;
+  ui32* cmd = begin(CMD_UNIFORM1IV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform2iv(GLint location, GLsizei count, const GLint* value) {
+  size_t size = count * 2;
+  ui32* cmd = begin(CMD_UNIFORM2IV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform3iv(GLint location, GLsizei count, const GLint* value) {
+  size_t size = count * 3;
+  ui32* cmd = begin(CMD_UNIFORM3IV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform4iv(GLint location, GLsizei count, const GLint* value) {
+  size_t size = count * 4;
+  ui32* cmd = begin(CMD_UNIFORM4IV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform1uiv(GLint location, GLsizei count, const GLuint* value) {
+  size_t size = count * 1;
+  ui32* cmd = begin(CMD_UNIFORM1UIV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform2uiv(GLint location, GLsizei count, const GLuint* value) {
+  size_t size = count * 2;
+  ui32* cmd = begin(CMD_UNIFORM2UIV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform3uiv(GLint location, GLsizei count, const GLuint* value) {
+  size_t size = count * 3;
+  ui32* cmd = begin(CMD_UNIFORM3UIV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniform4uiv(GLint location, GLsizei count, const GLuint* value) {
+  size_t size = count * 4;
+  ui32* cmd = begin(CMD_UNIFORM4UIV, 2 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 4;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX2FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 9;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX3FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 16;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX4FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix2x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 6;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX2X3FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix3x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 6;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX3X2FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix2x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 8;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX2X4FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix4x2fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 8;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX4X2FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix3x4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 12;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX3X4FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glUniformMatrix4x3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value) {
+  size_t size = count * 12;
+  ui32* cmd = begin(CMD_UNIFORM_MATRIX4X3FV, 3 + size);
+  cmd[0] = location;
+  cmd[1] = count;
+  cmd[2] = transpose ? 1 : 0;
+  memcpy(cmd + 3, value, size * sizeof(ui32));
+}
+
+inline void glVertexAttrib1f(GLuint index, GLfloat x) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB1F, 2);
+  cmd[0] = index;
+  cmd[1] = bits(x);
+}
+
+inline void glVertexAttrib2f(GLuint index, GLfloat x, GLfloat y) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB2F, 3);
+  cmd[0] = index;
+  cmd[1] = bits(x);
+  cmd[2] = bits(y);
+}
+
+inline void glVertexAttrib3f(GLuint index, GLfloat x, GLfloat y, GLfloat z) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB3F, 4);
+  cmd[0] = index;
+  cmd[1] = bits(x);
+  cmd[2] = bits(y);
+  cmd[3] = bits(z);
+}
+
+inline void glVertexAttrib4f(GLuint index, GLfloat x, GLfloat y, GLfloat z, GLfloat w) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB4F, 5);
+  cmd[0] = index;
+  cmd[1] = bits(x);
+  cmd[2] = bits(y);
+  cmd[3] = bits(z);
+  cmd[4] = bits(w);
+}
+
+inline void glVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, GLintptr offset) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB_POINTER, 6);
+  cmd[0] = index;
+  cmd[1] = size;
+  cmd[2] = type;
+  cmd[3] = normalized ? 1 : 0;
+  cmd[4] = stride;
+  cmd[5] = offset;
+}
+
+inline void glVertexAttribI4i(GLuint index, GLint x, GLint y, GLint z, GLint w) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB_I4I, 5);
+  cmd[0] = index;
+  cmd[1] = x;
+  cmd[2] = y;
+  cmd[3] = z;
+  cmd[4] = w;
+}
+
+inline void glVertexAttribI4ui(GLuint index, GLuint x, GLuint y, GLuint z, GLuint w) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB_I4UI, 5);
+  cmd[0] = index;
+  cmd[1] = x;
+  cmd[2] = y;
+  cmd[3] = z;
+  cmd[4] = w;
+}
+
+inline void glVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, GLintptr offset) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB_I_POINTER, 5);
+  cmd[0] = index;
+  cmd[1] = size;
+  cmd[2] = type;
+  cmd[3] = stride;
+  cmd[4] = offset;
+}
+
+inline void glClear(GLbitfield mask) {
+  ui32* cmd = begin(CMD_CLEAR, 1);
+  cmd[0] = mask;
+}
+
+inline void glDrawArrays(GLenum mode, GLint first, GLsizei count) {
+  ui32* cmd = begin(CMD_DRAW_ARRAYS, 3);
+  cmd[0] = mode;
+  cmd[1] = first;
+  cmd[2] = count;
+}
+
+inline void glDrawElements(GLenum mode, GLsizei count, GLenum type, GLintptr offset) {
+  ui32* cmd = begin(CMD_DRAW_ELEMENTS, 4);
+  cmd[0] = mode;
+  cmd[1] = count;
+  cmd[2] = type;
+  cmd[3] = offset;
+}
+
+inline void glFlush() {
+  begin(CMD_FLUSH, 0);
+}
+
+inline void glVertexAttribDivisor(GLuint index, GLuint divisor) {
+  ui32* cmd = begin(CMD_VERTEX_ATTRIB_DIVISOR, 2);
+  cmd[0] = index;
+  cmd[1] = divisor;
+}
+
+inline void glDrawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instanceCount) {
+  ui32* cmd = begin(CMD_DRAW_ARRAYS_INSTANCED, 4);
+  cmd[0] = mode;
+  cmd[1] = first;
+  cmd[2] = count;
+  cmd[3] = instanceCount;
+}
+
+inline void glDrawElementsInstanced(GLenum mode, GLsizei count, GLenum type, GLintptr offset, GLsizei instanceCount) {
+  ui32* cmd = begin(CMD_DRAW_ELEMENTS_INSTANCED, 5);
+  cmd[0] = mode;
+  cmd[1] = count;
+  cmd[2] = type;
+  cmd[3] = offset;
+  cmd[4] = instanceCount;
+}
+
+inline void glDrawRangeElements(GLenum mode, GLuint start, GLuint end, GLsizei count, GLenum type, GLintptr offset) {
+  ui32* cmd = begin(CMD_DRAW_RANGE_ELEMENTS, 6);
+  cmd[0] = mode;
+  cmd[1] = start;
+  cmd[2] = end;
+  cmd[3] = count;
+  cmd[4] = type;
+  cmd[5] = offset;
+}
+
+inline void glDrawBuffers(GLsizei n, const GLenum* bufs) {
+  size_t size = n;
+  ui32* cmd = begin(CMD_DRAW_BUFFERS, 1 + size);
+  cmd[0] = n;
+  memcpy(cmd + 1, bufs, size * sizeof(ui32));
+}
+
+inline void glClearBufferiv(GLenum buffer, GLint drawbuffer, const GLint* value) {
+  size_t size = (buffer == GL_COLOR ? 4 : 1);
+  ui32* cmd = begin(CMD_CLEAR_BUFFERIV, 2 + size);
+  cmd[0] = buffer;
+  cmd[1] = drawbuffer;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glClearBufferuiv(GLenum buffer, GLint drawbuffer, const GLuint* value) {
+  size_t size = (buffer == GL_COLOR ? 4 : 1);
+  ui32* cmd = begin(CMD_CLEAR_BUFFERUIV, 2 + size);
+  cmd[0] = buffer;
+  cmd[1] = drawbuffer;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glClearBufferfv(GLenum buffer, GLint drawbuffer, const GLfloat* value) {
+  size_t size = (buffer == GL_COLOR ? 4 : 1);
+  ui32* cmd = begin(CMD_CLEAR_BUFFERFV, 2 + size);
+  cmd[0] = buffer;
+  cmd[1] = drawbuffer;
+  memcpy(cmd + 2, value, size * sizeof(ui32));
+}
+
+inline void glClearBufferfi(GLenum buffer, GLint drawbuffer, GLfloat depth, GLint stencil) {
+  ui32* cmd = begin(CMD_CLEAR_BUFFERFI, 4);
+  cmd[0] = buffer;
+  cmd[1] = drawbuffer;
+  cmd[2] = bits(depth);
+  cmd[3] = stencil;
+}
+
+inline void glCreateQuery(GLptr query) {
+  ui32* cmd = begin(CMD_CREATE_QUERY, 1);
+  cmd[0] = handle(query);
+}
+
+inline void glDeleteQuery(GLptr query) {
+  ui32* cmd = begin(CMD_DELETE_QUERY, 1);
+  cmd[0] = handle(query);
+}
+
+inline void glBeginQuery(GLenum target, GLptr query) {
+  ui32* cmd = begin(CMD_BEGIN_QUERY, 2);
+  cmd[0] = target;
+  cmd[1] = handle(query);
+}
+
+inline void glEndQuery(GLenum target) {
+  ui32* cmd = begin(CMD_END_QUERY, 1);
+  cmd[0] = target;
+}
+
+inline void glCreateSampler(GLptr sampler) {
+  ui32* cmd = begin(CMD_CREATE_SAMPLER, 1);
+  cmd[0] = handle(sampler);
+}
+
+inline void glDeleteSampler(GLptr sampler) {
+  ui32* cmd = begin(CMD_DELETE_SAMPLER, 1);
+  cmd[0] = handle(sampler);
+}
+
+inline void glBindSampler(GLuint unit, GLptr sampler) {
+  ui32* cmd = begin(CMD_BIND_SAMPLER, 2);
+  cmd[0] = unit;
+  cmd[1] = handle(sampler);
+}
+
+inline void glSamplerParameteri(GLptr sampler, GLenum pname, GLint param) {
+  ui32* cmd = begin(CMD_SAMPLER_PARAMETERI, 3);
+  cmd[0] = handle(sampler);
+  cmd[1] = pname;
+  cmd[2] = param;
+}
+
+inline void glSamplerParameterf(GLptr sampler, GLenum pname, GLfloat param) {
+  ui32* cmd = begin(CMD_SAMPLER_PARAMETERF, 3);
+  cmd[0] = handle(sampler);
+  cmd[1] = pname;
+  cmd[2] = bits(param);
+}
+
+inline void glFenceSync(GLptr sync, GLenum condition, GLbitfield flags) {
+  ui32* cmd = begin(CMD_FENCE_SYNC, 3);
+  cmd[0] = handle(sync);
+  cmd[1] = condition;
+  cmd[2] = flags;
+}
+
+inline void glDeleteSync(GLptr sync) {
+  ui32* cmd = begin(CMD_DELETE_SYNC, 1);
+  cmd[0] = handle(sync);
+}
+
+inline void glBindBufferBase(GLenum target, GLuint index, GLptr buffer) {
+  ui32* cmd = begin(CMD_BIND_BUFFER_BASE, 3);
+  cmd[0] = target;
+  cmd[1] = index;
+  cmd[2] = handle(buffer);
+}
+
+inline void glBindBufferRange(GLenum target, GLuint index, GLptr buffer, GLintptr offset, GLsizeiptr size) {
+  ui32* cmd = begin(CMD_BIND_BUFFER_RANGE, 5);
+  cmd[0] = target;
+  cmd[1] = index;
+  cmd[2] = handle(buffer);
+  cmd[3] = offset;
+  cmd[4] = size;
+}
+
+inline void glUniformBlockBinding(GLptr program, GLuint uniformBlockIndex, GLuint uniformBlockBinding) {
+  ui32* cmd = begin(CMD_UNIFORM_BLOCK_BINDING, 3);
+  cmd[0] = handle(program);
+  cmd[1] = uniformBlockIndex;
+  cmd[2] = uniformBlockBinding;
+}
+
+inline void glCreateVertexArray(GLptr vertexArray) {
+  ui32* cmd = begin(CMD_CREATE_VERTEX_ARRAY, 1);
+  cmd[0] = handle(vertexArray);
+}
+
+inline void glDeleteVertexArray(GLptr vertexArray) {
+  ui32* cmd = begin(CMD_DELETE_VERTEX_ARRAY, 1);
+  cmd[0] = handle(vertexArray);
+}
+
+inline void glBindVertexArray(GLptr vertexArray) {
+  ui32* cmd = begin(CMD_BIND_VERTEX_ARRAY, 1);
+  cmd[0] = handle(vertexArray);
+}
+
+inline void glQueryCounter(GLptr query, GLenum target) {
+  ui32* cmd = begin(CMD_QUERY_COUNTER, 2);
+  cmd[0] = handle(query);
+  cmd[1] = target;
+}
+
+inline void glMultiDrawArrays(GLenum mode, const GLint* firsts, const GLsizei* counts, GLsizei drawCount) {
+  for (GLsizei pos = 0; pos < drawCount; pos += MAX_MULTI_DRAW) {
+    GLsizei size = (drawCount - pos < (GLsizei)MAX_MULTI_DRAW ? drawCount - pos : (GLsizei)MAX_MULTI_DRAW);
+    ui32* cmd = begin(CMD_MULTI_DRAW_ARRAYS, 2 + size * 2);
+    cmd[0] = mode;
+    cmd[1] = size;
+    for (GLsizei i = 0; i < size; ++i) {
+      cmd[2 + i] = firsts[pos + i];
+      cmd[2 + size + i] = counts[pos + i];
+    }
+  }
+}
+
+inline void glMultiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets, GLsizei drawCount) {
+  for (GLsizei pos = 0; pos < drawCount; pos += MAX_MULTI_DRAW) {
+    GLsizei size = (drawCount - pos < (GLsizei)MAX_MULTI_DRAW ? drawCount - pos : (GLsizei)MAX_MULTI_DRAW);
+    ui32* cmd = begin(CMD_MULTI_DRAW_ELEMENTS, 3 + size * 2);
+    cmd[0] = mode;
+    cmd[1] = type;
+    cmd[2] = size;
+    for (GLsizei i = 0; i < size; ++i) {
+      cmd[3 + i] = counts[pos + i];
+      cmd[3 + size + i] = offsets[pos + i];
+    }
+  }
+}
+
+inline void glMultiDrawElementsInstanced(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets,
+                                         const GLsizei* instanceCounts, GLsizei drawCount) {
+  for (GLsizei pos = 0; pos < drawCount; pos += MAX_MULTI_DRAW) {
+    GLsizei size = (drawCount - pos < (GLsizei)MAX_MULTI_DRAW ? drawCount - pos : (GLsizei)MAX_MULTI_DRAW);
+    ui32* cmd = begin(CMD_MULTI_DRAW_ELEMENTS_INSTANCED, 3 + size * 3);
+    cmd[0] = mode;
+    cmd[1] = type;
+    cmd[2] = size;
+    for (GLsizei i = 0; i < size; ++i) {
+      cmd[3 + i] = counts[pos + i];
+      cmd[3 + size + i] = offsets[pos + i];
+      cmd[3 + size * 2 + i] = instanceCounts[pos + i];
+    }
+  }
+}
+
+}
+
+#define glScissor GLCommands::glScissor
+#define glViewport GLCommands::glViewport
+#define glActiveTexture GLCommands::glActiveTexture
+#define glBlendColor GLCommands::glBlendColor
+#define glBlendEquation GLCommands::glBlendEquation
+#define glBlendEquationSeparate GLCommands::glBlendEquationSeparate
+#define glBlendFunc GLCommands::glBlendFunc
+#define glBlendFuncSeparate GLCommands::glBlendFuncSeparate
+#define glClearColor GLCommands::glClearColor
+#define glClearDepth GLCommands::glClearDepth
+#define glClearStencil GLCommands::glClearStencil
+#define glColorMask GLCommands::glColorMask
+#define glCullFace GLCommands::glCullFace
+#define glDepthFunc GLCommands::glDepthFunc
+#define glDepthMask GLCommands::glDepthMask
+#define glDepthRange GLCommands::glDepthRange
+#define glDisable GLCommands::glDisable
+#define glEnable GLCommands::glEnable
+#define glFrontFace GLCommands::glFrontFace
+#define glHint GLCommands::glHint
+#define glLineWidth GLCommands::glLineWidth
+#define glPixelStorei GLCommands::glPixelStorei
+#define glPolygonOffset GLCommands::glPolygonOffset
+#define glSampleCoverage GLCommands::glSampleCoverage
+#define glStencilFunc GLCommands::glStencilFunc
+#define glStencilFuncSeparate GLCommands::glStencilFuncSeparate
+#define glStencilMask GLCommands::glStencilMask
+#define glStencilMaskSeparate GLCommands::glStencilMaskSeparate
+#define glStencilOp GLCommands::glStencilOp
+#define glStencilOpSeparate GLCommands::glStencilOpSeparate
+#define glBindBuffer GLCommands::glBindBuffer
+#define glCreateBuffer GLCommands::glCreateBuffer
+#define glDeleteBuffer GLCommands::glDeleteBuffer
+#define glCopyBufferSubData GLCommands::glCopyBufferSubData
+#define glBindFramebuffer GLCommands::glBindFramebuffer
+#define glCreateFramebuffer GLCommands::glCreateFramebuffer
+#define glDeleteFramebuffer GLCommands::glDeleteFramebuffer
+#define glFramebufferRenderbuffer GLCommands::glFramebufferRenderbuffer
+#define glFramebufferTexture2D GLCommands::glFramebufferTexture2D
+#define glReadPixelsBuffer GLCommands::glReadPixelsBuffer
+#define glBlitFramebuffer GLCommands::glBlitFramebuffer
+#define glFramebufferTextureLayer GLCommands::glFramebufferTextureLayer
+#define glInvalidateFramebuffer GLCommands::glInvalidateFramebuffer
+#define glInvalidateSubFramebuffer GLCommands::glInvalidateSubFramebuffer
+#define glReadBuffer GLCommands::glReadBuffer
+#define glBindRenderbuffer GLCommands::glBindRenderbuffer
+#define glCreateRenderbuffer GLCommands::glCreateRenderbuffer
+#define glDeleteRenderbuffer GLCommands::glDeleteRenderbuffer
+#define glRenderbufferStorage GLCommands::glRenderbufferStorage
+#define glRenderbufferStorageMultisample GLCommands::glRenderbufferStorageMultisample
+#define glBindTexture GLCommands::glBindTexture
+#define glCopyTexSubImage2D GLCommands::glCopyTexSubImage2D
+#define glCreateTexture GLCommands::glCreateTexture
+#define glDeleteTexture GLCommands::glDeleteTexture
+#define glGenerateMipmap GLCommands::glGenerateMipmap
+#define glTexSubImage2DBuffer GLCommands::glTexSubImage2DBuffer
+#define glTexParameteri GLCommands::glTexParameteri
+#define glTexParameterf GLCommands::glTexParameterf
+#define glTexStorage2D GLCommands::glTexStorage2D
+#define glTexStorage3D GLCommands::glTexStorage3D
+#define glTexSubImage3DBuffer GLCommands::glTexSubImage3DBuffer
+#define glAttachShader GLCommands::glAttachShader
+#define glCompileShader GLCommands::glCompileShader
+#define glCreateProgram GLCommands::glCreateProgram
+#define glCreateShader GLCommands::glCreateShader
+#define glDeleteProgram GLCommands::glDeleteProgram
+#define glDeleteShader GLCommands::glDeleteShader
+#define glDetachShader GLCommands::glDetachShader
+#define glLinkProgram GLCommands::glLinkProgram
+#define glUseProgram GLCommands::glUseProgram
+#define glValidateProgram GLCommands::glValidateProgram
+#define glDisableVertexAttribArray GLCommands::glDisableVertexAttribArray
+#define glEnableVertexAttribArray GLCommands::glEnableVertexAttribArray
+#define glUniform1f GLCommands::glUniform1f
+#define glUniform2f GLCommands::glUniform2f
+#define glUniform3f GLCommands::glUniform3f
+#define glUniform4f GLCommands::glUniform4f
+#define glUniform1i GLCommands::glUniform1i
+#define glUniform2i GLCommands::glUniform2i
+#define glUniform3i GLCommands::glUniform3i
+#define glUniform4i GLCommands::glUniform4i
+#define glUniform1ui GLCommands::glUniform1ui
+#define glUniform2ui GLCommands::glUniform2ui
+#define glUniform3ui GLCommands::glUniform3ui
+#define glUniform4ui GLCommands::glUniform4ui
+#define glUniform1fv GLCommands::glUniform1fv
+#define glUniform2fv GLCommands::glUniform2fv
+#define glUniform3fv GLCommands::glUniform3fv
+#define glUniform4fv GLCommands::glUniform4fv
+#define glUniform1iv GLCommands::glUniform1iv
+#define glUniform2iv GLCommands::glUniform2iv
+#define glUniform3iv GLCommands::glUniform3iv
+#define glUniform4iv GLCommands::glUniform4iv
+#define glUniform1uiv GLCommands::glUniform1uiv
+#define glUniform2uiv GLCommands::glUniform2uiv
+#define glUniform3uiv GLCommands::glUniform3uiv
+#define glUniform4uiv GLCommands::glUniform4uiv
+#define glUniformMatrix2fv GLCommands::glUniformMatrix2fv
+#define glUniformMatrix3fv GLCommands::glUniformMatrix3fv
+#define glUniformMatrix4fv GLCommands::glUniformMatrix4fv
+#define glUniformMatrix2x3fv GLCommands::glUniformMatrix2x3fv
+#define glUniformMatrix3x2fv GLCommands::glUniformMatrix3x2fv
+#define glUniformMatrix2x4fv GLCommands::glUniformMatrix2x4fv
+#define glUniformMatrix4x2fv GLCommands::glUniformMatrix4x2fv
+#define glUniformMatrix3x4fv GLCommands::glUniformMatrix3x4fv
+#define glUniformMatrix4x3fv GLCommands::glUniformMatrix4x3fv
+#define glVertexAttrib1f GLCommands::glVertexAttrib1f
+#define glVertexAttrib2f GLCommands::glVertexAttrib2f
+#define glVertexAttrib3f GLCommands::glVertexAttrib3f
+#define glVertexAttrib4f GLCommands::glVertexAttrib4f
+#define glVertexAttribPointer GLCommands::glVertexAttribPointer
+#define glVertexAttribI4i GLCommands::glVertexAttribI4i
+#define glVertexAttribI4ui GLCommands::glVertexAttribI4ui
+#define glVertexAttribIPointer GLCommands::glVertexAttribIPointer
+#define glClear GLCommands::glClear
+#define glDrawArrays GLCommands::glDrawArrays
+#define glDrawElements GLCommands::glDrawElements
+#define glFlush GLCommands::glFlush
+#define glVertexAttribDivisor GLCommands::glVertexAttribDivisor
+#define glDrawArraysInstanced GLCommands::glDrawArraysInstanced
+#define glDrawElementsInstanced GLCommands::glDrawElementsInstanced
+#define glDrawRangeElements GLCommands::glDrawRangeElements
+#define glDrawBuffers GLCommands::glDrawBuffers
+#define glClearBufferiv GLCommands::glClearBufferiv
+#define glClearBufferuiv GLCommands::glClearBufferuiv
+#define glClearBufferfv GLCommands::glClearBufferfv
+#define glClearBufferfi GLCommands::glClearBufferfi
+#define glCreateQuery GLCommands::glCreateQuery
+#define glDeleteQuery GLCommands::glDeleteQuery
+#define glBeginQuery GLCommands::glBeginQuery
+#define glEndQuery GLCommands::glEndQuery
+#define glCreateSampler GLCommands::glCreateSampler
+#define glDeleteSampler GLCommands::glDeleteSampler
+#define glBindSampler GLCommands::glBindSampler
+#define glSamplerParameteri GLCommands::glSamplerParameteri
+#define glSamplerParameterf GLCommands::glSamplerParameterf
+#define glFenceSync GLCommands::glFenceSync
+#define glDeleteSync GLCommands::glDeleteSync
+#define glBindBufferBase GLCommands::glBindBufferBase
+#define glBindBufferRange GLCommands::glBindBufferRange
+#define glUniformBlockBinding GLCommands::glUniformBlockBinding
+#define glCreateVertexArray GLCommands::glCreateVertexArray
+#define glDeleteVertexArray GLCommands::glDeleteVertexArray
+#define glBindVertexArray GLCommands::glBindVertexArray
+#define glQueryCounter GLCommands::glQueryCounter
+#define glMultiDrawArrays GLCommands::glMultiDrawArrays
+#define glMultiDrawElements GLCommands::glMultiDrawElements
+#define glMultiDrawElementsInstanced GLCommands::glMultiDrawElementsInstanced
+
+#define glVersion() GLCommands::sync(glVersion)
+#define glCanvasWidth() GLCommands::sync(glCanvasWidth)
+#define glCanvasHeight() GLCommands::sync(glCanvasHeight)
+#define glIsContextLost() GLCommands::sync(glIsContextLost)
+#define glGetError() GLCommands::sync(glGetError)
+#define glIsEnabled(...) GLCommands::sync(glIsEnabled, __VA_ARGS__)
+#define glGetBoolean(...) GLCommands::sync(glGetBoolean, __VA_ARGS__)
+#define glGetInteger(...) GLCommands::sync(glGetInteger, __VA_ARGS__)
+#define glGetFloat(...) GLCommands::sync(glGetFloat, __VA_ARGS__)
+#define glGetDouble(...) GLCommands::sync(glGetDouble, __VA_ARGS__)
+#define glGetIntegerv(...) GLCommands::sync(glGetIntegerv, __VA_ARGS__)
+#define glGetBooleanv(...) GLCommands::sync(glGetBooleanv, __VA_ARGS__)
+#define glGetFloatv(...) GLCommands::sync(glGetFloatv, __VA_ARGS__)
+#define glGetDoublev(...) GLCommands::sync(glGetDoublev, __VA_ARGS__)
+#define glGetString(...) GLCommands::sync(glGetString, __VA_ARGS__)
+#define glGetIntegeri(...) GLCommands::sync(glGetIntegeri, __VA_ARGS__)
+#define glGetIntegeri_v(...) GLCommands::sync(glGetIntegeri_v, __VA_ARGS__)
+#define glBufferData(...) GLCommands::record(glBufferData, GLCommands::captureBufferData_, __VA_ARGS__)
+#define glBufferSubData(...) GLCommands::record(glBufferSubData, GLCommands::captureBufferSubData_, __VA_ARGS__)
+#define glGetBufferParameter(...) GLCommands::sync(glGetBufferParameter, __VA_ARGS__)
+#define glIsBuffer(...) GLCommands::sync(glIsBuffer, __VA_ARGS__)
+#define glGetBufferSubData(...) GLCommands::sync(glGetBufferSubData, __VA_ARGS__)
+#define glCheckFramebufferStatus(...) GLCommands::sync(glCheckFramebufferStatus, __VA_ARGS__)
+#define glGetFramebufferAttachmentParameter(...) GLCommands::sync(glGetFramebufferAttachmentParameter, __VA_ARGS__)
+#define glIsFramebuffer(...) GLCommands::sync(glIsFramebuffer, __VA_ARGS__)
+#define glReadPixels(...) GLCommands::sync(glReadPixels, __VA_ARGS__)
+#define glGetRenderbufferParameter(...) GLCommands::sync(glGetRenderbufferParameter, __VA_ARGS__)
+#define glIsRenderbuffer(...) GLCommands::sync(glIsRenderbuffer, __VA_ARGS__)
+#define glGetInternalformativ(...) GLCommands::sync(glGetInternalformativ, __VA_ARGS__)
+#define glCompressedTexImage2D(...) GLCommands::record(glCompressedTexImage2D, GLCommands::captureCompressedTexImage2D_, __VA_ARGS__)
+#define glCompressedTexImage2DBuffer(...) GLCommands::record(glCompressedTexImage2DBuffer, GLCommands::captureCompressedTexImage2DBuffer_, __VA_ARGS__)
+#define glCompressedTexSubImage2D(...) GLCommands::record(glCompressedTexSubImage2D, GLCommands::captureCompressedTexSubImage2D_, __VA_ARGS__)
+#define glCompressedTexSubImage2DBuffer(...) GLCommands::record(glCompressedTexSubImage2DBuffer, GLCommands::captureCompressedTexSubImage2DBuffer_, __VA_ARGS__)
+#define glCopyTexImage2D(...) GLCommands::record(glCopyTexImage2D, GLCommands::captureCopyTexImage2D_, __VA_ARGS__)
+#define glGetTexParameteri(...) GLCommands::sync(glGetTexParameteri, __VA_ARGS__)
+#define glGetTexParameterf(...) GLCommands::sync(glGetTexParameterf, __VA_ARGS__)
+#define glGetTexParameteriv(...) GLCommands::sync(glGetTexParameteriv, __VA_ARGS__)
+#define glGetTexParameterfv(...) GLCommands::sync(glGetTexParameterfv, __VA_ARGS__)
+#define glIsTexture(...) GLCommands::sync(glIsTexture, __VA_ARGS__)
+#define glTexImage2D(...) GLCommands::record(glTexImage2D, GLCommands::captureTexImage2D_, __VA_ARGS__)
+#define glTexImage2DBuffer(...) GLCommands::record(glTexImage2DBuffer, GLCommands::captureTexImage2DBuffer_, __VA_ARGS__)
+#define glTexSubImage2D(...) GLCommands::record(glTexSubImage2D, GLCommands::captureTexSubImage2D_, __VA_ARGS__)
+#define glTexImage3D(...) GLCommands::record(glTexImage3D, GLCommands::captureTexImage3D_, __VA_ARGS__)
+#define glTexImage3DBuffer(...) GLCommands::record(glTexImage3DBuffer, GLCommands::captureTexImage3DBuffer_, __VA_ARGS__)
+#define glTexSubImage3D(...) GLCommands::record(glTexSubImage3D, GLCommands::captureTexSubImage3D_, __VA_ARGS__)
+#define glCompressedTexImage3D(...) GLCommands::record(glCompressedTexImage3D, GLCommands::captureCompressedTexImage3D_, __VA_ARGS__)
+#define glCompressedTexImage3DBuffer(...) GLCommands::record(glCompressedTexImage3DBuffer, GLCommands::captureCompressedTexImage3DBuffer_, __VA_ARGS__)
+#define glCompressedTexSubImage3D(...) GLCommands::record(glCompressedTexSubImage3D, GLCommands::captureCompressedTexSubImage3D_, __VA_ARGS__)
+#define glCompressedTexSubImage3DBuffer(...) GLCommands::record(glCompressedTexSubImage3DBuffer, GLCommands::captureCompressedTexSubImage3DBuffer_, __VA_ARGS__)
+#define glBindAttribLocation(...) GLCommands::record(glBindAttribLocation, GLCommands::captureBindAttribLocation_, __VA_ARGS__)
+#define glGetAttachedShaders(...) GLCommands::sync(glGetAttachedShaders, __VA_ARGS__)
+#define glGetProgrami(...) GLCommands::sync(glGetProgrami, __VA_ARGS__)
+#define glGetProgramInfoLog(...) GLCommands::sync(glGetProgramInfoLog, __VA_ARGS__)
+#define glGetShaderi(...) GLCommands::sync(glGetShaderi, __VA_ARGS__)
+#define glGetShaderPrecisionFormat(...) GLCommands::sync(glGetShaderPrecisionFormat, __VA_ARGS__)
+#define glGetShaderInfoLog(...) GLCommands::sync(glGetShaderInfoLog, __VA_ARGS__)
+#define glGetShaderSource(...) GLCommands::sync(glGetShaderSource, __VA_ARGS__)
+#define glIsProgram(...) GLCommands::sync(glIsProgram, __VA_ARGS__)
+#define glIsShader(...) GLCommands::sync(glIsShader, __VA_ARGS__)
+#define glShaderSource(...) GLCommands::record(glShaderSource, GLCommands::captureShaderSource_, __VA_ARGS__)
+#define glGetFragDataLocation(...) GLCommands::sync(glGetFragDataLocation, __VA_ARGS__)
+#define glGetActiveAttrib(...) GLCommands::sync(glGetActiveAttrib, __VA_ARGS__)
+#define glGetActiveUniform(...) GLCommands::sync(glGetActiveUniform, __VA_ARGS__)
+#define glGetAttribLocation(...) GLCommands::sync(glGetAttribLocation, __VA_ARGS__)
+#define glGetUniformfv(...) GLCommands::sync(glGetUniformfv, __VA_ARGS__)
+#define glGetUniformiv(...) GLCommands::sync(glGetUniformiv, __VA_ARGS__)
+#define glGetUniformuiv(...) GLCommands::sync(glGetUniformuiv, __VA_ARGS__)
+#define glGetUniformLocation(...) GLCommands::record(glGetUniformLocation, GLCommands::captureGetUniformLocation_, __VA_ARGS__)
+#define glGetVertexAttribi(...) GLCommands::sync(glGetVertexAttribi, __VA_ARGS__)
+#define glGetVertexAttribiv(...) GLCommands::sync(glGetVertexAttribiv, __VA_ARGS__)
+#define glGetVertexAttribIiv(...) GLCommands::sync(glGetVertexAttribIiv, __VA_ARGS__)
+#define glGetVertexAttribIuiv(...) GLCommands::sync(glGetVertexAttribIuiv, __VA_ARGS__)
+#define glGetVertexAttribfv(...) GLCommands::sync(glGetVertexAttribfv, __VA_ARGS__)
+#define glGetVertexAttribdv(...) GLCommands::sync(glGetVertexAttribdv, __VA_ARGS__)
+#define glGetVertexAttribOffset(...) GLCommands::sync(glGetVertexAttribOffset, __VA_ARGS__)
+#define glVertexAttrib1fv(...) GLCommands::record(glVertexAttrib1fv, GLCommands::captureVertexAttrib1fv_, __VA_ARGS__)
+#define glVertexAttrib2fv(...) GLCommands::record(glVertexAttrib2fv, GLCommands::captureVertexAttrib2fv_, __VA_ARGS__)
+#define glVertexAttrib3fv(...) GLCommands::record(glVertexAttrib3fv, GLCommands::captureVertexAttrib3fv_, __VA_ARGS__)
+#define glVertexAttrib4fv(...) GLCommands::record(glVertexAttrib4fv, GLCommands::captureVertexAttrib4fv_, __VA_ARGS__)
+#define glVertexAttribI4iv(...) GLCommands::record(glVertexAttribI4iv, GLCommands::captureVertexAttribI4iv_, __VA_ARGS__)
+#define glVertexAttribI4uiv(...) GLCommands::record(glVertexAttribI4uiv, GLCommands::captureVertexAttribI4uiv_, __VA_ARGS__)
+#define glFinish() GLCommands::sync(glFinish)
+#define glIsQuery(...) GLCommands::sync(glIsQuery, __VA_ARGS__)
+#define glGetQuery(...) GLCommands::sync(glGetQuery, __VA_ARGS__)
+#define glGetQueryiv(...) GLCommands::sync(glGetQueryiv, __VA_ARGS__)
+#define glGetQueryParameter(...) GLCommands::sync(glGetQueryParameter, __VA_ARGS__)
+#define glGetQueryObjectiv(...) GLCommands::sync(glGetQueryObjectiv, __VA_ARGS__)
+#define glGetQueryObjectuiv(...) GLCommands::sync(glGetQueryObjectuiv, __VA_ARGS__)
+#define glIsSampler(...) GLCommands::sync(glIsSampler, __VA_ARGS__)
+#define glGetSamplerParameteri(...) GLCommands::sync(glGetSamplerParameteri, __VA_ARGS__)
+#define glGetSamplerParameterf(...) GLCommands::sync(glGetSamplerParameterf, __VA_ARGS__)
+#define glGetSamplerParameteriv(...) GLCommands::sync(glGetSamplerParameteriv, __VA_ARGS__)
+#define glGetSamplerParameterfv(...) GLCommands::sync(glGetSamplerParameterfv, __VA_ARGS__)
+#define glIsSync(...) GLCommands::sync(glIsSync, __VA_ARGS__)
+#define glClientWaitSync(...) GLCommands::sync(glClientWaitSync, __VA_ARGS__)
+#define glWaitSync(...) GLCommands::sync(glWaitSync, __VA_ARGS__)
+#define glGetSynci(...) GLCommands::sync(glGetSynci, __VA_ARGS__)
+#define glGetSynciv(...) GLCommands::sync(glGetSynciv, __VA_ARGS__)
+#define glCreateTransformFeedback(...) GLCommands::record(glCreateTransformFeedback, GLCommands::captureCreateTransformFeedback_, __VA_ARGS__)
+#define glDeleteTransformFeedback(...) GLCommands::record(glDeleteTransformFeedback, GLCommands::captureDeleteTransformFeedback_, __VA_ARGS__)
+#define glIsTransformFeedback(...) GLCommands::sync(glIsTransformFeedback, __VA_ARGS__)
+#define glBindTransformFeedback(...) GLCommands::record(glBindTransformFeedback, GLCommands::captureBindTransformFeedback_, __VA_ARGS__)
+#define glBeginTransformFeedback(...) GLCommands::record(glBeginTransformFeedback, GLCommands::captureBeginTransformFeedback_, __VA_ARGS__)
+#define glEndTransformFeedback() GLCommands::record(glEndTransformFeedback, GLCommands::captureEndTransformFeedback_)
+#define glTransformFeedbackVaryings(...) GLCommands::record(glTransformFeedbackVaryings, GLCommands::captureTransformFeedbackVaryings_, __VA_ARGS__)
+#define glGetTransformFeedbackVarying(...) GLCommands::sync(glGetTransformFeedbackVarying, __VA_ARGS__)
+#define glPauseTransformFeedback() GLCommands::record(glPauseTransformFeedback, GLCommands::capturePauseTransformFeedback_)
+#define glResumeTransformFeedback() GLCommands::record(glResumeTransformFeedback, GLCommands::captureResumeTransformFeedback_)
+#define glGetUniformIndices(...) GLCommands::sync(glGetUniformIndices, __VA_ARGS__)
+#define glGetActiveUniformsiv(...) GLCommands::sync(glGetActiveUniformsiv, __VA_ARGS__)
+#define glGetUniformBlockIndex(...) GLCommands::sync(glGetUniformBlockIndex, __VA_ARGS__)
+#define glGetActiveUniformBlockiv(...) GLCommands::sync(glGetActiveUniformBlockiv, __VA_ARGS__)
+#define glGetActiveUniformBlockName(...) GLCommands::sync(glGetActiveUniformBlockName, __VA_ARGS__)
+#define glIsVertexArray(...) GLCommands::sync(glIsVertexArray, __VA_ARGS__)
+#define glGetExtension(...) GLCommands::record(glGetExtension, GLCommands::captureGetExtension_, __VA_ARGS__)
+#define glGetTranslatedShaderSource(...) GLCommands::sync(glGetTranslatedShaderSource, __VA_ARGS__)
+#define glLoseContext() GLCommands::sync(glLoseContext)
+#define glRestoreContext() GLCommands::sync(glRestoreContext)
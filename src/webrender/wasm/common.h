@@ -1,7 +1,9 @@
 #pragma once
 
-typedef long i32;
-typedef unsigned long ui32;
+typedef int i32;
+typedef unsigned int ui32;
+typedef long long i64;
+typedef unsigned long long ui64;
 typedef float f32;
 typedef double f64;
 
@@ -0,0 +1,183 @@
+#include "destroyQueue.h"
+#include "sync.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+class DestroyQueue {
+public:
+  struct Entry {
+    GLBase* object;
+    ui32 frame;
+  };
+  struct Fence {
+    Sync* sync;
+    ui32 frame;
+  };
+  // Blocks of destroyed objects from one pool, linked through their first word
+  struct Freed {
+    SizedPool* pool;
+    void* first;
+    void* last;
+  };
+  enum {
+    // More than the number of object sizes; past that, chains are returned early
+    MAX_FREED_POOLS = 16,
+  };
+
+  // Entries in release order, so frames never decrease from head to tail. An object
+  // released again after being revived gets another entry; only the one matching
+  // its retiredFrame_ counts.
+  Entry* entries = nullptr;
+  size_t head = 0;
+  size_t tail = 0;
+  size_t capacity = 0;
+  Fence fences[MAX_DESTROY_FENCES];
+  ui32 numFences = 0;
+  DestroyStats stats;
+  Freed freed[MAX_FREED_POOLS];
+  ui32 numFreed = 0;
+
+  void retire(GLBase* object) {
+    ui32 frame = frameIndex();
+    if (object->retired_ && object->retiredFrame_ == frame) {
+      return;
+    }
+    object->retired_ = true;
+    object->retiredFrame_ = frame;
+    if (tail == capacity) {
+      if (head && head >= tail - head) {
+        // At least half is consumed, so the live entries move without overlapping
+        memcpy(entries, entries + head, (tail - head) * sizeof(Entry));
+        tail -= head;
+        head = 0;
+      } else {
+        capacity = (capacity ? capacity * 2 : 256);
+        entries = (Entry*)_mem::realloc(entries, capacity * sizeof(Entry));
+      }
+    }
+    entries[tail++] = Entry{object, frame};
+    stats.pending += 1;
+  }
+
+  // Runs the destructor and collects the memory, which is returned to the pools in one
+  // step per pool by freeAll()
+  void destroyObject(GLBase* object) {
+    SizedPool& pool = object->sizedPool_();
+    object->~GLBase();
+    // GLBase is the first base of every object, so the block starts at the object
+    void* block = object;
+    ui32 i = 0;
+    while (i < numFreed && freed[i].pool != &pool) {
+      ++i;
+    }
+    if (i == numFreed) {
+      if (numFreed == MAX_FREED_POOLS) {
+        freeAll();
+      }
+      freed[numFreed++] = Freed{&pool, block, block};
+      return;
+    }
+    *(void**)block = freed[i].first;
+    freed[i].first = block;
+  }
+
+  void freeAll() {
+    for (ui32 i = 0; i < numFreed; ++i) {
+      freed[i].pool->free(freed[i].first, freed[i].last);
+    }
+    numFreed = 0;
+  }
+
+  // Destructors may release more objects, which are appended while this runs
+  void destroy(bool all, ui32 lastFrame) {
+    while (head < tail && (all || entries[head].frame <= lastFrame)) {
+      Entry entry = entries[head++];
+      stats.pending -= 1;
+      GLBase* object = entry.object;
+      if (object->retiredFrame_ != entry.frame) {
+        continue;
+      }
+      object->retired_ = false;
+      if (object->refCount_) {
+        stats.revived += 1;
+      } else {
+        destroyObject(object);
+        stats.destroyed += 1;
+      }
+    }
+    freeAll();
+    if (head == tail) {
+      head = tail = 0;
+    }
+  }
+
+  // The queue's own fences are deleted directly rather than released into it
+  void popFence() {
+    delete fences[0].sync;
+    numFences -= 1;
+    for (ui32 i = 0; i < numFences; ++i) {
+      fences[i] = fences[i + 1];
+    }
+  }
+};
+
+static DestroyQueue queue_;
+
+const DestroyStats& getDestroyStats() {
+  return queue_.stats;
+}
+
+void destroyReleased() {
+  while (queue_.numFences) {
+    queue_.popFence();
+  }
+  queue_.destroy(true, 0);
+}
+
+#ifdef GL_LEAK_CHECK
+void reportLeaks_() {
+  const HandlePool& handles = GLBase::handles();
+  size_t count = handles.size();
+  if (!count) {
+    return;
+  }
+  ui32* leaked = (ui32*)_mem::malloc(count * sizeof(ui32));
+  handles.collect(leaked);
+  glReportLeaks(leaked, count);
+  _mem::free(leaked);
+}
+#endif
+
+void collectReleased_(ui32 frame) {
+  if (getFeature(FEATURE_FENCE_SYNC)) {
+    bool done = false;
+    ui32 lastFrame = 0;
+    while (queue_.numFences && queue_.fences[0].sync->signaled()) {
+      done = true;
+      lastFrame = queue_.fences[0].frame;
+      queue_.popFence();
+    }
+    if (done) {
+      queue_.destroy(false, lastFrame);
+    }
+    // One fence covers everything released up to the end of this frame. With all
+    // fences pending, the newest one is replaced by this frame's, which signals later.
+    if (queue_.head < queue_.tail && queue_.entries[queue_.tail - 1].frame == frame) {
+      if (queue_.numFences == MAX_DESTROY_FENCES) {
+        queue_.numFences -= 1;
+        delete queue_.fences[queue_.numFences].sync;
+      }
+      queue_.fences[queue_.numFences++] = DestroyQueue::Fence{Sync::create(), frame};
+    }
+  } else if (frame >= FRAME_LATENCY) {
+    queue_.destroy(false, frame - FRAME_LATENCY);
+  }
+}
+
+}
+
+void GLBase::retire_() {
+  WebGL::queue_.retire(this);
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "webgl.h"
+
+// Debug builds report objects that are still alive at shutdown(); release builds
+// compile the check out unless GL_LEAK_CHECK is defined.
+#if !defined(NDEBUG) && !defined(GL_LEAK_CHECK)
+#define GL_LEAK_CHECK
+#endif
+
+namespace WebGL
+{
+
+// Objects whose last reference is released are not deleted on the spot, where the GPU
+// may still be using them in the current frame. They wait here with the index of the
+// frame they were released in, and endFrame() destroys them in one batch once a fence
+// shows the GPU is past that frame, returning their memory to each pool in one step.
+// Without fences (WebGL1) they wait FRAME_LATENCY frames.
+//
+// Interned objects (programs, shaders, samplers, pipeline states) can be found and
+// addref'd again while they wait; they are kept instead of destroyed.
+enum {
+  FRAME_LATENCY = 3,
+  // Fences pending at once; past that the newest fence also covers later frames
+  MAX_DESTROY_FENCES = 8,
+};
+
+struct DestroyStats {
+  ui32 pending = 0;
+  // Totals
+  ui32 destroyed = 0;
+  ui32 revived = 0;
+};
+const DestroyStats& getDestroyStats();
+
+// Destroys everything that is waiting regardless of the GPU, e.g. before the context
+// goes away
+void destroyReleased();
+
+// Called by endFrame() with the index of the frame that ended
+void collectReleased_(ui32 frame);
+
+#ifdef GL_LEAK_CHECK
+// Hands the handles of all live objects to JS (glReportLeaks), if there are any
+void reportLeaks_();
+#endif
+
+}
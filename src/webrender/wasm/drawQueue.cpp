@@ -0,0 +1,345 @@
+#include "drawQueue.h"
+#include "buffer.h"
+#include "texture.h"
+#include "program.h"
+#include "vertexArray.h"
+#include "pipelineState.h"
+#include "streamBuffer.h"
+#include "hash.h"
+#include "frameStats.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+static size_t getIndexSize(GLenum type) {
+  switch (type) {
+  case GL_UNSIGNED_BYTE:
+    return 1;
+  case GL_UNSIGNED_SHORT:
+    return 2;
+  default:
+    return 4;
+  }
+}
+
+DrawQueue::DrawQueue(size_t capacity) {
+  capacity_ = (capacity ? capacity : 1);
+  items_ = (DrawItem*)_mem::malloc(capacity_ * sizeof(DrawItem));
+  keys_ = (ui64*)_mem::malloc(capacity_ * sizeof(ui64));
+  order_ = (ui32*)_mem::malloc(capacity_ * sizeof(ui32));
+}
+
+DrawQueue::~DrawQueue() {
+  _mem::free(items_);
+  _mem::free(keys_);
+  _mem::free(order_);
+  _mem::free(instanceStaging_);
+  _mem::free(multiDrawScratch_);
+}
+
+void DrawQueue::grow_() {
+  capacity_ *= 2;
+  items_ = (DrawItem*)_mem::realloc(items_, capacity_ * sizeof(DrawItem));
+  keys_ = (ui64*)_mem::realloc(keys_, capacity_ * sizeof(ui64));
+  order_ = (ui32*)_mem::realloc(order_, capacity_ * sizeof(ui32));
+}
+
+ui64 DrawQueue::makeKey(ui32 layer, bool translucent, ui32 program, ui32 material, float depth) {
+  // Bit patterns of non-negative floats sort like the values
+  ui32 depthBits = 0;
+  if (depth > 0.0f) {
+    memcpy(&depthBits, &depth, sizeof depthBits);
+  }
+  ui64 depthKey = (depthBits >> 7) & 0xFFFFFF;
+  ui64 key = (ui64)(layer & 0x3F) << 58;
+  if (translucent) {
+    key |= 1ULL << 57;
+    key |= (depthKey ^ 0xFFFFFF) << 33;
+    key |= (ui64)(program & 0xFFF) << 21;
+    key |= (ui64)(material & 0xFFFF) << 5;
+  } else {
+    key |= (ui64)(program & 0xFFF) << 45;
+    key |= (ui64)(material & 0xFFFF) << 29;
+    key |= depthKey << 5;
+  }
+  return key;
+}
+
+void DrawQueue::add(const DrawItem& item, ui32 layer, float depth) {
+  assert(!item.instanceData || !item.instances);
+  if (size_ == capacity_) {
+    grow_();
+  }
+  // Material bits group draws sharing pipeline state, textures and geometry
+  ui32 material[2 + DrawItem::MAX_TEXTURES];
+  material[0] = (ui32)(size_t)item.pipelineState;
+  material[1] = (ui32)(size_t)item.vertexArray;
+  for (ui32 i = 0; i < item.numTextures; ++i) {
+    material[2 + i] = (ui32)(size_t)item.textures[i];
+  }
+  bool translucent = item.pipelineState && (item.pipelineState->desc().enables & PipelineDesc::fBLEND);
+  ui32 program = (item.program ? item.program->id() : 0);
+
+  items_[size_] = item;
+  keys_[size_] = makeKey(layer, translucent, program, hashWords(material, 2 + item.numTextures), depth);
+  order_[size_] = size_;
+  size_ += 1;
+}
+
+// LSD radix sort of (key, index) pairs, one byte per pass. Passes where every key has
+// the same byte are skipped, which is common for the layer and unused bits.
+void DrawQueue::sort_() {
+  enum {
+    NUM_PASSES = 8,
+    NUM_BUCKETS = 256,
+  };
+  size_t count = size_;
+  if (count < 2) {
+    return;
+  }
+  ui32 histogram[NUM_PASSES][NUM_BUCKETS];
+  memset(histogram, 0, sizeof histogram);
+  for (size_t i = 0; i < count; ++i) {
+    ui64 key = keys_[i];
+    for (int pass = 0; pass < NUM_PASSES; ++pass) {
+      histogram[pass][(key >> (pass * 8)) & 0xFF] += 1;
+    }
+  }
+
+  size_t scratchSize = count * (sizeof(ui64) + sizeof(ui32));
+  ui64* keys = keys_;
+  ui32* order = order_;
+  ui64* tmpKeys = (ui64*)sbrk(scratchSize);
+  ui32* tmpOrder = (ui32*)(tmpKeys + count);
+  for (int pass = 0; pass < NUM_PASSES; ++pass) {
+    ui32* counts = histogram[pass];
+    int shift = pass * 8;
+    if (counts[(keys[0] >> shift) & 0xFF] == count) {
+      continue;
+    }
+    ui32 offset = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+      ui32 next = offset + counts[i];
+      counts[i] = offset;
+      offset = next;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      ui32 pos = counts[(keys[i] >> shift) & 0xFF]++;
+      tmpKeys[pos] = keys[i];
+      tmpOrder[pos] = order[i];
+    }
+    ui64* swapKeys = keys;
+    keys = tmpKeys;
+    tmpKeys = swapKeys;
+    ui32* swapOrder = order;
+    order = tmpOrder;
+    tmpOrder = swapOrder;
+  }
+  if (keys != keys_) {
+    memcpy(keys_, keys, count * sizeof(ui64));
+    memcpy(order_, order, count * sizeof(ui32));
+  }
+  sbrk(-(ptrdiff_t)scratchSize);
+}
+
+// Same bindings and primitive type; the vertex ranges may differ
+static bool sameState(const DrawItem& a, const DrawItem& b) {
+  if (a.program != b.program || a.vertexArray != b.vertexArray || a.pipelineState != b.pipelineState ||
+      a.numTextures != b.numTextures || a.mode != b.mode || a.indexType != b.indexType ||
+      a.uniforms.buffer != b.uniforms.buffer || a.uniforms.offset != b.uniforms.offset) {
+    return false;
+  }
+  for (ui32 i = 0; i < a.numTextures; ++i) {
+    if (a.textures[i] != b.textures[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// b can be drawn as another instance of a
+static bool canBatch(const DrawItem& a, const DrawItem& b) {
+  return b.instanceData && !b.instances && a.first == b.first && a.count == b.count && sameState(a, b);
+}
+
+// b can go into the same multi-draw as a. There is no instanced multi-draw for
+// glDrawArrays.
+static bool canMultiDraw(const DrawItem& a, const DrawItem& b) {
+  if (b.instanceData || (a.instances != 0) != (b.instances != 0) || (!a.indexType && a.instances)) {
+    return false;
+  }
+  return sameState(a, b);
+}
+
+// Copies the instance data of all items in submission order with one upload.
+// Returns the offset of the first instance, or INVALID_OFFSET if there is none or
+// it didn't fit, in which case instanced items are drawn one by one.
+size_t DrawQueue::writeInstances_() {
+  size_t offset = StreamBuffer::INVALID_OFFSET;
+  if (!instanceStream_ || !getFeature(FEATURE_INSTANCED_RENDERING)) {
+    return offset;
+  }
+  size_t stride = instanceLayout_.stride;
+  size_t count = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    if (items_[i].instanceData) {
+      ++count;
+    }
+  }
+  if (!count) {
+    return offset;
+  }
+  // Not sbrk scratch: the stream write may allocate a fence
+  size_t dataSize = count * stride;
+  if (dataSize > instanceStagingSize_) {
+    _mem::free(instanceStaging_);
+    instanceStaging_ = (char*)_mem::malloc(dataSize);
+    instanceStagingSize_ = dataSize;
+  }
+  char* out = instanceStaging_;
+  for (size_t i = 0; i < size_; ++i) {
+    const DrawItem& item = items_[order_[i]];
+    if (item.instanceData) {
+      memcpy(out, item.instanceData, stride);
+      out += stride;
+    }
+  }
+  return instanceStream_->write(instanceStaging_, dataSize, stride);
+}
+
+void DrawQueue::setInstanceAttributes_(const DrawItem& item, size_t offset) {
+  const VertexLayout& layout = instanceLayout_;
+  if (offset != StreamBuffer::INVALID_OFFSET) {
+    for (ui32 i = 0; i < layout.numAttributes; ++i) {
+      const VertexLayout::Attribute& attribute = layout.attributes[i];
+      item.vertexArray->setAttribute(attribute.index, instanceStream_->buffer(), attribute.size, attribute.type,
+                                     attribute.normalized != 0, layout.stride, offset + attribute.offset, 1);
+    }
+    return;
+  }
+  // Constant values are ignored while an array is enabled, e.g. from an earlier queue
+  for (ui32 i = 0; i < layout.numAttributes; ++i) {
+    const VertexLayout::Attribute& attribute = layout.attributes[i];
+    item.vertexArray->unsetAttribute(attribute.index);
+    const GLfloat* value = (const GLfloat*)((const char*)item.instanceData + attribute.offset);
+    switch (attribute.size) {
+    case 1: glVertexAttrib1fv(attribute.index, value); break;
+    case 2: glVertexAttrib2fv(attribute.index, value); break;
+    case 3: glVertexAttrib3fv(attribute.index, value); break;
+    default: glVertexAttrib4fv(attribute.index, value); break;
+    }
+  }
+}
+
+// Draws items [start, start + count) in sorted order, which share all state but the
+// vertex range, with one call
+void DrawQueue::multiDraw_(size_t start, size_t count) {
+  const DrawItem& first = items_[order_[start]];
+  size_t scratchSize = count * (sizeof(GLint) + sizeof(GLsizei) * 2 + sizeof(GLintptr));
+  if (scratchSize > multiDrawScratchSize_) {
+    _mem::free(multiDrawScratch_);
+    multiDrawScratch_ = (char*)_mem::malloc(scratchSize);
+    multiDrawScratchSize_ = scratchSize;
+  }
+  GLint* firsts = (GLint*)multiDrawScratch_;
+  GLsizei* counts = (GLsizei*)(firsts + count);
+  GLsizei* instances = counts + count;
+  GLintptr* offsets = (GLintptr*)(instances + count);
+  size_t indexSize = getIndexSize(first.indexType);
+  for (size_t i = 0; i < count; ++i) {
+    const DrawItem& item = items_[order_[start + i]];
+    firsts[i] = item.first;
+    counts[i] = item.count;
+    instances[i] = item.instances;
+    offsets[i] = item.first * indexSize;
+  }
+  if (!first.indexType) {
+    multiDrawArrays(first.mode, firsts, counts, count);
+  } else if (first.instances) {
+    multiDrawElementsInstanced(first.mode, counts, first.indexType, offsets, instances, count);
+  } else {
+    multiDrawElements(first.mode, counts, first.indexType, offsets, count);
+  }
+  drawCalls_ += (getFeature(FEATURE_MULTI_DRAW) ? 1 : count);
+}
+
+void DrawQueue::submit(UniformBuffer* uniforms) {
+  sort_();
+  if (uniforms) {
+    uniforms->upload();
+  }
+  size_t instanceOffset = writeInstances_();
+  bool batching = (instanceOffset != StreamBuffer::INVALID_OFFSET);
+  drawCalls_ = 0;
+  for (size_t i = 0, run = 1; i < size_; i += run) {
+    const DrawItem& item = items_[order_[i]];
+    run = 1;
+    if (batching && item.instanceData) {
+      while (i + run < size_ && canBatch(item, items_[order_[i + run]])) {
+        ++run;
+      }
+    } else if (!item.instanceData) {
+      while (i + run < size_ && canMultiDraw(item, items_[order_[i + run]])) {
+        ++run;
+      }
+    }
+    // Skip draws whose program is still compiling rather than stall on it
+    if (item.program && !item.program->ready()) {
+      if (batching && item.instanceData) {
+        instanceOffset += run * instanceLayout_.stride;
+      }
+      continue;
+    }
+    setPipelineState(item.pipelineState);
+    useProgram(item.program);
+    if (item.uniforms.buffer) {
+      bindBufferRange(GL_UNIFORM_BUFFER, uniformBinding_, item.uniforms.buffer, item.uniforms.offset, item.uniforms.size);
+    }
+    if (item.numTextures && item.samplers[0] >= 0) {
+      // Sampler uniforms belong to the item's program
+      assert(item.program);
+      ui32 units[DrawItem::MAX_TEXTURES];
+      bindTextures(item.textures, item.numTextures, units);
+      for (ui32 slot = 0; slot < item.numTextures; ++slot) {
+        item.program->setUniform(item.samplers[slot], (i32)units[slot]);
+      }
+    } else {
+      for (ui32 unit = 0; unit < item.numTextures; ++unit) {
+        bindTexture(item.textures[unit]->target(), item.textures[unit], unit);
+      }
+    }
+    bindVertexArray(item.vertexArray);
+
+    ui32 instances = item.instances;
+    if (item.instanceData) {
+      setInstanceAttributes_(item, instanceOffset);
+      if (batching) {
+        instanceOffset += run * instanceLayout_.stride;
+        instances = (ui32)run;
+      }
+    } else if (run > 1) {
+      multiDraw_(i, run);
+      continue;
+    }
+    if (item.indexType) {
+      GLintptr offset = item.first * getIndexSize(item.indexType);
+      if (instances) {
+        glDrawElementsInstanced(item.mode, item.count, item.indexType, offset, instances);
+      } else {
+        glDrawElements(item.mode, item.count, item.indexType, offset);
+      }
+    } else {
+      if (instances) {
+        glDrawArraysInstanced(item.mode, item.first, item.count, instances);
+      } else {
+        glDrawArrays(item.mode, item.first, item.count);
+      }
+    }
+    FRAME_DRAW(item.mode, item.count, instances ? instances : 1);
+    ++drawCalls_;
+  }
+  size_ = 0;
+}
+
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "webgl.h"
+#include "uniformBuffer.h"
+#include "vertexArray.h"
+
+namespace WebGL
+{
+
+struct DrawItem {
+  enum {
+    MAX_TEXTURES = 8,
+  };
+  Program* program = nullptr;
+  VertexArray* vertexArray = nullptr;
+  // nullptr uses the GL defaults
+  PipelineState* pipelineState = nullptr;
+  // Bound at the queue's object uniform binding point, if set
+  UniformBuffer::Range uniforms;
+  // Bound to units 0..numTextures-1, unless samplers holds the program's sampler
+  // uniform for each texture; then units are picked by bindTextures and the
+  // sampler uniforms are pointed at them
+  Texture* textures[MAX_TEXTURES];
+  int samplers[MAX_TEXTURES] = {-1, -1, -1, -1, -1, -1, -1, -1};
+  ui32 numTextures = 0;
+  GLenum mode = GL_TRIANGLES;
+  // GL_UNSIGNED_BYTE/SHORT/INT for indexed draws, 0 for glDrawArrays
+  GLenum indexType = 0;
+  // First vertex, or first index for indexed draws
+  ui32 first = 0;
+  ui32 count = 0;
+  // 0 for non-instanced draws
+  ui32 instances = 0;
+  // One instance in the queue's instance layout, read at submit; only for draws with
+  // instances = 0. Adjacent draws in sorted order that have instance data and otherwise
+  // equal state are merged into one instanced draw.
+  const void* instanceData = nullptr;
+};
+
+// Collects draws for a frame, sorts them by a 64-bit key and submits them through the
+// cached binding functions so consecutive draws only change the state that differs.
+//
+// Key layout, from the most significant bit:
+//   opaque:      layer:6 | 0 | program:12 | material:16 | depth:24 | unused:5
+//   translucent: layer:6 | 1 | inverted depth:24 | program:12 | material:16 | unused:5
+// Opaque draws are grouped by state and then go front to back; translucent draws go
+// back to front. Translucency is taken from the pipeline state's blend enable, material
+// is a hash of the pipeline state, vertex array and textures.
+class DrawQueue {
+public:
+  DrawQueue(size_t capacity = 1024);
+  ~DrawQueue();
+
+  DrawQueue(const DrawQueue&) = delete;
+  DrawQueue& operator=(const DrawQueue&) = delete;
+
+  // Uniform buffer binding point for DrawItem::uniforms
+  void setUniformBinding(GLuint binding) {
+    uniformBinding_ = binding;
+  }
+
+  // Per-instance attributes for DrawItem::instanceData: layout.stride bytes per
+  // draw, written to stream and bound to the draw's vertex array with divisor 1.
+  // Without instanced rendering every draw is issued separately with the values
+  // set as constant attributes, which requires GL_FLOAT attributes.
+  void setInstancing(StreamBuffer* stream, const VertexLayout& layout) {
+    instanceStream_ = stream;
+    instanceLayout_ = layout;
+  }
+
+  // depth is the view-space distance, layer is 0..63
+  void add(const DrawItem& item, ui32 layer = 0, float depth = 0.0f);
+  size_t size() const {
+    return size_;
+  }
+
+  static ui64 makeKey(ui32 layer, bool translucent, ui32 program, ui32 material, float depth);
+
+  // Sorts and draws all items, then empties the queue. Data written to uniforms since
+  // its last upload is uploaded once before the first draw. Items whose program is
+  // not ready yet are skipped. Adjacent items without instance data that differ only
+  // in their vertex range go into one multi-draw.
+  void submit(UniformBuffer* uniforms = nullptr);
+  void clear() {
+    size_ = 0;
+  }
+
+  // Draw calls issued by the last submit
+  size_t drawCalls() const {
+    return drawCalls_;
+  }
+
+private:
+  DrawItem* items_;
+  ui64* keys_;
+  ui32* order_;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  GLuint uniformBinding_ = 0;
+  StreamBuffer* instanceStream_ = nullptr;
+  VertexLayout instanceLayout_;
+  size_t drawCalls_ = 0;
+  // Instance data gathered in sorted order, reused across submits
+  char* instanceStaging_ = nullptr;
+  size_t instanceStagingSize_ = 0;
+  // Vertex ranges of one multi-draw, reused across calls
+  char* multiDrawScratch_ = nullptr;
+  size_t multiDrawScratchSize_ = 0;
+
+  void grow_();
+  void sort_();
+  size_t writeInstances_();
+  void setInstanceAttributes_(const DrawItem& item, size_t offset);
+  void multiDraw_(size_t start, size_t count);
+};
+
+}
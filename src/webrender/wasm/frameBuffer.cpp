@@ -1,6 +1,7 @@
 #include "frameBuffer.h"
 #include "renderBuffer.h"
 #include "texture.h"
+#include "frameStats.h"
 
 static int getAttachmentSlot(GLenum attachment) {
   switch (attachment) {
@@ -31,14 +32,10 @@ namespace WebGL
 {
 
 FrameBuffer::~FrameBuffer() {
-  for (int i = 0; i < NUM_ATTACHMENTS; ++i) {
-    if (attachments_[i].object) {
-      attachments_[i].object->release();
-    }
-  }
+  glDeleteFramebuffer(this);
 }
 
-GLptr FrameBuffer::getAttachment(GLenum attachment) {
+GLBase* FrameBuffer::getAttachment(GLenum attachment) {
   return attachments_[getAttachmentSlot(attachment)].object;
 }
 
@@ -46,13 +43,7 @@ void FrameBuffer::renderBuffer(GLenum attachment, RenderBuffer* renderBuffer) {
   int slot = getAttachmentSlot(attachment);
   Attachment& info = attachments_[slot];
   if (info.object != renderBuffer || info.target != GL_RENDERBUFFER) {
-    if (renderBuffer) {
-      renderBuffer->addref();
-    }
-    if (info.object) {
-      info.object->release();
-    }
-    info.object = renderBuffer;
+    info.object = Ref<RenderBuffer>::borrow(renderBuffer);
     info.target = GL_RENDERBUFFER;
     GLenum current = isCurrent_();
     if (current) {
@@ -68,12 +59,10 @@ void FrameBuffer::texture2D(GLenum attachment, Texture* texture, GLenum target,
   Attachment& info = attachments_[slot];
   if (info.object != texture || info.target != target || info.level != level) {
     if (texture) {
-      texture->addref();
-    }
-    if (info.object) {
-      info.object->release();
+      texture->restore();
+      texture->setMemoryCategory(MEMORY_RENDER_TARGET);
     }
-    info.object = texture;
+    info.object = Ref<Texture>::borrow(texture);
     info.target = target;
     info.level = level;
     GLenum current = isCurrent_();
@@ -85,17 +74,15 @@ void FrameBuffer::texture2D(GLenum attachment, Texture* texture, GLenum target,
   }
 }
 
-void FrameBuffer::textureLayer(GLenum attachment, Texture* texture, int layer, int level = 0) {
+void FrameBuffer::textureLayer(GLenum attachment, Texture* texture, int layer, int level) {
   int slot = getAttachmentSlot(attachment);
   Attachment& info = attachments_[slot];
   if (info.object != texture || info.target != GL_TEXTURE_2D_ARRAY || info.layer != layer || info.level != level) {
     if (texture) {
-      texture->addref();
-    }
-    if (info.object) {
-      info.object->release();
+      texture->restore();
+      texture->setMemoryCategory(MEMORY_RENDER_TARGET);
     }
-    info.object = texture;
+    info.object = Ref<Texture>::borrow(texture);
     info.target = GL_TEXTURE_2D_ARRAY;
     info.layer = layer;
     info.level = level;
@@ -120,17 +107,18 @@ GLenum FrameBuffer::isCurrent_() const {
 
 void FrameBuffer::onBind(GLenum target) {
   glBindFramebuffer(target, this);
+  FRAME_STAT(frameBufferSwitches, 1);
   if (dirtyFlags_) {
     for (int i = 0; i < NUM_ATTACHMENTS; ++i) {
       if (dirtyFlags_ & (1 << i)) {
         GLenum attachment = getSlotAttachment(i);
         Attachment& info = attachments_[i];
         if (info.target == GL_RENDERBUFFER) {
-          glFramebufferRenderbuffer(target, attachment, GL_RENDERBUFFER, info.object);
+          glFramebufferRenderbuffer(target, attachment, GL_RENDERBUFFER, info.object.get());
         } else if (info.target == GL_TEXTURE_2D_ARRAY) {
-          glFramebufferTextureLayer(target, attachment, info.object, info.level, info.layer);
+          glFramebufferTextureLayer(target, attachment, info.object.get(), info.level, info.layer);
         } else {
-          glFramebufferTexture2D(target, attachment, info.target, info.object, info.level);
+          glFramebufferTexture2D(target, attachment, info.target, info.object.get(), info.level);
         }
       }
     }
@@ -149,6 +137,10 @@ void FrameBuffer::invalidate() {
   WebGL::bindFrameBuffer(GL_FRAMEBUFFER, this);
   glInvalidateFramebuffer(GL_FRAMEBUFFER, numAttachments, attachments);
 }
+void FrameBuffer::invalidate(const GLenum* attachments, size_t count) {
+  WebGL::bindFrameBuffer(GL_FRAMEBUFFER, this);
+  glInvalidateFramebuffer(GL_FRAMEBUFFER, count, attachments);
+}
 void FrameBuffer::invalidateRect(int x, int y, size_t width, size_t height) {
   GLenum attachments[NUM_ATTACHMENTS];
   size_t numAttachments = 0;
@@ -19,7 +19,7 @@ public:
     return glCheckFramebufferStatus(GL_FRAMEBUFFER);
   }
 
-  GLptr getAttachment(GLenum attachment);
+  GLBase* getAttachment(GLenum attachment);
   int getAttachmentParameter(GLenum attachment, GLenum pname) {
     WebGL::bindFrameBuffer(GL_FRAMEBUFFER, this);
     return glGetFramebufferAttachmentParameter(GL_FRAMEBUFFER, attachment, pname);
@@ -39,6 +39,7 @@ public:
   }
 
   void invalidate();
+  void invalidate(const GLenum* attachments, size_t count);
   void invalidateRect(int x, int y, size_t width, size_t height);
 
   void readPixels(GLenum attachment, int x, int y, size_t width, size_t height, GLenum format, GLenum type, void* pixels);
@@ -53,7 +54,7 @@ private:
   };
   ui32 dirtyFlags_ = 0;
   struct Attachment {
-    GLptr object = nullptr;
+    Ref<GLBase> object;
     GLenum target;
     int layer;
     int level;
@@ -0,0 +1,659 @@
+#include "frameCapture.h"
+#include "memoryTracker.h"
+#include "malloc.h"
+
+namespace GLCommands
+{
+
+bool capturing_ = false;
+
+static struct Capture {
+  ui32* words = nullptr;
+  size_t size = 0;
+  size_t capacity = 0;
+} capture_;
+
+static ui32* append(size_t count) {
+  if (capture_.size + count > capture_.capacity) {
+    size_t capacity = (capture_.capacity ? capture_.capacity * 2 : 65536);
+    while (capacity < capture_.size + count) {
+      capacity *= 2;
+    }
+    capture_.words = (ui32*)_mem::realloc(capture_.words, capacity * sizeof(ui32));
+    capture_.capacity = capacity;
+  }
+  ui32* words = capture_.words + capture_.size;
+  capture_.size += count;
+  return words;
+}
+
+static size_t payloadWords(size_t bytes) {
+  return (bytes + 3) / 4;
+}
+
+// Record with `count` argument words followed by `bytes` of payload; without payload
+// data the caller fills it in after the arguments
+static ui32* beginRecord(ui32 opcode, size_t count, const void* payload, size_t bytes) {
+  size_t size = count + payloadWords(bytes);
+  assert(size < (1 << 24));
+  ui32* words = append(1 + size);
+  words[0] = opcode | (ui32)(size << 8);
+  if (bytes) {
+    words[size] = 0;
+    if (payload) {
+      memcpy(words + 1 + count, payload, bytes);
+    }
+  }
+  return words + 1;
+}
+
+static size_t stringLength(const char* str) {
+  size_t length = 0;
+  while (str[length]) {
+    ++length;
+  }
+  return length;
+}
+
+// Client data read by a pixel upload with the default unpack alignment
+static size_t getUploadSize(GLenum format, GLenum type, size_t width, size_t height, size_t depth) {
+  if (!width || !height || !depth) {
+    return 0;
+  }
+  size_t row = width * WebGL::getPixelSize(format, type);
+  size_t stride = (row + 3) & ~(size_t)3;
+  return stride * (height * depth - 1) + row;
+}
+
+void beginCapture() {
+  flush();
+  capture_.size = 0;
+  ui32* header = append(TRACE_HEADER_SIZE);
+  header[0] = TRACE_MAGIC;
+  header[1] = TRACE_VERSION;
+  capturing_ = true;
+}
+
+const ui32* endCapture(size_t* size) {
+  flush();
+  capturing_ = false;
+  *size = capture_.size;
+  return capture_.words;
+}
+
+bool capturing() {
+  return capturing_;
+}
+
+void saveCapture() {
+  glSaveTrace(capture_.words, capture_.size * sizeof(ui32));
+}
+
+void captureCommands_(const ui32* commands, size_t size) {
+  memcpy(append(size), commands, size * sizeof(ui32));
+}
+
+void captureEndFrame_(ui32 frame) {
+  ui32* args = beginRecord(TRACE_END_FRAME, 1, nullptr, 0);
+  args[0] = frame;
+}
+
+void captureBufferData_(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage) {
+  size_t bytes = (data ? size : 0);
+  ui32* args = beginRecord(TRACE_BUFFER_DATA, 4, data, bytes);
+  args[0] = target;
+  args[1] = size;
+  args[2] = usage;
+  args[3] = bytes;
+}
+
+void captureBufferSubData_(GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_BUFFER_SUB_DATA, 3, data, size);
+  args[0] = target;
+  args[1] = offset;
+  args[2] = size;
+}
+
+void captureCompressedTexImage2D_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                  GLsizei height, GLint border, GLsizei imageSize, const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_IMAGE_2D, 7, data, imageSize);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = border;
+  args[6] = imageSize;
+}
+
+void captureTexImage2D_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                        GLint border, GLenum format, GLenum type, const GLvoid* data) {
+  size_t bytes = (data ? getUploadSize(format, type, width, height, 1) : 0);
+  ui32* args = beginRecord(TRACE_TEX_IMAGE_2D, 9, data, bytes);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = border;
+  args[6] = format;
+  args[7] = type;
+  args[8] = bytes;
+}
+
+void captureTexSubImage2D_(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width,
+                           GLsizei height, GLenum format, GLenum type, const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_TEX_SUB_IMAGE_2D, 8, data, getUploadSize(format, type, width, height, 1));
+  args[0] = target;
+  args[1] = level;
+  args[2] = xoffset;
+  args[3] = yoffset;
+  args[4] = width;
+  args[5] = height;
+  args[6] = format;
+  args[7] = type;
+}
+
+void captureTexSubImage3D_(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset,
+                           GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type,
+                           const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_TEX_SUB_IMAGE_3D, 10, data, getUploadSize(format, type, width, height, depth));
+  args[0] = target;
+  args[1] = level;
+  args[2] = xoffset;
+  args[3] = yoffset;
+  args[4] = zoffset;
+  args[5] = width;
+  args[6] = height;
+  args[7] = depth;
+  args[8] = format;
+  args[9] = type;
+}
+
+void captureShaderSource_(GLptr shader, const GLchar* source) {
+  ui32* args = beginRecord(TRACE_SHADER_SOURCE, 1, source, stringLength(source) + 1);
+  args[0] = handle(shader);
+}
+
+void captureGetUniformLocation_(GLint result, GLptr program, const GLchar* name) {
+  ui32* args = beginRecord(TRACE_GET_UNIFORM_LOCATION, 2, name, stringLength(name) + 1);
+  args[0] = handle(program);
+  args[1] = result;
+}
+
+void captureGetExtension_(GLboolean result, const char* name) {
+  ui32* args = beginRecord(TRACE_GET_EXTENSION, 1, name, stringLength(name) + 1);
+  args[0] = result;
+}
+
+void captureVertexAttrib4fv_(GLuint index, const GLfloat* value) {
+  ui32* args = beginRecord(TRACE_VERTEX_ATTRIB_4FV, 1, value, 4 * sizeof(GLfloat));
+  args[0] = index;
+}
+
+void captureVertexAttrib1fv_(GLuint index, const GLfloat* value) {
+  ui32* args = beginRecord(TRACE_VERTEX_ATTRIB_1FV, 1, value, sizeof(GLfloat));
+  args[0] = index;
+}
+
+void captureVertexAttrib2fv_(GLuint index, const GLfloat* value) {
+  ui32* args = beginRecord(TRACE_VERTEX_ATTRIB_2FV, 1, value, 2 * sizeof(GLfloat));
+  args[0] = index;
+}
+
+void captureVertexAttrib3fv_(GLuint index, const GLfloat* value) {
+  ui32* args = beginRecord(TRACE_VERTEX_ATTRIB_3FV, 1, value, 3 * sizeof(GLfloat));
+  args[0] = index;
+}
+
+void captureVertexAttribI4iv_(GLuint index, const GLint* values) {
+  ui32* args = beginRecord(TRACE_VERTEX_ATTRIB_I4IV, 1, values, 4 * sizeof(GLint));
+  args[0] = index;
+}
+
+void captureVertexAttribI4uiv_(GLuint index, const GLuint* values) {
+  ui32* args = beginRecord(TRACE_VERTEX_ATTRIB_I4UIV, 1, values, 4 * sizeof(GLuint));
+  args[0] = index;
+}
+
+void captureBindAttribLocation_(GLptr program, GLuint index, const GLchar* name) {
+  ui32* args = beginRecord(TRACE_BIND_ATTRIB_LOCATION, 2, name, stringLength(name) + 1);
+  args[0] = handle(program);
+  args[1] = index;
+}
+
+void captureCopyTexImage2D_(GLenum target, GLint level, GLenum internalformat, GLint x, GLint y,
+                            GLsizei width, GLsizei height, GLint border) {
+  ui32* args = beginRecord(TRACE_COPY_TEX_IMAGE_2D, 8, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = x;
+  args[4] = y;
+  args[5] = width;
+  args[6] = height;
+  args[7] = border;
+}
+
+void captureCompressedTexSubImage2D_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                     GLsizei width, GLsizei height, GLenum format, GLsizei imageSize,
+                                     const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_SUB_IMAGE_2D, 8, data, imageSize);
+  args[0] = target;
+  args[1] = level;
+  args[2] = xoffset;
+  args[3] = yoffset;
+  args[4] = width;
+  args[5] = height;
+  args[6] = format;
+  args[7] = imageSize;
+}
+
+void captureTexImage3D_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                        GLsizei depth, GLint border, GLenum format, GLenum type, const GLvoid* data) {
+  size_t bytes = (data ? getUploadSize(format, type, width, height, depth) : 0);
+  ui32* args = beginRecord(TRACE_TEX_IMAGE_3D, 10, data, bytes);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = depth;
+  args[6] = border;
+  args[7] = format;
+  args[8] = type;
+  args[9] = bytes;
+}
+
+void captureCompressedTexImage3D_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                  GLsizei height, GLsizei depth, GLint border, GLsizei imageSize,
+                                  const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_IMAGE_3D, 8, data, imageSize);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = depth;
+  args[6] = border;
+  args[7] = imageSize;
+}
+
+void captureCompressedTexSubImage3D_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                     GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                                     GLenum format, GLsizei imageSize, const GLvoid* data) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_SUB_IMAGE_3D, 10, data, imageSize);
+  args[0] = target;
+  args[1] = level;
+  args[2] = xoffset;
+  args[3] = yoffset;
+  args[4] = zoffset;
+  args[5] = width;
+  args[6] = height;
+  args[7] = depth;
+  args[8] = format;
+  args[9] = imageSize;
+}
+
+void captureCompressedTexImage2DBuffer_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                        GLsizei height, GLint border, GLsizei imageSize, GLintptr offset) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_IMAGE_2D_BUFFER, 8, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = border;
+  args[6] = imageSize;
+  args[7] = offset;
+}
+
+void captureCompressedTexSubImage2DBuffer_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                           GLsizei width, GLsizei height, GLenum format, GLsizei imageSize,
+                                           GLintptr offset) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_SUB_IMAGE_2D_BUFFER, 9, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = xoffset;
+  args[3] = yoffset;
+  args[4] = width;
+  args[5] = height;
+  args[6] = format;
+  args[7] = imageSize;
+  args[8] = offset;
+}
+
+void captureTexImage2DBuffer_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                              GLint border, GLenum format, GLenum type, GLintptr offset) {
+  ui32* args = beginRecord(TRACE_TEX_IMAGE_2D_BUFFER, 9, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = border;
+  args[6] = format;
+  args[7] = type;
+  args[8] = offset;
+}
+
+void captureTexImage3DBuffer_(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height,
+                              GLsizei depth, GLint border, GLenum format, GLenum type, GLintptr offset) {
+  ui32* args = beginRecord(TRACE_TEX_IMAGE_3D_BUFFER, 10, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = depth;
+  args[6] = border;
+  args[7] = format;
+  args[8] = type;
+  args[9] = offset;
+}
+
+void captureCompressedTexImage3DBuffer_(GLenum target, GLint level, GLenum internalformat, GLsizei width,
+                                        GLsizei height, GLsizei depth, GLint border, GLsizei imageSize,
+                                        GLintptr offset) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_IMAGE_3D_BUFFER, 9, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = internalformat;
+  args[3] = width;
+  args[4] = height;
+  args[5] = depth;
+  args[6] = border;
+  args[7] = imageSize;
+  args[8] = offset;
+}
+
+void captureCompressedTexSubImage3DBuffer_(GLenum target, GLint level, GLint xoffset, GLint yoffset,
+                                           GLint zoffset, GLsizei width, GLsizei height, GLsizei depth,
+                                           GLenum format, GLsizei imageSize, GLintptr offset) {
+  ui32* args = beginRecord(TRACE_COMPRESSED_TEX_SUB_IMAGE_3D_BUFFER, 11, nullptr, 0);
+  args[0] = target;
+  args[1] = level;
+  args[2] = xoffset;
+  args[3] = yoffset;
+  args[4] = zoffset;
+  args[5] = width;
+  args[6] = height;
+  args[7] = depth;
+  args[8] = format;
+  args[9] = imageSize;
+  args[10] = offset;
+}
+
+void captureCreateTransformFeedback_(GLptr transformFeedback) {
+  ui32* args = beginRecord(TRACE_CREATE_TRANSFORM_FEEDBACK, 1, nullptr, 0);
+  args[0] = handle(transformFeedback);
+}
+
+void captureDeleteTransformFeedback_(GLptr transformFeedback) {
+  ui32* args = beginRecord(TRACE_DELETE_TRANSFORM_FEEDBACK, 1, nullptr, 0);
+  args[0] = handle(transformFeedback);
+}
+
+void captureBindTransformFeedback_(GLenum target, GLptr transformFeedback) {
+  ui32* args = beginRecord(TRACE_BIND_TRANSFORM_FEEDBACK, 2, nullptr, 0);
+  args[0] = target;
+  args[1] = handle(transformFeedback);
+}
+
+void captureBeginTransformFeedback_(GLenum primitiveMode) {
+  ui32* args = beginRecord(TRACE_BEGIN_TRANSFORM_FEEDBACK, 1, nullptr, 0);
+  args[0] = primitiveMode;
+}
+
+void captureEndTransformFeedback_() {
+  beginRecord(TRACE_END_TRANSFORM_FEEDBACK, 0, nullptr, 0);
+}
+
+void capturePauseTransformFeedback_() {
+  beginRecord(TRACE_PAUSE_TRANSFORM_FEEDBACK, 0, nullptr, 0);
+}
+
+void captureResumeTransformFeedback_() {
+  beginRecord(TRACE_RESUME_TRANSFORM_FEEDBACK, 0, nullptr, 0);
+}
+
+// The names follow the arguments back to back, each with its terminator
+void captureTransformFeedbackVaryings_(GLptr program, GLsizei count, const char** varyings, GLenum bufferMode) {
+  size_t bytes = 0;
+  for (GLsizei i = 0; i < count; ++i) {
+    bytes += stringLength(varyings[i]) + 1;
+  }
+  ui32* args = beginRecord(TRACE_TRANSFORM_FEEDBACK_VARYINGS, 3, nullptr, bytes);
+  args[0] = handle(program);
+  args[1] = count;
+  args[2] = bufferMode;
+  char* out = (char*)(args + 3);
+  for (GLsizei i = 0; i < count; ++i) {
+    size_t length = stringLength(varyings[i]) + 1;
+    memcpy(out, varyings[i], length);
+    out += length;
+  }
+}
+
+TraceReplayer::TraceReplayer(const ui32* trace, size_t size)
+  : trace_(trace)
+{
+  if (size < TRACE_HEADER_SIZE || trace[0] != TRACE_MAGIC || trace[1] != TRACE_VERSION) {
+    return;
+  }
+  size_t capacity = 16;
+  frames_ = (size_t*)_mem::malloc(capacity * sizeof(size_t));
+  frames_[0] = TRACE_HEADER_SIZE;
+  for (size_t pos = TRACE_HEADER_SIZE; pos < size;) {
+    ui32 opcode = trace[pos] & 0xFF;
+    size_t next = pos + 1 + (trace[pos] >> 8);
+    if (next > size) {
+      return;
+    }
+    if (opcode == TRACE_END_FRAME) {
+      if (numFrames_ + 2 > capacity) {
+        capacity *= 2;
+        frames_ = (size_t*)_mem::realloc(frames_, capacity * sizeof(size_t));
+      }
+      frames_[++numFrames_] = next;
+    }
+    pos = next;
+  }
+  valid_ = true;
+}
+
+TraceReplayer::~TraceReplayer() {
+  if (frames_) {
+    _mem::free(frames_);
+  }
+}
+
+void TraceReplayer::playFrame(ui32 frame) {
+  assert(valid_ && frame < numFrames_);
+  play_(trace_ + frames_[frame], trace_ + frames_[frame + 1]);
+}
+
+void TraceReplayer::play() {
+  for (ui32 frame = 0; frame < numFrames_; ++frame) {
+    playFrame(frame);
+  }
+}
+
+// Runs of stream commands go to the decoder in one call, captured calls in between
+// are made directly
+void TraceReplayer::play_(const ui32* begin, const ui32* end) {
+  assert(!capturing_);
+  flush();
+  const ui32* commands = begin;
+  for (const ui32* pos = begin; pos < end;) {
+    ui32 opcode = *pos & 0xFF;
+    size_t size = *pos >> 8;
+    if (opcode >= NUM_COMMANDS) {
+      if (pos > commands) {
+        glExecuteCommands(commands, pos - commands);
+      }
+      playRecord_(opcode, pos + 1, size);
+      commands = pos + 1 + size;
+    }
+    pos += 1 + size;
+  }
+  if (end > commands) {
+    glExecuteCommands(commands, end - commands);
+  }
+}
+
+static inline GLptr object(ui32 handle) {
+  return GLptr::fromHandle(handle);
+}
+
+// Splits the packed names of a varyings record, which ends after `size` words
+static void playVaryings(const ui32* args, size_t size) {
+  GLsizei count = (GLsizei)args[1];
+  const char** varyings = (const char**)_mem::malloc((count ? count : 1) * sizeof(const char*));
+  const char* name = (const char*)(args + 3);
+  const char* end = (const char*)(args + size);
+  for (GLsizei i = 0; i < count; ++i) {
+    if (name >= end) {
+      error("TraceReplayer: truncated varyings");
+    }
+    varyings[i] = name;
+    name += stringLength(name) + 1;
+  }
+  (glTransformFeedbackVaryings)(object(args[0]), count, varyings, args[2]);
+  _mem::free(varyings);
+}
+
+// Calls are parenthesized so they skip the recording macros of commandBuffer.h
+void TraceReplayer::playRecord_(ui32 opcode, const ui32* args, size_t size) {
+  switch (opcode) {
+  case TRACE_END_FRAME:
+    break;
+  case TRACE_BUFFER_DATA:
+    (glBufferData)(args[0], args[1], args[3] ? args + 4 : nullptr, args[2]);
+    break;
+  case TRACE_BUFFER_SUB_DATA:
+    (glBufferSubData)(args[0], args[1], args[2], args + 3);
+    break;
+  case TRACE_COMPRESSED_TEX_IMAGE_2D:
+    (glCompressedTexImage2D)(args[0], (GLint)args[1], args[2], args[3], args[4], (GLint)args[5], args[6], args + 7);
+    break;
+  case TRACE_TEX_IMAGE_2D:
+    (glTexImage2D)(args[0], (GLint)args[1], (GLint)args[2], args[3], args[4], (GLint)args[5], args[6], args[7],
+                   args[8] ? args + 9 : nullptr);
+    break;
+  case TRACE_TEX_SUB_IMAGE_2D:
+    (glTexSubImage2D)(args[0], (GLint)args[1], (GLint)args[2], (GLint)args[3], args[4], args[5], args[6], args[7],
+                      args + 8);
+    break;
+  case TRACE_TEX_SUB_IMAGE_3D:
+    (glTexSubImage3D)(args[0], (GLint)args[1], (GLint)args[2], (GLint)args[3], (GLint)args[4], args[5], args[6],
+                      args[7], args[8], args[9], args + 10);
+    break;
+  case TRACE_SHADER_SOURCE:
+    (glShaderSource)(object(args[0]), (const GLchar*)(args + 1));
+    break;
+  case TRACE_GET_UNIFORM_LOCATION:
+    if ((glGetUniformLocation)(object(args[0]), (const GLchar*)(args + 2)) != (GLint)(i32)args[1]) {
+      mismatches_ += 1;
+    }
+    break;
+  case TRACE_GET_EXTENSION:
+    if ((glGetExtension)((const char*)(args + 1)) != (args[0] != 0)) {
+      mismatches_ += 1;
+    }
+    break;
+  case TRACE_VERTEX_ATTRIB_4FV:
+    (glVertexAttrib4fv)(args[0], (const GLfloat*)(args + 1));
+    break;
+  case TRACE_VERTEX_ATTRIB_1FV:
+    (glVertexAttrib1fv)(args[0], (const GLfloat*)(args + 1));
+    break;
+  case TRACE_VERTEX_ATTRIB_2FV:
+    (glVertexAttrib2fv)(args[0], (const GLfloat*)(args + 1));
+    break;
+  case TRACE_VERTEX_ATTRIB_3FV:
+    (glVertexAttrib3fv)(args[0], (const GLfloat*)(args + 1));
+    break;
+  case TRACE_VERTEX_ATTRIB_I4IV:
+    (glVertexAttribI4iv)(args[0], (const GLint*)(args + 1));
+    break;
+  case TRACE_VERTEX_ATTRIB_I4UIV:
+    (glVertexAttribI4uiv)(args[0], (const GLuint*)(args + 1));
+    break;
+  case TRACE_BIND_ATTRIB_LOCATION:
+    (glBindAttribLocation)(object(args[0]), args[1], (const GLchar*)(args + 2));
+    break;
+  case TRACE_COPY_TEX_IMAGE_2D:
+    (glCopyTexImage2D)(args[0], (GLint)args[1], args[2], (GLint)args[3], (GLint)args[4], args[5], args[6],
+                       (GLint)args[7]);
+    break;
+  case TRACE_COMPRESSED_TEX_SUB_IMAGE_2D:
+    (glCompressedTexSubImage2D)(args[0], (GLint)args[1], (GLint)args[2], (GLint)args[3], args[4], args[5], args[6],
+                                args[7], args + 8);
+    break;
+  case TRACE_TEX_IMAGE_3D:
+    (glTexImage3D)(args[0], (GLint)args[1], (GLint)args[2], args[3], args[4], args[5], (GLint)args[6], args[7],
+                   args[8], args[9] ? args + 10 : nullptr);
+    break;
+  case TRACE_COMPRESSED_TEX_IMAGE_3D:
+    (glCompressedTexImage3D)(args[0], (GLint)args[1], args[2], args[3], args[4], args[5], (GLint)args[6], args[7],
+                             args + 8);
+    break;
+  case TRACE_COMPRESSED_TEX_SUB_IMAGE_3D:
+    (glCompressedTexSubImage3D)(args[0], (GLint)args[1], (GLint)args[2], (GLint)args[3], (GLint)args[4], args[5],
+                                args[6], args[7], args[8], args[9], args + 10);
+    break;
+  case TRACE_COMPRESSED_TEX_IMAGE_2D_BUFFER:
+    (glCompressedTexImage2DBuffer)(args[0], (GLint)args[1], args[2], args[3], args[4], (GLint)args[5], args[6],
+                                   args[7]);
+    break;
+  case TRACE_COMPRESSED_TEX_SUB_IMAGE_2D_BUFFER:
+    (glCompressedTexSubImage2DBuffer)(args[0], (GLint)args[1], (GLint)args[2], (GLint)args[3], args[4], args[5],
+                                      args[6], args[7], args[8]);
+    break;
+  case TRACE_TEX_IMAGE_2D_BUFFER:
+    (glTexImage2DBuffer)(args[0], (GLint)args[1], (GLint)args[2], args[3], args[4], (GLint)args[5], args[6],
+                         args[7], args[8]);
+    break;
+  case TRACE_TEX_IMAGE_3D_BUFFER:
+    (glTexImage3DBuffer)(args[0], (GLint)args[1], (GLint)args[2], args[3], args[4], args[5], (GLint)args[6],
+                         args[7], args[8], args[9]);
+    break;
+  case TRACE_COMPRESSED_TEX_IMAGE_3D_BUFFER:
+    (glCompressedTexImage3DBuffer)(args[0], (GLint)args[1], args[2], args[3], args[4], args[5], (GLint)args[6],
+                                   args[7], args[8]);
+    break;
+  case TRACE_COMPRESSED_TEX_SUB_IMAGE_3D_BUFFER:
+    (glCompressedTexSubImage3DBuffer)(args[0], (GLint)args[1], (GLint)args[2], (GLint)args[3], (GLint)args[4],
+                                      args[5], args[6], args[7], args[8], args[9], args[10]);
+    break;
+  case TRACE_CREATE_TRANSFORM_FEEDBACK:
+    (glCreateTransformFeedback)(object(args[0]));
+    break;
+  case TRACE_DELETE_TRANSFORM_FEEDBACK:
+    (glDeleteTransformFeedback)(object(args[0]));
+    break;
+  case TRACE_BIND_TRANSFORM_FEEDBACK:
+    (glBindTransformFeedback)(args[0], object(args[1]));
+    break;
+  case TRACE_BEGIN_TRANSFORM_FEEDBACK:
+    (glBeginTransformFeedback)(args[0]);
+    break;
+  case TRACE_END_TRANSFORM_FEEDBACK:
+    (glEndTransformFeedback)();
+    break;
+  case TRACE_PAUSE_TRANSFORM_FEEDBACK:
+    (glPauseTransformFeedback)();
+    break;
+  case TRACE_RESUME_TRANSFORM_FEEDBACK:
+    (glResumeTransformFeedback)();
+    break;
+  case TRACE_TRANSFORM_FEEDBACK_VARYINGS:
+    playVaryings(args, size);
+    break;
+  default:
+    error("TraceReplayer: unknown record");
+  }
+}
+
+}
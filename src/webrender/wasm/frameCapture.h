@@ -0,0 +1,120 @@
+#pragma once
+#include "glbindings.h"
+
+#ifndef GL_COMMAND_BUFFER
+#error frame capture requires GL_COMMAND_BUFFER
+#endif
+
+namespace GLCommands
+{
+
+// Frame capture for command buffer builds. While a capture runs, every flushed
+// command stream is appended to the trace verbatim, along with the sync calls that
+// change GL state (uploads with their data, shader sources, attribute locations and
+// constant values, uniform locations, extensions, transform feedback) and a marker
+// at the end of every frame.
+//
+// A trace is TRACE_MAGIC, TRACE_VERSION and a sequence of records in the command
+// stream format: a header word (opcode | argument words << 8) and its arguments.
+// Opcodes below NUM_COMMANDS are stream commands; the TRACE_* opcodes are captured
+// calls, with payloads packed into words and zero padded. Pixel payloads assume
+// the default unpack alignment of 4. Uploads from a pixel unpack buffer (the
+// gl*Image*Buffer calls) record only their offset; the buffer contents are in the
+// trace through its own uploads.
+//
+// Object handles are recorded as they are, so traces replay into a fresh context
+// and are only complete if the capture started before the objects it uses were
+// created.
+enum {
+  TRACE_MAGIC = 0x52544C47, // "GLTR"
+  TRACE_VERSION = 1,
+  TRACE_HEADER_SIZE = 2,
+
+  TRACE_END_FRAME = 200,         // frame
+  TRACE_BUFFER_DATA,             // target, size, usage, bytes, payload (bytes is 0 for no data)
+  TRACE_BUFFER_SUB_DATA,         // target, offset, size, payload
+  TRACE_COMPRESSED_TEX_IMAGE_2D, // target, level, internalformat, width, height, border, imageSize, payload
+  TRACE_TEX_IMAGE_2D,            // target, level, internalformat, width, height, border, format, type, bytes, payload
+  TRACE_TEX_SUB_IMAGE_2D,        // target, level, x, y, width, height, format, type, payload
+  TRACE_TEX_SUB_IMAGE_3D,        // target, level, x, y, z, width, height, depth, format, type, payload
+  TRACE_SHADER_SOURCE,           // shader, string
+  TRACE_GET_UNIFORM_LOCATION,    // program, location, string
+  TRACE_GET_EXTENSION,           // result, string
+  TRACE_VERTEX_ATTRIB_4FV,       // index, x, y, z, w
+  TRACE_VERTEX_ATTRIB_1FV,       // index, x
+  TRACE_VERTEX_ATTRIB_2FV,       // index, x, y
+  TRACE_VERTEX_ATTRIB_3FV,       // index, x, y, z
+  TRACE_VERTEX_ATTRIB_I4IV,      // index, x, y, z, w
+  TRACE_VERTEX_ATTRIB_I4UIV,     // index, x, y, z, w
+  TRACE_BIND_ATTRIB_LOCATION,    // program, index, string
+  TRACE_COPY_TEX_IMAGE_2D,       // target, level, internalformat, x, y, width, height, border
+  TRACE_COMPRESSED_TEX_SUB_IMAGE_2D, // target, level, x, y, width, height, format, imageSize, payload
+  TRACE_TEX_IMAGE_3D,            // target, level, internalformat, width, height, depth, border, format, type, bytes, payload
+  TRACE_COMPRESSED_TEX_IMAGE_3D, // target, level, internalformat, width, height, depth, border, imageSize, payload
+  TRACE_COMPRESSED_TEX_SUB_IMAGE_3D, // target, level, x, y, z, width, height, depth, format, imageSize, payload
+  TRACE_COMPRESSED_TEX_IMAGE_2D_BUFFER,     // target, level, internalformat, width, height, border, imageSize, offset
+  TRACE_COMPRESSED_TEX_SUB_IMAGE_2D_BUFFER, // target, level, x, y, width, height, format, imageSize, offset
+  TRACE_TEX_IMAGE_2D_BUFFER,     // target, level, internalformat, width, height, border, format, type, offset
+  TRACE_TEX_IMAGE_3D_BUFFER,     // target, level, internalformat, width, height, depth, border, format, type, offset
+  TRACE_COMPRESSED_TEX_IMAGE_3D_BUFFER,     // target, level, internalformat, width, height, depth, border, imageSize, offset
+  TRACE_COMPRESSED_TEX_SUB_IMAGE_3D_BUFFER, // target, level, x, y, z, width, height, depth, format, imageSize, offset
+  TRACE_CREATE_TRANSFORM_FEEDBACK, // transformFeedback
+  TRACE_DELETE_TRANSFORM_FEEDBACK, // transformFeedback
+  TRACE_BIND_TRANSFORM_FEEDBACK,   // target, transformFeedback
+  TRACE_BEGIN_TRANSFORM_FEEDBACK,  // primitiveMode
+  TRACE_END_TRANSFORM_FEEDBACK,
+  TRACE_PAUSE_TRANSFORM_FEEDBACK,
+  TRACE_RESUME_TRANSFORM_FEEDBACK,
+  TRACE_TRANSFORM_FEEDBACK_VARYINGS, // program, count, bufferMode, strings
+};
+
+// Starts recording; the previous trace is discarded
+void beginCapture();
+// Stops recording and returns the trace, valid until the next beginCapture()
+const ui32* endCapture(size_t* size);
+bool capturing();
+// Hands the last trace to JS (glSaveTrace)
+void saveCapture();
+
+// Plays a trace through glExecuteCommands and the captured calls, against whatever
+// backend the build links: the JS decoder in the browser, the stubs natively.
+// Frames are the records up to each end of frame marker; a frame can be replayed any
+// number of times once the frames before it have run.
+class TraceReplayer {
+public:
+  TraceReplayer(const ui32* trace, size_t size);
+  ~TraceReplayer();
+
+  TraceReplayer(const TraceReplayer&) = delete;
+  TraceReplayer& operator=(const TraceReplayer&) = delete;
+
+  // False if the header doesn't match or a record runs past the end
+  bool valid() const {
+    return valid_;
+  }
+  ui32 numFrames() const {
+    return numFrames_;
+  }
+
+  void playFrame(ui32 frame);
+  void play();
+
+  // Captured results that came out differently on replay, e.g. uniform locations of
+  // programs created before the capture started
+  ui32 mismatches() const {
+    return mismatches_;
+  }
+
+private:
+  const ui32* trace_;
+  // Word offsets of the first record of every frame, and of the end of the trace
+  size_t* frames_ = nullptr;
+  ui32 numFrames_ = 0;
+  bool valid_ = false;
+  ui32 mismatches_ = 0;
+
+  void play_(const ui32* begin, const ui32* end);
+  void playRecord_(ui32 opcode, const ui32* args, size_t size);
+};
+
+}
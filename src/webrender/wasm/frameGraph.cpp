@@ -0,0 +1,216 @@
+#include "frameGraph.h"
+#include "renderTargetPool.h"
+#include "frameBuffer.h"
+#include "texture.h"
+#include "renderBuffer.h"
+
+namespace WebGL
+{
+
+ui32 FrameGraph::addResource_(const char* name, GLenum format, size_t width, size_t height, ui32 samples) {
+  assert(numResources_ < MAX_RESOURCES);
+  Resource& resource = resources_[numResources_];
+  resource.name = name;
+  resource.format = format;
+  resource.width = (ui32)width;
+  resource.height = (ui32)height;
+  resource.samples = samples;
+  resource.imported = false;
+  resource.object = nullptr;
+  return numResources_++;
+}
+
+ui32 FrameGraph::createTexture(const char* name, GLenum format, size_t width, size_t height) {
+  return addResource_(name, format, width, height, 0);
+}
+
+ui32 FrameGraph::createRenderBuffer(const char* name, GLenum format, size_t width, size_t height, size_t samples) {
+  return addResource_(name, format, width, height, samples ? (ui32)samples : 1);
+}
+
+ui32 FrameGraph::importTexture(const char* name, Texture* texture) {
+  ui32 index = addResource_(name, 0, 0, 0, 0);
+  resources_[index].imported = true;
+  resources_[index].object = texture;
+  return index;
+}
+
+ui32 FrameGraph::addPass(const char* name, Execute execute, void* context) {
+  assert(numPasses_ < MAX_PASSES);
+  Pass& pass = passes_[numPasses_];
+  pass.name = name;
+  pass.execute = execute;
+  pass.context = context;
+  pass.numReads = 0;
+  pass.numWrites = 0;
+  pass.backBuffer = false;
+  pass.sideEffect = false;
+  pass.live = false;
+  pass.frameBuffer = nullptr;
+  return numPasses_++;
+}
+
+void FrameGraph::read(ui32 index, ui32 resource) {
+  Pass& pass = passes_[index];
+  assert(pass.numReads < MAX_READS && resources_[resource].samples == 0);
+  pass.reads[pass.numReads++] = resource;
+}
+
+void FrameGraph::write(ui32 index, ui32 resource, GLenum attachment) {
+  Pass& pass = passes_[index];
+  assert(pass.numWrites < MAX_WRITES && !resources_[resource].imported && !pass.backBuffer);
+  pass.writes[pass.numWrites] = resource;
+  pass.attachments[pass.numWrites] = attachment;
+  pass.numWrites += 1;
+}
+
+void FrameGraph::writeBackBuffer(ui32 index) {
+  assert(!passes_[index].numWrites);
+  passes_[index].backBuffer = true;
+}
+
+void FrameGraph::setSideEffect(ui32 index) {
+  passes_[index].sideEffect = true;
+}
+
+Texture* FrameGraph::texture(ui32 resource) const {
+  assert(resources_[resource].samples == 0);
+  return (Texture*)resources_[resource].object;
+}
+
+RenderBuffer* FrameGraph::renderBuffer(ui32 resource) const {
+  assert(resources_[resource].samples != 0);
+  return (RenderBuffer*)resources_[resource].object;
+}
+
+// Walks the passes backwards: a pass survives if it is a root or writes something a
+// surviving later pass reads, and then everything it reads is needed
+void FrameGraph::cull_() {
+  bool needed[MAX_RESOURCES];
+  memset(needed, 0, sizeof needed);
+  for (ui32 i = numPasses_; i-- > 0;) {
+    Pass& pass = passes_[i];
+    pass.live = pass.backBuffer || pass.sideEffect;
+    for (ui32 j = 0; j < pass.numWrites && !pass.live; ++j) {
+      pass.live = needed[pass.writes[j]];
+    }
+    if (pass.live) {
+      for (ui32 j = 0; j < pass.numReads; ++j) {
+        needed[pass.reads[j]] = true;
+      }
+    } else {
+      stats_.culled += 1;
+    }
+  }
+}
+
+void FrameGraph::computeLifetimes_() {
+  for (ui32 i = 0; i < numResources_; ++i) {
+    resources_[i].firstUse = INVALID_INDEX;
+    resources_[i].lastUse = INVALID_INDEX;
+    resources_[i].lastWriter = INVALID_INDEX;
+  }
+  for (ui32 i = 0; i < numPasses_; ++i) {
+    Pass& pass = passes_[i];
+    if (!pass.live) {
+      continue;
+    }
+    for (ui32 j = 0; j < pass.numReads; ++j) {
+      Resource& resource = resources_[pass.reads[j]];
+      if (resource.firstUse == INVALID_INDEX) {
+        resource.firstUse = i;
+      }
+      resource.lastUse = i;
+    }
+    for (ui32 j = 0; j < pass.numWrites; ++j) {
+      Resource& resource = resources_[pass.writes[j]];
+      if (resource.firstUse == INVALID_INDEX) {
+        resource.firstUse = i;
+      }
+      resource.lastUse = i;
+      resource.lastWriter = i;
+      resource.lastAttachment = pass.attachments[j];
+    }
+  }
+}
+
+// Invalidates the transient resources whose last use was this pass. Attachments of the
+// pass itself are invalidated while its frame buffer is still bound; inputs are
+// invalidated in the frame buffer that last wrote them.
+void FrameGraph::invalidate_(ui32 index) {
+  Pass& pass = passes_[index];
+  GLenum attachments[MAX_WRITES];
+  ui32 count = 0;
+  for (ui32 i = 0; i < pass.numWrites; ++i) {
+    if (resources_[pass.writes[i]].lastUse == index) {
+      attachments[count++] = pass.attachments[i];
+    }
+  }
+  if (count) {
+    pass.frameBuffer->invalidate(attachments, count);
+    stats_.invalidated += count;
+  }
+  for (ui32 i = 0; i < pass.numReads; ++i) {
+    const Resource& resource = resources_[pass.reads[i]];
+    if (resource.imported || resource.lastUse != index || resource.lastWriter == INVALID_INDEX ||
+        resource.lastWriter == index) {
+      continue;
+    }
+    passes_[resource.lastWriter].frameBuffer->invalidate(&resource.lastAttachment, 1);
+    stats_.invalidated += 1;
+  }
+}
+
+void FrameGraph::execute() {
+  stats_ = Stats();
+  stats_.passes = numPasses_;
+  cull_();
+  computeLifetimes_();
+  bool invalidate = (version() >= 2);
+
+  for (ui32 i = 0; i < numPasses_; ++i) {
+    Pass& pass = passes_[i];
+    if (!pass.live) {
+      continue;
+    }
+    for (ui32 j = 0; j < numResources_; ++j) {
+      Resource& resource = resources_[j];
+      if (resource.firstUse != i || resource.imported) {
+        continue;
+      }
+      if (resource.samples) {
+        resource.object = pool_.acquireRenderBuffer(resource.format, resource.width, resource.height, resource.samples);
+      } else {
+        resource.object = pool_.acquireTexture(resource.format, resource.width, resource.height);
+      }
+      stats_.targets += 1;
+    }
+
+    if (pass.numWrites) {
+      GLBase* targets[MAX_WRITES];
+      for (ui32 j = 0; j < pass.numWrites; ++j) {
+        targets[j] = resources_[pass.writes[j]].object;
+      }
+      pass.frameBuffer = pool_.frameBuffer(pass.attachments, targets, pass.numWrites);
+      bindFrameBuffer(GL_FRAMEBUFFER, pass.frameBuffer);
+    } else if (pass.backBuffer) {
+      bindFrameBuffer(GL_FRAMEBUFFER, nullptr);
+    }
+    pass.execute(*this, pass.context);
+
+    if (invalidate) {
+      invalidate_(i);
+    }
+    for (ui32 j = 0; j < numResources_; ++j) {
+      Resource& resource = resources_[j];
+      if (resource.lastUse == i && !resource.imported) {
+        pool_.recycle(resource.object);
+      }
+    }
+  }
+
+  numPasses_ = 0;
+  numResources_ = 0;
+}
+
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+class RenderTargetPool;
+
+// Per-frame graph of render passes. Passes are added in execution order and declare
+// the resources they read (as textures) and write (as frame buffer attachments);
+// execute() then
+//  - culls passes whose outputs nothing reads, unless they write the back buffer or
+//    have side effects,
+//  - acquires transient targets from the pool right before their first use and
+//    recycles them right after their last, so targets with the same descriptor and
+//    disjoint lifetimes share memory,
+//  - invalidates transient attachments after their last use (WebGL2), so tiled GPUs
+//    don't write them back to memory.
+//
+// Pass callbacks run with the pass's frame buffer bound and fetch their inputs with
+// texture(). Names are stored by pointer and must stay valid (string literals).
+class FrameGraph {
+public:
+  enum {
+    MAX_PASSES = 32,
+    MAX_RESOURCES = 64,
+    MAX_READS = 8,
+    MAX_WRITES = 6,
+    INVALID_INDEX = 0xFFFFFFFFU,
+  };
+
+  typedef void (*Execute)(FrameGraph& graph, void* context);
+
+  struct Stats {
+    ui32 passes = 0;
+    ui32 culled = 0;
+    ui32 targets = 0;
+    ui32 invalidated = 0;
+  };
+
+  FrameGraph(RenderTargetPool& pool)
+    : pool_(pool)
+  {
+  }
+
+  FrameGraph(const FrameGraph&) = delete;
+  FrameGraph& operator=(const FrameGraph&) = delete;
+
+  // Transient targets, allocated only if a pass that uses them survives culling.
+  // Texture targets can be read by later passes; render buffer targets can only be
+  // written.
+  ui32 createTexture(const char* name, GLenum format, size_t width, size_t height);
+  ui32 createRenderBuffer(const char* name, GLenum format, size_t width, size_t height, size_t samples = 1);
+  // Texture owned elsewhere, e.g. last frame's history; can only be read
+  ui32 importTexture(const char* name, Texture* texture);
+
+  ui32 addPass(const char* name, Execute execute, void* context = nullptr);
+  void read(ui32 pass, ui32 resource);
+  void write(ui32 pass, ui32 resource, GLenum attachment);
+  // Renders to the canvas; such passes are never culled
+  void writeBackBuffer(ui32 pass);
+  // Keeps a pass that has effects outside the graph, such as readbacks
+  void setSideEffect(ui32 pass);
+
+  // Runs the surviving passes in order and clears the graph for the next frame
+  void execute();
+
+  // During execution: the object behind a resource, nullptr if it isn't allocated
+  Texture* texture(ui32 resource) const;
+  RenderBuffer* renderBuffer(ui32 resource) const;
+
+  const char* passName(ui32 pass) const {
+    return passes_[pass].name;
+  }
+  // Of the last execute()
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  struct Resource {
+    const char* name;
+    GLenum format;
+    ui32 width;
+    ui32 height;
+    // 0 for textures
+    ui32 samples;
+    bool imported;
+    GLBase* object;
+    ui32 firstUse;
+    ui32 lastUse;
+    // Pass and attachment of the last write, for invalidation
+    ui32 lastWriter;
+    GLenum lastAttachment;
+  };
+  struct Pass {
+    const char* name;
+    Execute execute;
+    void* context;
+    ui32 reads[MAX_READS];
+    ui32 numReads;
+    ui32 writes[MAX_WRITES];
+    GLenum attachments[MAX_WRITES];
+    ui32 numWrites;
+    bool backBuffer;
+    bool sideEffect;
+    bool live;
+    FrameBuffer* frameBuffer;
+  };
+
+  RenderTargetPool& pool_;
+  Resource resources_[MAX_RESOURCES];
+  ui32 numResources_ = 0;
+  Pass passes_[MAX_PASSES];
+  ui32 numPasses_ = 0;
+  Stats stats_;
+
+  ui32 addResource_(const char* name, GLenum format, size_t width, size_t height, ui32 samples);
+  void cull_();
+  void computeLifetimes_();
+  void invalidate_(ui32 pass);
+};
+
+}
@@ -0,0 +1,36 @@
+#include "frameStats.h"
+
+#ifdef GL_FRAME_STATS
+
+namespace WebGL
+{
+
+FrameStatsBuffer frameStats_;
+
+ui32 countTriangles_(GLenum mode, size_t count, size_t instances) {
+  size_t triangles;
+  switch (mode) {
+  case GL_TRIANGLES:
+    triangles = count / 3;
+    break;
+  case GL_TRIANGLE_STRIP:
+  case GL_TRIANGLE_FAN:
+    triangles = (count > 2 ? count - 2 : 0);
+    break;
+  default:
+    triangles = 0;
+    break;
+  }
+  return (ui32)(triangles * instances);
+}
+
+void swapFrameStats_(ui32 nextFrame) {
+  frameStats_.front ^= 1;
+  FrameStats& stats = currentFrameStats_();
+  memset(&stats, 0, sizeof stats);
+  stats.frame = nextFrame;
+}
+
+}
+
+#endif
@@ -0,0 +1,66 @@
+#pragma once
+#include "webgl.h"
+
+// Per-frame counters of the binding layer. They are on in debug builds; release
+// builds compile them out unless GL_FRAME_STATS is defined.
+#if !defined(NDEBUG) && !defined(GL_FRAME_STATS)
+#define GL_FRAME_STATS
+#endif
+
+namespace WebGL
+{
+
+// Plain 32-bit fields only: JS reads the struct straight from linear memory
+// (see FrameStatsBuffer), so the layout must match renderer.js
+struct FrameStats {
+  ui32 frame;
+  ui32 draws;
+  ui32 triangles;
+  ui32 programSwitches;
+  ui32 vertexArrayBinds;
+  ui32 textureBinds;
+  // Bind calls skipped because the object was already bound
+  ui32 redundantBinds;
+  // Bytes passed from client memory to glBufferData/glBufferSubData
+  ui32 bufferBytes;
+  // Bytes passed from client memory to texture image calls
+  ui32 textureBytes;
+  ui32 frameBufferSwitches;
+};
+
+// frames[front] holds the last completed frame and stays unchanged until the next
+// endFrame(); the other one is being counted. The address is handed to JS once with
+// glFrameStats.
+struct FrameStatsBuffer {
+  ui32 front;
+  FrameStats frames[2];
+};
+
+#ifdef GL_FRAME_STATS
+
+extern FrameStatsBuffer frameStats_;
+
+inline FrameStats& currentFrameStats_() {
+  return frameStats_.frames[frameStats_.front ^ 1];
+}
+// Stats for the last completed frame
+inline const FrameStats& getFrameStats() {
+  return frameStats_.frames[frameStats_.front];
+}
+
+ui32 countTriangles_(GLenum mode, size_t count, size_t instances);
+// Called by endFrame
+void swapFrameStats_(ui32 nextFrame);
+
+#define FRAME_STAT(field, value) (WebGL::currentFrameStats_().field += (ui32)(value))
+#define FRAME_DRAW(mode, count, instances) \
+  (FRAME_STAT(draws, 1), FRAME_STAT(triangles, WebGL::countTriangles_(mode, count, instances)))
+
+#else
+
+#define FRAME_STAT(field, value) ((void)0)
+#define FRAME_DRAW(mode, count, instances) ((void)0)
+
+#endif
+
+}
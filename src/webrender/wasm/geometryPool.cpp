@@ -0,0 +1,251 @@
+#include "geometryPool.h"
+#include "buffer.h"
+#include "vertexArray.h"
+#include "drawQueue.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+GeometryPool::GeometryPool(size_t arenaSize)
+  : arenaSize_(arenaSize)
+{
+}
+
+GeometryPool::~GeometryPool() {
+  for (ui32 i = 0; i < numMeshes_; ++i) {
+    if (meshes_[i].indices) {
+      _mem::free(meshes_[i].indices);
+    }
+  }
+  if (meshes_) {
+    _mem::free(meshes_);
+  }
+  for (ui32 i = 0; i < numArenas_; ++i) {
+    arenas_[i].vertexArray->release();
+    arenas_[i].vertices->release();
+    arenas_[i].indices->release();
+  }
+}
+
+ui32 GeometryPool::format(const VertexLayout& layout) {
+  for (ui32 i = 0; i < numFormats_; ++i) {
+    if (formats_[i] == layout) {
+      return i;
+    }
+  }
+  if (numFormats_ == MAX_FORMATS) {
+    return INVALID_FORMAT;
+  }
+  formats_[numFormats_] = layout;
+  return numFormats_++;
+}
+
+// Index uploads go through GL_ELEMENT_ARRAY_BUFFER, which belongs to the bound
+// VertexArray, so the arena's own vertex array is bound first
+void GeometryPool::bindArena_(Arena& arena) {
+  bindVertexArray(arena.vertexArray);
+  const VertexLayout& layout = formats_[arena.format];
+  for (ui32 i = 0; i < layout.numAttributes; ++i) {
+    const VertexLayout::Attribute& attribute = layout.attributes[i];
+    arena.vertexArray->setAttribute(attribute.index, arena.vertices, attribute.size, attribute.type,
+                                    attribute.normalized != 0, layout.stride, attribute.offset);
+  }
+  arena.vertexArray->setIndices(arena.indices);
+}
+
+ui32 GeometryPool::createArena_(ui32 format, ui32 vertexCount, ui32 indexCount) {
+  if (numArenas_ == MAX_ARENAS) {
+    return MAX_ARENAS;
+  }
+  ui32 stride = formats_[format].stride;
+  ui32 vertexCapacity = (ui32)(arenaSize_ / stride);
+  ui32 indexCapacity = (ui32)(arenaSize_ / 2 / sizeof(ui32));
+  if (vertexCapacity < vertexCount) {
+    vertexCapacity = vertexCount;
+  }
+  if (indexCapacity < indexCount) {
+    indexCapacity = indexCount;
+  }
+  Arena& arena = arenas_[numArenas_];
+  arena.format = format;
+  arena.vertexArray = VertexArray::create();
+  bindVertexArray(arena.vertexArray);
+  arena.vertices = Buffer::create(vertexCapacity * stride, nullptr, GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+  arena.indices = Buffer::create(indexCapacity * sizeof(ui32), nullptr, GL_STATIC_DRAW, GL_ELEMENT_ARRAY_BUFFER);
+  bindArena_(arena);
+  arena.vertexRanges.reset(vertexCapacity);
+  arena.indexRanges.reset(indexCapacity);
+  return numArenas_++;
+}
+
+void GeometryPool::uploadIndices_(Arena& arena, Buffer* buffer, const Mesh& mesh) {
+  size_t size = mesh.indexCount * sizeof(ui32);
+  // Not sbrk scratch: the upload may allocate, e.g. for frame capture
+  ui32* rebased = (ui32*)_mem::malloc(size);
+  for (ui32 i = 0; i < mesh.indexCount; ++i) {
+    rebased[i] = mesh.indices[i] + mesh.vertexOffset;
+  }
+  bindVertexArray(arena.vertexArray);
+  buffer->setData(mesh.indexOffset * sizeof(ui32), size, rebased);
+  _mem::free(rebased);
+}
+
+ui32 GeometryPool::allocate(ui32 format, const void* vertices, ui32 vertexCount, const ui32* indices, ui32 indexCount) {
+  assert(vertexCount && indexCount);
+  ui32 index = MAX_ARENAS;
+  ui32 vertexOffset = RangeAllocator::INVALID_OFFSET;
+  ui32 indexOffset = RangeAllocator::INVALID_OFFSET;
+  for (ui32 i = 0; i < numArenas_ && index == MAX_ARENAS; ++i) {
+    Arena& arena = arenas_[i];
+    if (arena.format != format) {
+      continue;
+    }
+    vertexOffset = arena.vertexRanges.allocate(vertexCount);
+    if (vertexOffset == RangeAllocator::INVALID_OFFSET) {
+      continue;
+    }
+    indexOffset = arena.indexRanges.allocate(indexCount);
+    if (indexOffset == RangeAllocator::INVALID_OFFSET) {
+      arena.vertexRanges.free(vertexOffset, vertexCount);
+      continue;
+    }
+    index = i;
+  }
+  if (index == MAX_ARENAS) {
+    index = createArena_(format, vertexCount, indexCount);
+    if (index == MAX_ARENAS) {
+      return INVALID_MESH;
+    }
+    vertexOffset = arenas_[index].vertexRanges.allocate(vertexCount);
+    indexOffset = arenas_[index].indexRanges.allocate(indexCount);
+  }
+
+  ui32 id = freeMesh_;
+  if (id != INVALID_MESH) {
+    freeMesh_ = meshes_[id].nextFree;
+  } else {
+    if (numMeshes_ == maxMeshes_) {
+      maxMeshes_ = (maxMeshes_ ? maxMeshes_ * 2 : 64);
+      meshes_ = (Mesh*)_mem::realloc(meshes_, maxMeshes_ * sizeof(Mesh));
+    }
+    id = numMeshes_++;
+  }
+  Mesh& mesh = meshes_[id];
+  mesh.arena = index;
+  mesh.vertexOffset = vertexOffset;
+  mesh.vertexCount = vertexCount;
+  mesh.indexOffset = indexOffset;
+  mesh.indexCount = indexCount;
+  mesh.indices = (ui32*)_mem::malloc(indexCount * sizeof(ui32));
+  memcpy(mesh.indices, indices, indexCount * sizeof(ui32));
+
+  Arena& arena = arenas_[index];
+  ui32 stride = formats_[format].stride;
+  arena.vertices->setData(vertexOffset * stride, vertexCount * stride, vertices);
+  uploadIndices_(arena, arena.indices, mesh);
+  return id;
+}
+
+void GeometryPool::free(ui32 id) {
+  Mesh& mesh = meshes_[id];
+  assert(mesh.indices);
+  Arena& arena = arenas_[mesh.arena];
+  arena.vertexRanges.free(mesh.vertexOffset, mesh.vertexCount);
+  arena.indexRanges.free(mesh.indexOffset, mesh.indexCount);
+  _mem::free(mesh.indices);
+  mesh.indices = nullptr;
+  mesh.nextFree = freeMesh_;
+  freeMesh_ = id;
+}
+
+void GeometryPool::setDraw(ui32 id, DrawItem& item) const {
+  const Mesh& mesh = meshes_[id];
+  item.vertexArray = arenas_[mesh.arena].vertexArray;
+  item.indexType = GL_UNSIGNED_INT;
+  item.first = mesh.indexOffset;
+  item.count = mesh.indexCount;
+}
+
+ui32 GeometryPool::compact() {
+  // glCopyBufferSubData is WebGL2 only
+  if (version() < 2) {
+    return 0;
+  }
+  ui32 count = 0;
+  for (ui32 i = 0; i < numArenas_; ++i) {
+    Arena& arena = arenas_[i];
+    if (!arena.vertexRanges.packed() || !arena.indexRanges.packed()) {
+      compact_(i);
+      ++count;
+    }
+  }
+  return count;
+}
+
+// Ranges can't be slid down in place because copies within one buffer must not
+// overlap, so live meshes are copied into new buffers of the same size
+void GeometryPool::compact_(ui32 index) {
+  Arena& arena = arenas_[index];
+  ui32 stride = formats_[arena.format].stride;
+  Buffer* vertices = Buffer::create(arena.vertices->size(), nullptr, GL_STATIC_DRAW, GL_ARRAY_BUFFER);
+  bindVertexArray(arena.vertexArray);
+  Buffer* indices = Buffer::create(arena.indices->size(), nullptr, GL_STATIC_DRAW, GL_ELEMENT_ARRAY_BUFFER);
+
+  ui32 vertexOffset = 0;
+  ui32 indexOffset = 0;
+  for (ui32 i = 0; i < numMeshes_; ++i) {
+    Mesh& mesh = meshes_[i];
+    if (!mesh.indices || mesh.arena != index) {
+      continue;
+    }
+    vertices->copyData(arena.vertices, mesh.vertexOffset * stride, vertexOffset * stride, mesh.vertexCount * stride);
+    bool rebase = (mesh.vertexOffset != vertexOffset);
+    if (!rebase) {
+      indices->copyData(arena.indices, mesh.indexOffset * sizeof(ui32), indexOffset * sizeof(ui32), mesh.indexCount * sizeof(ui32));
+    }
+    mesh.vertexOffset = vertexOffset;
+    mesh.indexOffset = indexOffset;
+    vertexOffset += mesh.vertexCount;
+    indexOffset += mesh.indexCount;
+    if (rebase) {
+      uploadIndices_(arena, indices, mesh);
+    }
+  }
+
+  arena.vertices->release();
+  arena.indices->release();
+  arena.vertices = vertices;
+  arena.indices = indices;
+  bindArena_(arena);
+
+  ui32 vertexCapacity = arena.vertexRanges.capacity();
+  ui32 indexCapacity = arena.indexRanges.capacity();
+  arena.vertexRanges.reset(vertexCapacity);
+  arena.indexRanges.reset(indexCapacity);
+  if (vertexOffset) {
+    arena.vertexRanges.allocate(vertexOffset);
+  }
+  if (indexOffset) {
+    arena.indexRanges.allocate(indexOffset);
+  }
+}
+
+size_t GeometryPool::usedBytes() const {
+  size_t bytes = 0;
+  for (ui32 i = 0; i < numArenas_; ++i) {
+    const Arena& arena = arenas_[i];
+    bytes += arena.vertexRanges.used() * formats_[arena.format].stride + arena.indexRanges.used() * sizeof(ui32);
+  }
+  return bytes;
+}
+
+size_t GeometryPool::capacityBytes() const {
+  size_t bytes = 0;
+  for (ui32 i = 0; i < numArenas_; ++i) {
+    bytes += arenas_[i].vertices->size() + arenas_[i].indices->size();
+  }
+  return bytes;
+}
+
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "webgl.h"
+#include "rangeAllocator.h"
+#include "vertexArray.h"
+
+namespace WebGL
+{
+
+struct DrawItem;
+
+// Sub-allocates mesh vertex and index ranges from large shared buffers. Meshes with
+// the same vertex layout go into the same arenas (a vertex buffer, a 32-bit index
+// buffer and one VertexArray), so consecutive draws of different meshes don't
+// switch VAOs. WebGL has no base vertex draws, so the mesh's base vertex is added
+// to its indices on upload; a copy of the original indices is kept for rebasing
+// them when compact() moves the vertices.
+class GeometryPool {
+public:
+  enum {
+    MAX_FORMATS = 16,
+    MAX_ARENAS = 64,
+    INVALID_FORMAT = 0xFFFFFFFFU,
+    INVALID_MESH = 0xFFFFFFFFU,
+  };
+
+  // Arenas hold arenaSize bytes of vertices and arenaSize / 2 bytes of indices,
+  // or more if a single mesh needs it
+  GeometryPool(size_t arenaSize = 4 << 20);
+  ~GeometryPool();
+
+  GeometryPool(const GeometryPool&) = delete;
+  GeometryPool& operator=(const GeometryPool&) = delete;
+
+  // Returns the format id for a layout, registering it if needed
+  ui32 format(const VertexLayout& layout);
+
+  // Uploads a mesh; indices are relative to its first vertex. Returns INVALID_MESH
+  // if all arenas are in use.
+  ui32 allocate(ui32 format, const void* vertices, ui32 vertexCount, const ui32* indices, ui32 indexCount);
+  void free(ui32 mesh);
+
+  VertexArray* vertexArray(ui32 mesh) const {
+    return arenas_[meshes_[mesh].arena].vertexArray;
+  }
+  ui32 baseVertex(ui32 mesh) const {
+    return meshes_[mesh].vertexOffset;
+  }
+  ui32 firstIndex(ui32 mesh) const {
+    return meshes_[mesh].indexOffset;
+  }
+  ui32 indexCount(ui32 mesh) const {
+    return meshes_[mesh].indexCount;
+  }
+  // Fills the vertex array and index range of a draw
+  void setDraw(ui32 mesh, DrawItem& item) const;
+
+  // Repacks fragmented arenas into fresh buffers with Buffer::copyData (WebGL2).
+  // Returns the number of arenas compacted.
+  ui32 compact();
+
+  size_t numArenas() const {
+    return numArenas_;
+  }
+  size_t usedBytes() const;
+  size_t capacityBytes() const;
+
+private:
+  struct Arena {
+    ui32 format;
+    Buffer* vertices;
+    Buffer* indices;
+    VertexArray* vertexArray;
+    RangeAllocator vertexRanges;
+    RangeAllocator indexRanges;
+  };
+  struct Mesh {
+    ui32 arena;
+    ui32 vertexOffset;
+    ui32 vertexCount;
+    ui32 indexOffset;
+    ui32 indexCount;
+    ui32* indices;
+    ui32 nextFree;
+  };
+
+  size_t arenaSize_;
+  VertexLayout formats_[MAX_FORMATS];
+  ui32 numFormats_ = 0;
+  Arena arenas_[MAX_ARENAS];
+  ui32 numArenas_ = 0;
+  Mesh* meshes_ = nullptr;
+  ui32 numMeshes_ = 0;
+  ui32 maxMeshes_ = 0;
+  ui32 freeMesh_ = INVALID_MESH;
+
+  ui32 createArena_(ui32 format, ui32 vertexCount, ui32 indexCount);
+  void bindArena_(Arena& arena);
+  void uploadIndices_(Arena& arena, Buffer* buffer, const Mesh& mesh);
+  void compact_(ui32 arena);
+};
+
+}
@@ -2,24 +2,77 @@
 
 #include "alloc.h"
 
+namespace WebGL
+{
+class DestroyQueue;
+}
+
 class GLBase {
 public:
-  virtual ~GLBase() {}
+  virtual ~GLBase() {
+    handles_.free(handle_);
+  }
 
   void addref() {
     refCount_++;
   }
+  // The last release parks the object in the destroy queue (destroyQueue.h)
   void release() {
     if (!--refCount_) {
-      delete this;
+      retire_();
     }
   }
+
+  // Identifies the object to JS, see HandlePool
+  ui32 handle() const {
+    return handle_;
+  }
+  static const HandlePool& handles() {
+    return handles_;
+  }
+
 protected:
-  GLBase() {}
+  GLBase()
+    : handle_(handles_.alloc())
+  {
+  }
 private:
   ui32 refCount_ = 1;
+  ui32 handle_;
+  // Set while the object waits in the destroy queue, with the frame it was last
+  // released in
+  bool retired_ = false;
+  ui32 retiredFrame_ = 0;
+  static HandlePool handles_;
+
+  void retire_();
+  // Pool the object's memory came from, for freeing destroyed objects in bulk
+  virtual SizedPool& sizedPool_() const = 0;
+  friend class WebGL::DestroyQueue;
+};
+
+// Object arguments are passed to JS as handles, which index its object table
+struct GLptr {
+  GLptr()
+    : handle(0)
+  {
+  }
+  GLptr(decltype(nullptr))
+    : handle(0)
+  {
+  }
+  GLptr(const GLBase* object)
+    : handle(object ? object->handle() : 0)
+  {
+  }
+  static GLptr fromHandle(ui32 handle) {
+    GLptr ptr;
+    ptr.handle = handle;
+    return ptr;
+  }
+
+  ui32 handle;
 };
-typedef GLBase* GLptr;
 
 typedef void GLvoid;
 typedef unsigned long GLenum;
@@ -808,6 +861,10 @@ enum {
 /* WEBGL_debug_renderer_info */
   GL_UNMASKED_VENDOR = 0x9245,
   GL_UNMASKED_RENDERER = 0x9246,
+
+/* KHR_parallel_shader_compile */
+  GL_MAX_SHADER_COMPILER_THREADS_KHR = 0x91B0,
+  GL_COMPLETION_STATUS_KHR = 0x91B1,
 };
 
 GLint glVersion();
@@ -1116,7 +1173,7 @@ void glGetSamplerParameterfv(GLptr sampler, GLenum pname, GLfloat* params);
 void glFenceSync(GLptr sync, GLenum condition, GLbitfield flags);
 void glDeleteSync(GLptr sync);
 GLboolean glIsSync(GLptr sync);
-void glClientWaitSync(GLptr sync, GLbitfield flags, GLuint timeout);
+GLenum glClientWaitSync(GLptr sync, GLbitfield flags, GLuint timeout);
 void glWaitSync(GLptr sync, GLbitfield flags, GLuint timeout);
 GLint glGetSynci(GLptr sync, GLenum pname);
 void glGetSynciv(GLptr sync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint* values);
@@ -1161,3 +1218,24 @@ void glGetTranslatedShaderSource(GLptr shader, GLsizei maxSize, GLsizei* length,
 // WEBGL_lose_context
 void glLoseContext();
 void glRestoreContext();
+
+// WEBGL_multi_draw
+void glMultiDrawArrays(GLenum mode, const GLint* firsts, const GLsizei* counts, GLsizei drawCount);
+void glMultiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets, GLsizei drawCount);
+void glMultiDrawElementsInstanced(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets,
+                                  const GLsizei* instanceCounts, GLsizei drawCount);
+
+// Frame stats: address of the FrameStatsBuffer in linear memory (frameStats.h)
+void glFrameStats(const void* stats);
+
+// Command buffer
+void glExecuteCommands(const ui32* commands, size_t size);
+// Frame capture: a finished trace (frameCapture.h)
+void glSaveTrace(const void* trace, size_t size);
+
+// Leak check: handles of the objects still alive at shutdown (destroyQueue.h)
+void glReportLeaks(const ui32* handles, size_t count);
+
+#ifdef GL_COMMAND_BUFFER
+#include "commandBuffer.h"
+#endif
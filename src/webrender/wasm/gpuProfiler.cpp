@@ -0,0 +1,228 @@
+#include "gpuProfiler.h"
+#include "query.h"
+#include "hash.h"
+
+namespace WebGL
+{
+
+GpuProfiler::~GpuProfiler() {
+  if (active_) {
+    Query::end(GL_TIME_ELAPSED);
+  }
+  for (ui32 i = 0; i < numFrames_; ++i) {
+    Frame& frame = frames_[(firstFrame_ + i) % MAX_FRAMES];
+    for (ui32 j = 0; j < frame.numSegments; ++j) {
+      frame.segments[j].query->release();
+    }
+  }
+  for (ui32 i = 0; i < poolSize_; ++i) {
+    pool_[i]->release();
+  }
+}
+
+void GpuProfiler::beginFrame() {
+  enabled_ = getFeature(FEATURE_TIMER_QUERY);
+  if (!enabled_) {
+    return;
+  }
+  assert(depth_ == 0);
+  poll_();
+  if (numFrames_ == MAX_FRAMES) {
+    recording_ = false;
+    ++skippedFrames_;
+    return;
+  }
+  Frame& frame = frames_[(firstFrame_ + numFrames_++) % MAX_FRAMES];
+  frame.numSegments = 0;
+  frame.disjoint = false;
+  recording_ = true;
+}
+
+void GpuProfiler::endFrame() {
+  if (!enabled_) {
+    return;
+  }
+  assert(depth_ == 0);
+  split_(INVALID_SCOPE);
+  recording_ = false;
+}
+
+void GpuProfiler::begin(const char* name) {
+  if (!enabled_) {
+    return;
+  }
+  if (depth_ == MAX_DEPTH) {
+    // Too deep; the time is credited to the innermost tracked scope
+    ++overflow_;
+    return;
+  }
+  ui32 scope = scope_(name);
+  split_(scope);
+  stack_[depth_++] = scope;
+}
+
+void GpuProfiler::end() {
+  if (!enabled_) {
+    return;
+  }
+  if (overflow_) {
+    --overflow_;
+    return;
+  }
+  assert(depth_ > 0);
+  --depth_;
+  split_(depth_ ? stack_[depth_ - 1] : INVALID_SCOPE);
+}
+
+ui32 GpuProfiler::findScope(const char* name, ui32 parent) const {
+  ui32 nameHash = hashString(name);
+  for (ui32 i = 0; i < numScopes_; ++i) {
+    const ScopeInfo& scope = scopes_[i];
+    if (scope.parent == parent && scope.nameHash == nameHash && stringEqual(scope.name, name)) {
+      return i;
+    }
+  }
+  return INVALID_SCOPE;
+}
+
+const float* GpuProfiler::exportStats() {
+  float* out = export_;
+  for (ui32 i = 0; i < numScopes_; ++i, out += EXPORT_STRIDE) {
+    const ScopeInfo& scope = scopes_[i];
+    out[EXPORT_PARENT] = (scope.parent == INVALID_SCOPE ? -1.0f : (float) scope.parent);
+    out[EXPORT_DEPTH] = (float) scope.depth;
+    out[EXPORT_LAST] = scope.last;
+    out[EXPORT_MIN] = scope.min;
+    out[EXPORT_AVG] = scope.avg;
+    out[EXPORT_MAX] = scope.max;
+  }
+  return export_;
+}
+
+// Scopes are identified by name and parent, so the same pass timed under two
+// different parents gets two entries
+ui32 GpuProfiler::scope_(const char* name) {
+  ui32 parent = (depth_ ? stack_[depth_ - 1] : INVALID_SCOPE);
+  ui32 index = findScope(name, parent);
+  if (index != INVALID_SCOPE || numScopes_ == MAX_SCOPES) {
+    return index;
+  }
+  index = numScopes_++;
+  ScopeInfo& scope = scopes_[index];
+  scope.name = name;
+  scope.nameHash = hashString(name);
+  scope.parent = parent;
+  scope.depth = depth_;
+  scope.count = 0;
+  scope.next = 0;
+  scope.last = scope.min = scope.avg = scope.max = 0.0f;
+  return index;
+}
+
+// Closes the running query and opens a new one charged to scope
+void GpuProfiler::split_(ui32 scope) {
+  if (active_) {
+    Query::end(GL_TIME_ELAPSED);
+    active_ = false;
+  }
+  if (!recording_ || scope == INVALID_SCOPE) {
+    return;
+  }
+  Frame& frame = frames_[(firstFrame_ + numFrames_ - 1) % MAX_FRAMES];
+  if (frame.numSegments == MAX_SEGMENTS) {
+    return;
+  }
+  Query* query = acquireQuery_();
+  query->begin(GL_TIME_ELAPSED);
+  frame.segments[frame.numSegments].query = query;
+  frame.segments[frame.numSegments].scope = scope;
+  ++frame.numSegments;
+  active_ = true;
+}
+
+void GpuProfiler::poll_() {
+  // Reading the flag clears it, and it cannot tell which queries were affected,
+  // so everything still in flight is discarded
+  if (glGetInteger(GL_GPU_DISJOINT)) {
+    for (ui32 i = 0; i < numFrames_; ++i) {
+      frames_[(firstFrame_ + i) % MAX_FRAMES].disjoint = true;
+    }
+  }
+  while (numFrames_) {
+    Frame& frame = frames_[firstFrame_];
+    // Queries complete in submission order, so the last one decides the frame
+    if (frame.numSegments && !frame.disjoint && !frame.segments[frame.numSegments - 1].query->available()) {
+      break;
+    }
+    resolve_(frame);
+    firstFrame_ = (firstFrame_ + 1) % MAX_FRAMES;
+    --numFrames_;
+  }
+}
+
+void GpuProfiler::resolve_(Frame& frame) {
+  if (frame.disjoint) {
+    ++disjointFrames_;
+    for (ui32 i = 0; i < frame.numSegments; ++i) {
+      releaseQuery_(frame.segments[i].query);
+    }
+    return;
+  }
+
+  ui64 elapsed[MAX_SCOPES];
+  ui64 touched = 0;
+  for (ui32 i = 0; i < frame.numSegments; ++i) {
+    Segment& segment = frame.segments[i];
+    ui64 time = segment.query->result();
+    releaseQuery_(segment.query);
+    for (ui32 scope = segment.scope; scope != INVALID_SCOPE; scope = scopes_[scope].parent) {
+      ui64 bit = (ui64) 1 << scope;
+      if (!(touched & bit)) {
+        touched |= bit;
+        elapsed[scope] = 0;
+      }
+      elapsed[scope] += time;
+    }
+  }
+
+  // Scopes that did not run this frame keep their previous statistics
+  for (ui32 i = 0; i < numScopes_; ++i) {
+    if (touched & ((ui64) 1 << i)) {
+      addSample_(scopes_[i], (float) elapsed[i] * 1e-6f);
+    }
+  }
+}
+
+void GpuProfiler::addSample_(ScopeInfo& scope, float time) {
+  scope.history[scope.next] = time;
+  scope.next = (scope.next + 1) % HISTORY;
+  if (scope.count < HISTORY) {
+    ++scope.count;
+  }
+  scope.last = time;
+  float min = time, max = time, sum = 0.0f;
+  for (ui32 i = 0; i < scope.count; ++i) {
+    float value = scope.history[i];
+    if (value < min) min = value;
+    if (value > max) max = value;
+    sum += value;
+  }
+  scope.min = min;
+  scope.max = max;
+  scope.avg = sum / (float) scope.count;
+}
+
+Query* GpuProfiler::acquireQuery_() {
+  if (poolSize_) {
+    return pool_[--poolSize_];
+  }
+  return Query::create();
+}
+
+void GpuProfiler::releaseQuery_(Query* query) {
+  // Every query comes back here before a frame slot is reused, so the pool
+  // never holds more than MAX_FRAMES * MAX_SEGMENTS
+  pool_[poolSize_++] = query;
+}
+
+}
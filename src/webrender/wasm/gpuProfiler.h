@@ -0,0 +1,141 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Hierarchical GPU timer built on TIME_ELAPSED queries (EXT_disjoint_timer_query).
+// Elapsed queries cannot nest, so every begin()/end() closes the running query and
+// opens a new one for the innermost scope; each segment is later credited to its
+// scope and all of its ancestors. Results are polled MAX_FRAMES later at the
+// earliest and never waited on; frames that overlap a disjoint event are dropped.
+//
+// Scope names are stored by pointer and must stay valid (string literals).
+// Does nothing if the timer query extension is not available.
+class GpuProfiler {
+public:
+  enum {
+    MAX_SCOPES = 64,
+    MAX_DEPTH = 16,
+    MAX_SEGMENTS = 128,
+    MAX_FRAMES = 4,
+    HISTORY = 60,
+    INVALID_SCOPE = 0xFFFFFFFF,
+  };
+
+  // Layout of one scope in exportStats(); times are in milliseconds
+  enum {
+    EXPORT_PARENT,  // -1 for top level scopes
+    EXPORT_DEPTH,
+    EXPORT_LAST,
+    EXPORT_MIN,
+    EXPORT_AVG,
+    EXPORT_MAX,
+    EXPORT_STRIDE,
+  };
+
+  GpuProfiler() {}
+  ~GpuProfiler();
+
+  GpuProfiler(const GpuProfiler&) = delete;
+  GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+  // Collects finished frames and starts recording a new one. If MAX_FRAMES are
+  // still in flight the frame is not recorded.
+  void beginFrame();
+  void endFrame();
+
+  void begin(const char* name);
+  void end();
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  size_t numScopes() const {
+    return numScopes_;
+  }
+  const char* scopeName(ui32 scope) const {
+    return scope < numScopes_ ? scopes_[scope].name : nullptr;
+  }
+  ui32 findScope(const char* name, ui32 parent = INVALID_SCOPE) const;
+
+  // numScopes() * EXPORT_STRIDE floats, for reading through a Float32Array view
+  const float* exportStats();
+
+  ui32 skippedFrames() const {
+    return skippedFrames_;
+  }
+  ui32 disjointFrames() const {
+    return disjointFrames_;
+  }
+
+  class Scope {
+  public:
+    Scope(GpuProfiler& profiler, const char* name)
+      : profiler_(profiler)
+    {
+      profiler_.begin(name);
+    }
+    ~Scope() {
+      profiler_.end();
+    }
+  private:
+    GpuProfiler& profiler_;
+  };
+
+private:
+  struct ScopeInfo {
+    const char* name;
+    ui32 nameHash;
+    ui32 parent;
+    ui32 depth;
+    float history[HISTORY];
+    ui32 count;
+    ui32 next;
+    float last;
+    float min;
+    float avg;
+    float max;
+  };
+  struct Segment {
+    Query* query;
+    ui32 scope;
+  };
+  struct Frame {
+    Segment segments[MAX_SEGMENTS];
+    ui32 numSegments = 0;
+    bool disjoint = false;
+  };
+
+  ScopeInfo scopes_[MAX_SCOPES];
+  ui32 numScopes_ = 0;
+  float export_[MAX_SCOPES * EXPORT_STRIDE];
+
+  Frame frames_[MAX_FRAMES];
+  ui32 firstFrame_ = 0;
+  ui32 numFrames_ = 0;
+  bool recording_ = false;
+  bool active_ = false;
+  bool enabled_ = false;
+
+  ui32 stack_[MAX_DEPTH];
+  ui32 depth_ = 0;
+  ui32 overflow_ = 0;
+
+  Query* pool_[MAX_FRAMES * MAX_SEGMENTS];
+  ui32 poolSize_ = 0;
+
+  ui32 skippedFrames_ = 0;
+  ui32 disjointFrames_ = 0;
+
+  ui32 scope_(const char* name);
+  void split_(ui32 scope);
+  void poll_();
+  void resolve_(Frame& frame);
+  void addSample_(ScopeInfo& scope, float time);
+  Query* acquireQuery_();
+  void releaseQuery_(Query* query);
+};
+
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "common.h"
+
+inline ui32 hashMix(ui32 hash, ui32 value) {
+  value *= 0xCC9E2D51U;
+  value = (value << 15) | (value >> 17);
+  value *= 0x1B873593U;
+  hash ^= value;
+  hash = (hash << 13) | (hash >> 19);
+  return hash * 5 + 0xE6546B64U;
+}
+
+inline ui32 hashFinal(ui32 hash) {
+  hash ^= hash >> 16;
+  hash *= 0x85EBCA6BU;
+  hash ^= hash >> 13;
+  hash *= 0xC2B2AE35U;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+inline ui32 hashWords(const ui32* data, size_t count, ui32 seed = 0) {
+  ui32 hash = seed;
+  for (size_t i = 0; i < count; ++i) {
+    hash = hashMix(hash, data[i]);
+  }
+  return hashFinal(hash ^ (ui32)count);
+}
+
+inline ui32 hashString(const char* str, ui32 seed = 0) {
+  ui32 hash = seed;
+  size_t length = 0;
+  for (; str[length]; ++length) {
+    hash = hashMix(hash, (unsigned char)str[length]);
+  }
+  return hashFinal(hash ^ (ui32)length);
+}
+
+inline size_t stringLength(const char* str) {
+  size_t length = 0;
+  while (str[length]) {
+    ++length;
+  }
+  return length;
+}
+
+inline bool stringEqual(const char* lhs, const char* rhs) {
+  while (*lhs && *lhs == *rhs) {
+    ++lhs;
+    ++rhs;
+  }
+  return *lhs == *rhs;
+}
@@ -4,7 +4,7 @@ namespace _mem {
 
 const size_t SIZE_MAX = (size_t)-1;
 const size_t SIZE_SZ = sizeof(size_t);
-const size_t MALLOC_ALIGNMENT = 8;
+const size_t MALLOC_ALIGNMENT = 2 * SIZE_SZ;
 const size_t MALLOC_ALIGN_MASK = MALLOC_ALIGNMENT - 1;
 const size_t HALF_SIZE_MAX = ((size_t)1) << (8 * sizeof(size_t) / 2);
 
@@ -160,13 +160,13 @@ public:
   }
 };
 
-const size_t MIN_CHUNK_SIZE = 16;//(size_t)((char*)&(((malloc_chunk*)0)->fd_nextsize) - (char*)0);
+const size_t MIN_CHUNK_SIZE = 4 * SIZE_SZ; // prev_size, size, fd, bk
 const size_t MINSIZE = (MIN_CHUNK_SIZE + MALLOC_ALIGN_MASK) & ~MALLOC_ALIGN_MASK;
 
 constexpr inline bool aligned_OK(void* m) {
   return ((size_t)m & MALLOC_ALIGN_MASK) == 0;
 }
-constexpr inline size_t misaligned_chunk(malloc_chunk* p) {
+inline size_t misaligned_chunk(malloc_chunk* p) {
   return (MALLOC_ALIGNMENT == 2 * SIZE_SZ ? (size_t)p : (size_t)p->memory()) & MALLOC_ALIGN_MASK;
 }
 
@@ -0,0 +1,244 @@
+#include "memoryTracker.h"
+#include "texture.h"
+
+namespace WebGL
+{
+
+static inline size_t max(size_t a, size_t b) {
+  return a > b ? a : b;
+}
+
+static struct MemoryTracker {
+  MemoryStats stats_;
+  size_t budget_ = 0;
+  bool evicting_ = false;
+} tracker_;
+
+const MemoryStats& getMemoryStats() {
+  return tracker_.stats_;
+}
+
+size_t getFormatSize(GLenum format) {
+  switch (format) {
+  case GL_ALPHA:
+  case GL_LUMINANCE:
+  case GL_STENCIL_INDEX8:
+  case GL_R8:
+  case GL_R8I:
+  case GL_R8UI:
+  case GL_R8_SNORM:
+    return 1;
+  case GL_LUMINANCE_ALPHA:
+  case GL_RGBA4:
+  case GL_RGB5_A1:
+  case GL_RGB565:
+  case GL_DEPTH_COMPONENT16:
+  case GL_R16F:
+  case GL_R16I:
+  case GL_R16UI:
+  case GL_RG8:
+  case GL_RG8I:
+  case GL_RG8UI:
+  case GL_RG8_SNORM:
+    return 2;
+  case GL_RGB16F:
+  case GL_RGB16I:
+  case GL_RGB16UI:
+  case GL_RGBA16F:
+  case GL_RGBA16I:
+  case GL_RGBA16UI:
+  case GL_RG32F:
+  case GL_RG32I:
+  case GL_RG32UI:
+  case GL_DEPTH32F_STENCIL8:
+    return 8;
+  case GL_RGB32F:
+  case GL_RGB32I:
+  case GL_RGB32UI:
+  case GL_RGBA32F:
+  case GL_RGBA32I:
+  case GL_RGBA32UI:
+    return 16;
+  default:
+    // RGB(A)8 and variants, packed 32-bit formats, 24/32-bit depth
+    return getCompressedSize(format, 4, 4) ? 0 : 4;
+  }
+}
+
+size_t getCompressedSize(GLenum internalFormat, size_t width, size_t height) {
+  switch (internalFormat) {
+  case GL_COMPRESSED_RGB_S3TC_DXT1:
+  case GL_COMPRESSED_RGBA_S3TC_DXT1:
+  case GL_COMPRESSED_SRGB_S3TC_DXT1:
+  case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1:
+  case GL_COMPRESSED_R11_EAC:
+  case GL_COMPRESSED_SIGNED_R11_EAC:
+  case GL_COMPRESSED_RGB8_ETC2:
+  case GL_COMPRESSED_SRGB8_ETC2:
+  case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+  case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+  case GL_COMPRESSED_RGB_ETC1:
+  case GL_COMPRESSED_RGB_ATC:
+    return ((width + 3) / 4) * ((height + 3) / 4) * 8;
+  case GL_COMPRESSED_RGBA_S3TC_DXT3:
+  case GL_COMPRESSED_RGBA_S3TC_DXT5:
+  case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3:
+  case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5:
+  case GL_COMPRESSED_RG11_EAC:
+  case GL_COMPRESSED_SIGNED_RG11_EAC:
+  case GL_COMPRESSED_RGBA8_ETC2_EAC:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
+  case GL_COMPRESSED_RGBA_ATC_EXPLICIT_ALPHA:
+  case GL_COMPRESSED_RGBA_ATC_INTERPOLATED_ALPHA:
+    return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+  case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
+  case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
+    return max(width, 8) * max(height, 8) / 2;
+  case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
+  case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
+    return max(width, 16) * max(height, 8) / 4;
+  case GL_COMPRESSED_RGBA_ASTC_4x4:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4:
+    return ((width + 3) / 4) * ((height + 3) / 4) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_5x4:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4:
+    return ((width + 4) / 5) * ((height + 3) / 4) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_5x5:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5:
+    return ((width + 4) / 5) * ((height + 4) / 5) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_6x5:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5:
+    return ((width + 5) / 6) * ((height + 4) / 5) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_6x6:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6:
+    return ((width + 5) / 6) * ((height + 5) / 6) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_8x5:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5:
+    return ((width + 7) / 8) * ((height + 4) / 5) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_8x6:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6:
+    return ((width + 7) / 8) * ((height + 5) / 6) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_8x8:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8:
+    return ((width + 7) / 8) * ((height + 7) / 8) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_10x5:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5:
+    return ((width + 9) / 10) * ((height + 4) / 5) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_10x6:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6:
+    return ((width + 9) / 10) * ((height + 5) / 6) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_10x8:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8:
+    return ((width + 9) / 10) * ((height + 7) / 8) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_10x10:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10:
+    return ((width + 9) / 10) * ((height + 9) / 10) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_12x10:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10:
+    return ((width + 11) / 12) * ((height + 9) / 10) * 16;
+  case GL_COMPRESSED_RGBA_ASTC_12x12:
+  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12:
+    return ((width + 11) / 12) * ((height + 11) / 12) * 16;
+
+  default:
+    return 0;
+  }
+}
+
+size_t getImageSize(GLenum format, size_t width, size_t height) {
+  size_t texel = getFormatSize(format);
+  return texel ? width * height * texel : getCompressedSize(format, width, height);
+}
+
+size_t getPixelSize(GLenum format, GLenum type) {
+  switch (type) {
+  case GL_UNSIGNED_SHORT_5_6_5:
+  case GL_UNSIGNED_SHORT_4_4_4_4:
+  case GL_UNSIGNED_SHORT_5_5_5_1:
+    return 2;
+  case GL_UNSIGNED_INT_2_10_10_10_REV:
+  case GL_UNSIGNED_INT_10F_11F_11F_REV:
+  case GL_UNSIGNED_INT_5_9_9_9_REV:
+  case GL_UNSIGNED_INT_24_8:
+    return 4;
+  case GL_FLOAT_32_UNSIGNED_INT_24_8_REV:
+    return 8;
+  }
+  size_t components;
+  switch (format) {
+  case GL_RED:
+  case GL_RED_INTEGER:
+  case GL_ALPHA:
+  case GL_LUMINANCE:
+  case GL_DEPTH_COMPONENT:
+    components = 1;
+    break;
+  case GL_RG:
+  case GL_RG_INTEGER:
+  case GL_LUMINANCE_ALPHA:
+    components = 2;
+    break;
+  case GL_RGB:
+  case GL_RGB_INTEGER:
+    components = 3;
+    break;
+  default:
+    components = 4;
+    break;
+  }
+  switch (type) {
+  case GL_UNSIGNED_BYTE:
+  case GL_BYTE:
+    return components;
+  case GL_UNSIGNED_SHORT:
+  case GL_SHORT:
+  case GL_HALF_FLOAT:
+    return components * 2;
+  default:
+    return components * 4;
+  }
+}
+
+void setMemoryBudget(size_t bytes) {
+  tracker_.budget_ = bytes;
+  enforceMemoryBudget();
+}
+size_t getMemoryBudget() {
+  return tracker_.budget_;
+}
+
+void trackMemory(MemoryCategory category, size_t added, size_t removed) {
+  MemoryStats& stats = tracker_.stats_;
+  stats.bytes[category] += added - removed;
+  stats.total += added - removed;
+  if (stats.total > stats.peak) {
+    stats.peak = stats.total;
+  }
+  if (added) {
+    enforceMemoryBudget();
+  }
+}
+
+void enforceMemoryBudget() {
+  MemoryStats& stats = tracker_.stats_;
+  // Evictions call back into trackMemory as the textures release their storage
+  if (tracker_.budget_ && stats.total > tracker_.budget_ && !tracker_.evicting_) {
+    tracker_.evicting_ = true;
+    Texture::evict(stats.total - tracker_.budget_);
+    tracker_.evicting_ = false;
+  }
+}
+
+void trackEvictable(size_t added, size_t removed) {
+  tracker_.stats_.evictable += added - removed;
+}
+
+void trackEviction(bool reload) {
+  if (reload) {
+    tracker_.stats_.reloads += 1;
+  } else {
+    tracker_.stats_.evictions += 1;
+  }
+}
+
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+enum MemoryCategory {
+  MEMORY_TEXTURE,
+  // Render buffers and textures attached to a frame buffer
+  MEMORY_RENDER_TARGET,
+  MEMORY_VERTEX,
+  MEMORY_INDEX,
+  MEMORY_UNIFORM,
+  // Pixel transfer and copy buffers
+  MEMORY_OTHER,
+  NUM_MEMORY_CATEGORIES,
+};
+
+struct MemoryStats {
+  size_t bytes[NUM_MEMORY_CATEGORIES] = {};
+  size_t total = 0;
+  size_t peak = 0;
+  // Resident textures that can be evicted
+  size_t evictable = 0;
+  ui32 evictions = 0;
+  ui32 reloads = 0;
+};
+
+// Estimated storage of the live GL objects. Drivers pad and align allocations, so
+// this is a lower bound of the real usage; the internal format decides the cost,
+// e.g. RGB8 is counted as 4 bytes per texel.
+const MemoryStats& getMemoryStats();
+
+// Bytes per texel of an uncompressed internal format, 0 for compressed formats
+size_t getFormatSize(GLenum format);
+// Bytes of one image of a compressed format, 0 for uncompressed formats
+size_t getCompressedSize(GLenum format, size_t width, size_t height);
+// Bytes of one image of any format
+size_t getImageSize(GLenum format, size_t width, size_t height);
+// Bytes per pixel of client data passed to texture uploads with this format and type
+size_t getPixelSize(GLenum format, GLenum type);
+
+// When the total goes over the budget, evictable textures that were not used in the
+// current frame are evicted in least recently used order. 0 disables the budget.
+void setMemoryBudget(size_t bytes);
+size_t getMemoryBudget();
+// Evicts textures until the total is within the budget. Runs on every allocation
+// and from endFrame, when textures used in the finished frame become candidates.
+void enforceMemoryBudget();
+
+// Called by resources when their storage changes
+void trackMemory(MemoryCategory category, size_t added, size_t removed);
+// Called by evictable textures
+void trackEvictable(size_t added, size_t removed);
+void trackEviction(bool reload);
+
+}
@@ -0,0 +1,811 @@
+#include "../webgl.h"
+#include "../buffer.h"
+#include "../texture.h"
+#include "../sampler.h"
+#include "../frameBuffer.h"
+#include "../renderBuffer.h"
+#include "../vertexArray.h"
+#include "../pipelineState.h"
+#include "../program.h"
+#include "../shader.h"
+#include "../shaderPermutations.h"
+#include "../uniformBuffer.h"
+#include "../drawQueue.h"
+#include "../streamBuffer.h"
+#include "../readback.h"
+#include "../geometryPool.h"
+#include "../gpuProfiler.h"
+#include "../occlusionCuller.h"
+#include "../memoryTracker.h"
+#include "../renderTargetPool.h"
+#include "../frameGraph.h"
+#include "../frameStats.h"
+#include "../destroyQueue.h"
+#include "glStub.h"
+#include "native.h"
+
+// Microbenchmarks for the redundant-state-elimination layer, run against the recording stub.
+// For every case prints the time per operation and the number of GL calls it emitted.
+// Cases check the calls they are expected to emit; any mismatch fails the bench.
+
+using namespace WebGL;
+
+static const int ITERATIONS = 1000000;
+
+// Uncached program linked from empty shaders; the stub reflects config.uniforms
+static Program* createProgram() {
+  Shader* vertex = Shader::create(GL_VERTEX_SHADER);
+  Shader* fragment = Shader::create(GL_FRAGMENT_SHADER);
+  Program* program = Program::create(vertex, fragment);
+  vertex->release();
+  fragment->release();
+  return program;
+}
+
+static const char* measureName = "";
+static int failures = 0;
+
+// Fails the bench if a condition doesn't hold
+static void expect(bool condition, const char* what) {
+  if (!condition) {
+    nativePrint("FAILED: %s\n", what);
+    failures += 1;
+  }
+}
+
+// Checks the GL calls per operation of the last measure(), all of them or one function
+static void expectCalls(double expected, int function = -1) {
+  ui64 calls = (function < 0 ? GLStub::stats.total : GLStub::stats.calls[function]);
+  double actual = (double)calls / ITERATIONS;
+  if (actual - expected > 0.005 || expected - actual > 0.005) {
+    nativePrint("FAILED: %s: %.2f %s per op, expected %.2f\n", measureName, actual,
+                function < 0 ? "calls" : GLStub::functionNames[function], expected);
+    failures += 1;
+  }
+}
+
+template<class Op>
+static void measure(const char* name, Op op) {
+  measureName = name;
+  GLStub::reset();
+  unsigned long long start = nativeTime();
+  for (int i = 0; i < ITERATIONS; ++i) {
+    op(i);
+  }
+  unsigned long long elapsed = nativeTime() - start;
+  nativePrint("%-44s %8.2f ns/op %6.2f calls/op\n", name,
+              (double)elapsed / ITERATIONS, (double)GLStub::stats.total / ITERATIONS);
+  for (int i = 0; i < GLStub::NUM_FUNCTIONS; ++i) {
+    if (GLStub::stats.calls[i] * 200 >= ITERATIONS) {
+      nativePrint("    %-40s %6.2f\n", GLStub::functionNames[i], (double)GLStub::stats.calls[i] / ITERATIONS);
+    }
+  }
+}
+
+static const GLStub::UniformInfo LightPassUniforms[] = {
+  {"uViewProjection", GL_FLOAT_MAT4, 1, -1},
+  {"uInverseView", GL_FLOAT_MAT4, 1, -1},
+  {"uGBuffer", GL_SAMPLER_2D, 3, -1},
+  {"uLightPosition", GL_FLOAT_VEC3, 1, -1},
+  {"uLightColor", GL_FLOAT_VEC3, 1, -1},
+  {"uLightRadius", GL_FLOAT, 1, -1},
+};
+
+static const GLStub::UniformBlockInfo ObjectBlocks[] = {
+  {"Object", 80},
+};
+static const GLStub::UniformInfo ObjectUniforms[] = {
+  {"uModel", GL_FLOAT_MAT4, 1, 0, 0, 0, 16},
+  {"uColor", GL_FLOAT_VEC4, 1, 0, 64, 0, 0},
+};
+
+static ui32 readbacksDelivered = 0;
+static void onReadback(void*, ui32, const void*, size_t) {
+  readbacksDelivered += 1;
+}
+
+int main() {
+  enum {
+    NUM_TEXTURES = 8,
+  };
+  Texture* textures[NUM_TEXTURES];
+  for (int i = 0; i < NUM_TEXTURES; ++i) {
+    textures[i] = Texture::create2D(GL_RGBA8, 256, 256);
+  }
+
+  Buffer* vertices = Buffer::create(65536);
+  Buffer* indices = Buffer::create(65536, nullptr, GL_STATIC_DRAW, GL_ELEMENT_ARRAY_BUFFER);
+  VertexArray* vertexArrays[2];
+  for (int i = 0; i < 2; ++i) {
+    vertexArrays[i] = VertexArray::create();
+    vertexArrays[i]->setAttribute(0, vertices, 3, GL_FLOAT, false, 32, 0);
+    vertexArrays[i]->setAttribute(1, vertices, 3, GL_FLOAT, false, 32, 12);
+    vertexArrays[i]->setAttribute(2, vertices, 2, GL_FLOAT, false, 32, 24);
+    vertexArrays[i]->setIndices(indices);
+  }
+
+  FrameBuffer* frameBuffers[2];
+  for (int i = 0; i < 2; ++i) {
+    frameBuffers[i] = FrameBuffer::create(GL_RGBA8, 256, 256);
+    frameBuffers[i]->texture2D(GL_COLOR_ATTACHMENT0, textures[i]);
+  }
+
+  measure("bindTexture (same texture)", [&](int) {
+    bindTexture(GL_TEXTURE_2D, textures[0], 0);
+  });
+  expectCalls(0);
+  measure("bindTexture (2 textures, one unit)", [&](int i) {
+    bindTexture(GL_TEXTURE_2D, textures[i & 1], 0);
+  });
+  expectCalls(1, GLStub::CALL_glBindTexture);
+  expectCalls(1);
+  measure("bindTexture (8 textures, 8 units)", [&](int i) {
+    bindTexture(GL_TEXTURE_2D, textures[i & 7], i & 7);
+  });
+  expectCalls(0);
+  measure("bindTexture (2 textures, 8 units)", [&](int i) {
+    bindTexture(GL_TEXTURE_2D, textures[(i >> 3) & 1], i & 7);
+  });
+  expectCalls(1, GLStub::CALL_glActiveTexture);
+  expectCalls(1, GLStub::CALL_glBindTexture);
+  expectCalls(2);
+
+  enum {
+    NUM_MATERIAL_TEXTURES = 48,
+  };
+  Texture* materialTextures[NUM_MATERIAL_TEXTURES];
+  for (int i = 0; i < NUM_MATERIAL_TEXTURES; ++i) {
+    materialTextures[i] = Texture::create2D(GL_RGBA8, 64, 64);
+  }
+  endFrame();
+  // Materials of 3 textures drawn from a set larger than the number of units
+  ui32 seed = 1;
+  measure("bindTextures (3 per draw, 48 textures)", [&](int) {
+    seed = seed * 1664525U + 1013904223U;
+    ui32 hash = seed;
+    Texture* draw[3] = {
+      materialTextures[(hash >> 8) % 16],
+      materialTextures[16 + (hash >> 12) % 16],
+      materialTextures[32 + (hash >> 16) % 16],
+    };
+    ui32 units[3];
+    bindTextures(draw, 3, units);
+  });
+  // Only misses bind, each on a unit of its own
+  expect(GLStub::stats.calls[GLStub::CALL_glBindTexture] == GLStub::stats.calls[GLStub::CALL_glActiveTexture],
+         "bindTextures: one glActiveTexture per glBindTexture");
+  ui64 textureBindCalls = GLStub::stats.calls[GLStub::CALL_glBindTexture];
+  endFrame();
+  nativePrint("bindTextures: %u hits, %u misses\n", getStateStats().textureHits, getStateStats().textureMisses);
+  expect(textureBindCalls == getStateStats().textureMisses, "bindTextures: one glBindTexture per miss");
+
+  SamplerDesc shadowDesc;
+  shadowDesc.minFilter = GL_LINEAR;
+  shadowDesc.compareMode = GL_COMPARE_REF_TO_TEXTURE;
+  Sampler* shadowSampler = Sampler::create(shadowDesc);
+  // One depth texture sampled alternately with and without depth compare
+  measure("bindSampler (shadow/plain on one texture)", [&](int i) {
+    bindTexture(GL_TEXTURE_2D, textures[0], 0);
+    if (i & 1) {
+      bindSampler(0, shadowSampler);
+    }
+  });
+  expectCalls(1, GLStub::CALL_glBindSampler);
+  expectCalls(1);
+
+  // Base level is texture state on WebGL2 as well; set while another unit is active it
+  // has to reach GL on the next bind even though the texture is already bound
+  bindTexture(GL_TEXTURE_2D, textures[1], 1);
+  measure("Texture::setBaseLevel (bound, not active)", [&](int i) {
+    textures[i & 1]->setBaseLevel((i >> 1) & 1);
+    bindTexture(GL_TEXTURE_2D, textures[i & 1], i & 1);
+  });
+  expectCalls(1, GLStub::CALL_glActiveTexture);
+  expectCalls(1, GLStub::CALL_glTexParameteri);
+  expectCalls(2);
+  textures[0]->setBaseLevel(0);
+  textures[1]->setBaseLevel(0);
+
+  measure("bindVertexArray (same)", [&](int) {
+    bindVertexArray(vertexArrays[0]);
+  });
+  expectCalls(0);
+  measure("bindVertexArray (alternating)", [&](int i) {
+    bindVertexArray(vertexArrays[i & 1]);
+  });
+  expectCalls(1, GLStub::CALL_glBindVertexArray);
+  expectCalls(1);
+
+  measure("FrameBuffer::onBind (clean)", [&](int) {
+    frameBuffers[0]->onBind(GL_FRAMEBUFFER);
+  });
+  expectCalls(1, GLStub::CALL_glBindFramebuffer);
+  expectCalls(1);
+  measure("FrameBuffer::onBind (dirty attachment)", [&](int i) {
+    bindFrameBuffer(GL_FRAMEBUFFER, frameBuffers[1]);
+    frameBuffers[0]->texture2D(GL_COLOR_ATTACHMENT0, textures[2 + (i & 1)]);
+    frameBuffers[0]->onBind(GL_FRAMEBUFFER);
+  });
+  expectCalls(1, GLStub::CALL_glFramebufferTexture2D);
+  expectCalls(2);
+
+  bindVertexArray(vertexArrays[0]);
+  measure("VertexArray::setAttribute (bound, same)", [&](int) {
+    vertexArrays[0]->setAttribute(0, vertices, 3, GL_FLOAT, false, 32, 0);
+  });
+  expectCalls(0);
+  measure("VertexArray::setAttribute (bound, changing)", [&](int i) {
+    vertexArrays[0]->setAttribute(0, vertices, 3, GL_FLOAT, false, 32, (i & 1) * 4);
+  });
+  expectCalls(1, GLStub::CALL_glVertexAttribPointer);
+  expectCalls(1);
+  measure("VertexArray::setAttribute (unbound)", [&](int i) {
+    vertexArrays[1]->setAttribute(0, vertices, 3, GL_FLOAT, false, 32, (i & 1) * 4);
+  });
+  expectCalls(0);
+
+  GLStub::config.uniforms = LightPassUniforms;
+  GLStub::config.numUniforms = sizeof(LightPassUniforms) / sizeof(LightPassUniforms[0]);
+  Program* lightPass = createProgram();
+  int uViewProjection = lightPass->getUniform("uViewProjection");
+  int uInverseView = lightPass->getUniform("uInverseView");
+  int uGBuffer = lightPass->getUniform("uGBuffer");
+  int uLightPosition = lightPass->getUniform("uLightPosition");
+  int uLightColor = lightPass->getUniform("uLightColor");
+  int uLightRadius = lightPass->getUniform("uLightRadius");
+  float matrix[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+  const i32 gbufferUnits[3] = {0, 1, 2};
+  useProgram(lightPass);
+  // Per-light uniforms change every iteration, per-pass uniforms are re-sent unchanged
+  measure("Program::setUniform (light pass, per light)", [&](int i) {
+    lightPass->setUniformv(uViewProjection, matrix);
+    lightPass->setUniformv(uInverseView, matrix);
+    lightPass->setUniformv(uGBuffer, gbufferUnits, 3);
+    lightPass->setUniform(uLightPosition, (float)(i & 15), 0.0f, 1.0f);
+    lightPass->setUniform(uLightColor, 1.0f, 1.0f, (float)(i & 7));
+    lightPass->setUniform(uLightRadius, 4.0f);
+  });
+  useProgram(nullptr);
+  measure("Program::setUniform (not current)", [&](int i) {
+    lightPass->setUniform(uLightRadius, (float)(i & 1));
+  });
+
+  GLStub::config.uniforms = ObjectUniforms;
+  GLStub::config.numUniforms = sizeof(ObjectUniforms) / sizeof(ObjectUniforms[0]);
+  GLStub::config.uniformBlocks = ObjectBlocks;
+  GLStub::config.numUniformBlocks = sizeof(ObjectBlocks) / sizeof(ObjectBlocks[0]);
+  Program* objectPass = createProgram();
+  objectPass->setUniformBlockBinding("Object", 0);
+  UniformBlock* objectBlock = UniformBlock::create(objectPass, "Object");
+  int uModel = objectBlock->getUniform("uModel");
+  int uColor = objectBlock->getUniform("uColor");
+  UniformBuffer* uniformBuffer = UniformBuffer::create();
+  enum {
+    DRAWS_PER_FRAME = 1000,
+  };
+  UniformBuffer::Range ranges[DRAWS_PER_FRAME];
+  // Per-draw data is packed and uploaded for the whole frame, then each draw binds its
+  // slice
+  measure("UniformBlock (1000 draws/frame)", [&](int i) {
+    int draw = i % DRAWS_PER_FRAME;
+    if (!draw) {
+      endFrame();
+      for (int j = 0; j < DRAWS_PER_FRAME; ++j) {
+        matrix[12] = (float)j;
+        objectBlock->setUniformv(uModel, matrix);
+        objectBlock->setUniform(uColor, 1.0f, 1.0f, 1.0f, 1.0f);
+        ranges[j] = objectBlock->commit(uniformBuffer);
+      }
+      uniformBuffer->upload();
+    }
+    uniformBuffer->bind(0, ranges[draw]);
+  });
+  nativePrint("UniformBuffer: %u uploads, %u bytes in last frame\n", uniformBuffer->uploads(), (ui32)uniformBuffer->used());
+  expectCalls(1, GLStub::CALL_glBindBufferRange);
+  // The first frame also flushes each time the buffer grows
+  expect(GLStub::stats.calls[GLStub::CALL_glBufferSubData] <= ITERATIONS / DRAWS_PER_FRAME + 4,
+         "UniformBlock: one glBufferSubData per frame");
+  expect(uniformBuffer->uploads() == 1, "UniformBuffer: one upload per frame");
+  matrix[12] = 0.0f;
+
+  enum {
+    NUM_PROGRAMS = 4,
+  };
+  Program* programs[NUM_PROGRAMS];
+  for (int i = 0; i < NUM_PROGRAMS; ++i) {
+    programs[i] = createProgram();
+  }
+  PipelineDesc blendDesc;
+  blendDesc.setDepth(GL_LEQUAL, false);
+  blendDesc.setBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  PipelineDesc depthDesc;
+  depthDesc.setDepth(GL_LEQUAL);
+  PipelineState* queueStates[2] = {PipelineState::create(depthDesc), PipelineState::create(blendDesc)};
+  DrawQueue queue;
+  // Draws arrive in scene order with state scattered; submitted every 1000 draws
+  measure("DrawQueue (add + sort + submit)", [&](int i) {
+    ui32 hash = (ui32)i * 2654435761U;
+    DrawItem item;
+    item.program = programs[(hash >> 8) & 3];
+    item.vertexArray = vertexArrays[(hash >> 12) & 1];
+    item.pipelineState = queueStates[((hash >> 16) & 7) == 0];
+    item.textures[0] = textures[(hash >> 20) & 7];
+    item.numTextures = 1;
+    item.indexType = GL_UNSIGNED_SHORT;
+    item.count = 36;
+    queue.add(item, 0, (float)(hash & 255));
+    if (queue.size() == 1000) {
+      queue.submit();
+    }
+  });
+
+  // 2000 meshes of one vertex format in a shared pool; same draws as above but
+  // the vertex array comes from the pool instead of one per mesh
+  GeometryPool geometry;
+  VertexLayout meshLayout;
+  meshLayout.add(0, 3, GL_FLOAT, false, 0);
+  meshLayout.add(1, 3, GL_FLOAT, false, 12);
+  meshLayout.add(2, 2, GL_FLOAT, false, 24);
+  meshLayout.stride = 32;
+  ui32 meshFormat = geometry.format(meshLayout);
+  static float meshVertices[512 * 8];
+  static ui32 meshIndices[1536];
+  for (ui32 i = 0; i < 1536; ++i) {
+    meshIndices[i] = i % 512;
+  }
+  enum {
+    NUM_MESHES = 2000,
+  };
+  ui32 meshes[NUM_MESHES];
+  seed = 12345;
+  for (int i = 0; i < NUM_MESHES; ++i) {
+    seed = seed * 1664525U + 1013904223U;
+    ui32 vertexCount = 24 + (seed >> 24);
+    meshes[i] = geometry.allocate(meshFormat, meshVertices, vertexCount, meshIndices, vertexCount * 3);
+  }
+  nativePrint("GeometryPool: %u meshes in %u arenas, %u KB used of %u KB\n", (ui32)NUM_MESHES,
+              (ui32)geometry.numArenas(), (ui32)(geometry.usedBytes() >> 10), (ui32)(geometry.capacityBytes() >> 10));
+  // Draws sharing program, pipeline state and texture go into one multi-draw
+  size_t pooledDrawCalls = 0;
+  measure("DrawQueue (add + sort + submit, pooled meshes)", [&](int i) {
+    ui32 hash = (ui32)i * 2654435761U;
+    DrawItem item;
+    item.program = programs[(hash >> 8) & 3];
+    item.pipelineState = queueStates[((hash >> 16) & 7) == 0];
+    item.textures[0] = textures[(hash >> 20) & 7];
+    item.numTextures = 1;
+    geometry.setDraw(meshes[i % NUM_MESHES], item);
+    queue.add(item, 0, (float)(hash & 255));
+    if (queue.size() == 1000) {
+      queue.submit();
+      pooledDrawCalls = queue.drawCalls();
+    }
+  });
+  nativePrint("DrawQueue: 1000 pooled meshes in %u draw call(s)\n", (ui32)pooledDrawCalls);
+#ifdef GL_FRAME_STATS
+  // One frame of the same queue, as seen by the binding layer
+  endFrame();
+  GLStub::reset();
+  for (int i = 0; i < 1000; ++i) {
+    ui32 hash = (ui32)i * 2654435761U;
+    DrawItem item;
+    item.program = programs[(hash >> 8) & 3];
+    item.pipelineState = queueStates[((hash >> 16) & 7) == 0];
+    item.textures[0] = textures[(hash >> 20) & 7];
+    item.numTextures = 1;
+    geometry.setDraw(meshes[i % NUM_MESHES], item);
+    queue.add(item, 0, (float)(hash & 255));
+  }
+  queue.submit();
+  endFrame();
+  const FrameStats& frameStats = getFrameStats();
+  nativePrint("FrameStats: %u draws, %u triangles, %u program switches, %u VAO binds, %u texture binds, "
+              "%u redundant binds, %u KB buffer uploads\n", frameStats.draws, frameStats.triangles,
+              frameStats.programSwitches, frameStats.vertexArrayBinds, frameStats.textureBinds,
+              frameStats.redundantBinds, frameStats.bufferBytes >> 10);
+  // The counters agree with the calls that reached GL
+  expect(frameStats.draws == queue.drawCalls(), "FrameStats: draws");
+  expect(frameStats.programSwitches == GLStub::stats.calls[GLStub::CALL_glUseProgram], "FrameStats: program switches");
+  expect(frameStats.vertexArrayBinds == GLStub::stats.calls[GLStub::CALL_glBindVertexArray], "FrameStats: VAO binds");
+  expect(frameStats.textureBinds == GLStub::stats.calls[GLStub::CALL_glBindTexture], "FrameStats: texture binds");
+#endif
+  for (int i = 0; i < NUM_MESHES; i += 2) {
+    geometry.free(meshes[i]);
+  }
+  GLStub::reset();
+  ui32 compacted = geometry.compact();
+  nativePrint("GeometryPool: freed half, compacted %u arenas with %u copies and %u index uploads\n", compacted,
+              (ui32)GLStub::stats.calls[GLStub::CALL_glCopyBufferSubData], (ui32)GLStub::stats.calls[GLStub::CALL_glBufferSubData]);
+
+  // Domino scene: 500 identical boxes per frame with a model matrix and color each
+  struct BoxInstance {
+    float model[16];
+    float color[4];
+  };
+  static BoxInstance boxInstances[500];
+  VertexLayout instanceLayout;
+  for (ui32 i = 0; i < 5; ++i) {
+    instanceLayout.add(8 + i, 4, GL_FLOAT, false, i * 16);
+  }
+  instanceLayout.stride = sizeof(BoxInstance);
+  StreamBuffer* instanceStream = StreamBuffer::create(1 << 20);
+  queue.setInstancing(instanceStream, instanceLayout);
+  size_t boxDrawCalls = 0;
+  measure("DrawQueue (500 boxes per frame, instanced)", [&](int i) {
+    DrawItem item;
+    item.program = programs[0];
+    item.vertexArray = vertexArrays[0];
+    item.pipelineState = queueStates[0];
+    item.indexType = GL_UNSIGNED_SHORT;
+    item.count = 36;
+    item.instanceData = &boxInstances[i % 500];
+    queue.add(item, 0, (float)(i % 500));
+    if (queue.size() == 500) {
+      queue.submit();
+      boxDrawCalls = queue.drawCalls();
+      endFrame();
+    }
+  });
+  nativePrint("DrawQueue: 500 boxes in %u draw call(s)\n", (ui32)boxDrawCalls);
+
+  // Debug line geometry rewritten every frame, 100 writes of 1KB per frame
+  static char lineData[1024];
+  StreamBuffer* lines = StreamBuffer::create(1 << 20);
+  measure("StreamBuffer::write (fences signaled)", [&](int i) {
+    if (i % 100 == 0) {
+      endFrame();
+    }
+    lines->write(lineData, sizeof lineData);
+  });
+  GLStub::config.syncSignaled = false;
+  measure("StreamBuffer::write (GPU behind)", [&](int i) {
+    if (i % 100 == 0) {
+      endFrame();
+    }
+    lines->write(lineData, sizeof lineData);
+  });
+  GLStub::config.syncSignaled = true;
+  nativePrint("StreamBuffer: %u orphans\n", lines->orphans());
+
+  // GPU picking: one 1x1 read per frame, delivered a frame later
+  ReadbackQueue readbacks;
+  measure("ReadbackQueue (1x1 pick per frame)", [&](int) {
+    readbacks.poll();
+    readbacks.read(frameBuffers[0], GL_COLOR_ATTACHMENT0, 16, 16, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, onReadback);
+    endFrame();
+  });
+  nativePrint("ReadbackQueue: %u delivered, %u pending\n", readbacksDelivered, (ui32)readbacks.pending());
+
+  // Deferred renderer frame: 5 passes, 3 of them nested under "lighting"
+  GpuProfiler profiler;
+  measure("GpuProfiler (deferred frame, 7 scopes)", [&](int) {
+    profiler.beginFrame();
+    profiler.begin("gbuffer");
+    profiler.end();
+    profiler.begin("shadows");
+    profiler.end();
+    profiler.begin("lighting");
+    profiler.begin("lights");
+    profiler.end();
+    profiler.begin("ssr");
+    profiler.end();
+    profiler.end();
+    profiler.begin("fxaa");
+    profiler.end();
+    profiler.endFrame();
+    endFrame();
+  });
+  const float* profile = profiler.exportStats();
+  for (ui32 i = 0; i < profiler.numScopes(); ++i, profile += GpuProfiler::EXPORT_STRIDE) {
+    nativePrint("GpuProfiler: %*s%s avg %.3f ms\n", (int) profile[GpuProfiler::EXPORT_DEPTH] * 2, "",
+                profiler.scopeName(i), profile[GpuProfiler::EXPORT_AVG]);
+  }
+
+  // Interior scene: 1000 objects behind a wall, every query reports them hidden
+  OcclusionCuller culler;
+  for (int i = 0; i < 1000; ++i) {
+    float min[3] = {(float)(i % 10), 0.0f, (float)(i / 10)};
+    float max[3] = {min[0] + 0.5f, 2.0f, min[2] + 0.5f};
+    culler.add(min, max);
+  }
+  const float eye[3] = {-10.0f, 1.0f, -10.0f};
+  GLStub::config.queryResult = 0;
+  measure("OcclusionCuller (1000 objects, per frame)", [&](int i) {
+    if (i % 1000 == 0) {
+      culler.beginFrame(matrix, eye, 0.1f);
+    }
+    if (culler.visible(i % 1000)) {
+      glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
+    }
+    if (i % 1000 == 999) {
+      culler.test();
+      endFrame();
+    }
+  });
+  GLStub::config.queryResult = 100000;
+  const OcclusionCuller::Stats& cullStats = culler.stats();
+  nativePrint("OcclusionCuller: %u objects, %u culled, %u tested\n",
+              cullStats.objects, cullStats.culled, cullStats.tested);
+
+  // Level load: 16 material permutations of one shader pair, requested again every draw
+  static const char* const Permutations[] = {
+    "", "#define SKINNED\n", "#define NORMAL_MAP\n", "#define SKINNED\n#define NORMAL_MAP\n",
+  };
+  GLStub::reset();
+  Program* materials[16];
+  for (int i = 0; i < 16; ++i) {
+    materials[i] = Program::build("#version 300 es\nvoid main() {}\n",
+                                  i < 4 ? "#version 300 es\nvoid main() {}\n" : "#version 300 es\nvoid main() { }\n",
+                                  Permutations[i & 3]);
+  }
+  nativePrint("Program cache: %u shaders compiled, %u programs linked for 16 requests\n",
+              (ui32)GLStub::stats.calls[GLStub::CALL_glCompileShader], (ui32)GLStub::stats.calls[GLStub::CALL_glLinkProgram]);
+  // 4 permutations of one vertex and two fragment sources
+  expect(GLStub::stats.calls[GLStub::CALL_glCompileShader] == 12, "Program cache: 12 shaders compiled");
+  expect(GLStub::stats.calls[GLStub::CALL_glLinkProgram] == 8, "Program cache: 8 programs linked");
+  ui32 readyFrames = 0;
+  while (!materials[0]->ready()) {
+    endFrame();
+    ++readyFrames;
+  }
+  nativePrint("Program cache: ready after %u frame(s)\n", readyFrames);
+  expect(readyFrames == 1, "Program cache: ready after 1 frame");
+  measure("Program::build (cached)", [&](int i) {
+    Program::build("#version 300 es\nvoid main() {}\n", "#version 300 es\nvoid main() {}\n", Permutations[i & 3])->release();
+  });
+  expectCalls(0);
+  for (int i = 0; i < 16; ++i) {
+    materials[i]->release();
+  }
+
+  // Material shader with 5 feature bits; 6 masks warmed up at load, 2 per frame
+  static const char* const MaterialFeatures[] = {
+    "HAS_NORMALS", "HAS_TANGENTS", "HAS_UV", "USE_NORMAL_MAP", "NUM_SKIN_MATRICES 32",
+  };
+  static const ui32 WarmUpMasks[] = {0x00, 0x01, 0x05, 0x0F, 0x15, 0x1F};
+  ShaderPermutations materialShader("#version 300 es\nvoid main() { gl_Position = vec4(0.0); }\n",
+                                    "#version 300 es\nvoid main() { gl_FragColor = vec4(0.0); }\n",
+                                    MaterialFeatures, sizeof(MaterialFeatures) / sizeof(MaterialFeatures[0]));
+  materialShader.warmUp(WarmUpMasks, sizeof(WarmUpMasks) / sizeof(WarmUpMasks[0]));
+  ui32 warmUpFrames = 0;
+  while (materialShader.update(2)) {
+    endFrame();
+    ++warmUpFrames;
+  }
+  nativePrint("ShaderPermutations: warm-up done after %u frames\n", warmUpFrames);
+  measure("ShaderPermutations::get (warm)", [&](int i) {
+    materialShader.get(i & 1 ? 0x05 : 0x0F);
+  });
+  materialShader.get(0x07);
+  ui32 unusedWarmUps = 0, missedWarmUps = 0;
+  for (size_t i = 0; i < materialShader.numPermutations(); ++i) {
+    const ShaderPermutations::Permutation& permutation = materialShader.permutation(i);
+    if (permutation.warmUp && !permutation.uses) {
+      ++unusedWarmUps;
+    } else if (!permutation.warmUp && permutation.uses) {
+      ++missedWarmUps;
+    }
+  }
+  nativePrint("ShaderPermutations: %u variants, %u warmed up but unused, %u used without warm-up\n",
+              (ui32)materialShader.numPermutations(), unusedWarmUps, missedWarmUps);
+
+  // 64 evictable 256x256 textures, 16 used per frame from a window that slides by 4,
+  // with room for about 24 under the budget
+  enum {
+    NUM_STREAMED = 64,
+  };
+  static ui32 streamedTexels[256 * 256];
+  Texture* streamed[NUM_STREAMED];
+  for (int i = 0; i < NUM_STREAMED; ++i) {
+    streamed[i] = Texture::create2D(GL_RGBA8, 256, 256, 0);
+    streamed[i]->setEvictable([](Texture* texture, void* data) {
+      texture->image2D(GL_RGBA, GL_UNSIGNED_BYTE, data);
+      texture->generateMipmap();
+    }, streamedTexels);
+  }
+  setMemoryBudget(getMemoryStats().total - 40 * streamed[0]->memorySize());
+  measure("bindTexture (evictable, over budget)", [&](int i) {
+    int frame = i / 16;
+    bindTexture(GL_TEXTURE_2D, streamed[(frame * 4 + i % 16) % NUM_STREAMED], i & 7);
+    if (i % 16 == 15) {
+      endFrame();
+    }
+  });
+  expectCalls(1, GLStub::CALL_glActiveTexture);
+  expectCalls(1, GLStub::CALL_glBindTexture);
+  expectCalls(0.25, GLStub::CALL_glCreateTexture);
+  expectCalls(3.25);
+  // An evicted texture restored by bindTextures must not replace one the draw already uses
+  Texture* resident = nullptr;
+  Texture* evicted = nullptr;
+  for (int i = 0; i < NUM_STREAMED; ++i) {
+    if (streamed[i]->resident()) {
+      resident = streamed[i];
+    } else {
+      evicted = streamed[i];
+    }
+  }
+  expect(resident && evicted, "bindTexture (evictable): textures both resident and evicted");
+  if (resident && evicted) {
+    Texture* draw[2] = {resident, evicted};
+    ui32 units[2];
+    bindTexture(GL_TEXTURE_2D, resident, 0);
+    bindTextures(draw, 2, units);
+    expect(getTextureBinding(GL_TEXTURE_2D, units[0]) == resident && getTextureBinding(GL_TEXTURE_2D, units[1]) == evicted,
+           "bindTextures: restoring an evicted texture keeps the other bindings");
+  }
+  const MemoryStats& memory = getMemoryStats();
+  nativePrint("Memory: %u KB textures, %u KB vertex, %u KB index, %u KB uniform, %u KB peak\n",
+              (ui32)(memory.bytes[MEMORY_TEXTURE] >> 10), (ui32)(memory.bytes[MEMORY_VERTEX] >> 10),
+              (ui32)(memory.bytes[MEMORY_INDEX] >> 10), (ui32)(memory.bytes[MEMORY_UNIFORM] >> 10), (ui32)(memory.peak >> 10));
+  nativePrint("Memory: %u evictions, %u reloads, %u KB over budget\n", memory.evictions, memory.reloads,
+              (ui32)(memory.total > getMemoryBudget() ? (memory.total - getMemoryBudget()) >> 10 : 0));
+  expect(memory.total <= getMemoryBudget(), "Memory: within budget");
+  setMemoryBudget(0);
+  for (int i = 0; i < NUM_STREAMED; ++i) {
+    streamed[i]->release();
+  }
+
+  // Deferred frame: gbuffer, light accumulation, SSR and FXAA targets, resized every
+  // 100000 frames. The gbuffer normals are recycled after lighting, so SSR reuses them.
+  RenderTargetPool targetPool;
+  measure("RenderTargetPool (deferred frame)", [&](int i) {
+    size_t width = 1280 + (i / 100000) * 16;
+    size_t height = 720;
+    GLenum gbufferAttachments[4] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_DEPTH_ATTACHMENT};
+    GLBase* gbuffer[4] = {
+      targetPool.acquireTexture(GL_RGBA8, width, height),
+      targetPool.acquireTexture(GL_RGBA8, width, height),
+      targetPool.acquireTexture(GL_RGBA16F, width, height),
+      targetPool.acquireRenderBuffer(GL_DEPTH24_STENCIL8, width, height),
+    };
+    bindFrameBuffer(GL_FRAMEBUFFER, targetPool.frameBuffer(gbufferAttachments, gbuffer, 4));
+    GLenum colorDepth[2] = {GL_COLOR_ATTACHMENT0, GL_DEPTH_ATTACHMENT};
+    GLBase* light[2] = {targetPool.acquireTexture(GL_RGBA16F, width, height), gbuffer[3]};
+    bindFrameBuffer(GL_FRAMEBUFFER, targetPool.frameBuffer(colorDepth, light, 2));
+    targetPool.recycle(gbuffer[2]);
+    GLBase* ssr = targetPool.acquireTexture(GL_RGBA16F, width, height);
+    bindFrameBuffer(GL_FRAMEBUFFER, targetPool.frameBuffer(colorDepth, &ssr, 1));
+    GLBase* fxaa = targetPool.acquireTexture(GL_RGBA8, width, height);
+    bindFrameBuffer(GL_FRAMEBUFFER, targetPool.frameBuffer(colorDepth, &fxaa, 1));
+    targetPool.endFrame();
+  });
+  const RenderTargetPool::Stats& targetStats = targetPool.stats();
+  nativePrint("RenderTargetPool: %u targets, %u frame buffers, %u created, %u reused, %u deleted\n",
+              targetStats.targets, targetStats.frameBuffers, targetStats.created, targetStats.reused, targetStats.deleted);
+  expectCalls(4, GLStub::CALL_glBindFramebuffer);
+  expectCalls(4);
+  expect(targetStats.targets == 6 && targetStats.frameBuffers == 4, "RenderTargetPool: 6 targets, 4 frame buffers");
+  // Depth and 32-bit float targets can't be filtered linearly
+  Texture* depthTarget = targetPool.acquireTexture(GL_DEPTH_COMPONENT32F, 1024, 1024);
+  Texture* floatTarget = targetPool.acquireTexture(GL_RGBA32F, 1024, 1024);
+  expect(depthTarget->magFilter() == GL_NEAREST && floatTarget->minFilter() == GL_NEAREST,
+         "RenderTargetPool: nearest filtering for non-filterable formats");
+  Texture* colorTarget = targetPool.acquireTexture(GL_RGBA16F, 1024, 1024);
+  expect(colorTarget->magFilter() == GL_LINEAR, "RenderTargetPool: linear filtering for filterable formats");
+  targetPool.recycle(depthTarget);
+  targetPool.recycle(floatTarget);
+  targetPool.recycle(colorTarget);
+
+  // Same frame through a frame graph, plus a debug view nobody reads
+  RenderTargetPool graphPool;
+  FrameGraph graph(graphPool);
+  measure("FrameGraph (deferred frame, 7 passes)", [&](int) {
+    FrameGraph::Execute draw = [](FrameGraph&, void*) {};
+    ui32 shadow = graph.createTexture("shadow", GL_DEPTH_COMPONENT32F, 2048, 2048);
+    ui32 albedo = graph.createTexture("albedo", GL_RGBA8, 1280, 720);
+    ui32 normal = graph.createTexture("normal", GL_RGBA16F, 1280, 720);
+    ui32 depth = graph.createRenderBuffer("depth", GL_DEPTH24_STENCIL8, 1280, 720);
+    ui32 hdr = graph.createTexture("hdr", GL_RGBA16F, 1280, 720);
+    ui32 ldr = graph.createTexture("ldr", GL_RGBA8, 1280, 720);
+    ui32 debug = graph.createTexture("debug", GL_RGBA8, 1280, 720);
+    ui32 pass = graph.addPass("shadow", draw);
+    graph.write(pass, shadow, GL_DEPTH_ATTACHMENT);
+    pass = graph.addPass("gbuffer", draw);
+    graph.write(pass, albedo, GL_COLOR_ATTACHMENT0);
+    graph.write(pass, normal, GL_COLOR_ATTACHMENT1);
+    graph.write(pass, depth, GL_DEPTH_ATTACHMENT);
+    pass = graph.addPass("debug normals", draw);
+    graph.read(pass, normal);
+    graph.write(pass, debug, GL_COLOR_ATTACHMENT0);
+    pass = graph.addPass("lighting", draw);
+    graph.read(pass, albedo);
+    graph.read(pass, normal);
+    graph.read(pass, shadow);
+    graph.write(pass, hdr, GL_COLOR_ATTACHMENT0);
+    graph.write(pass, depth, GL_DEPTH_ATTACHMENT);
+    pass = graph.addPass("tonemap", draw);
+    graph.read(pass, hdr);
+    graph.write(pass, ldr, GL_COLOR_ATTACHMENT0);
+    pass = graph.addPass("fxaa", draw);
+    graph.read(pass, ldr);
+    graph.writeBackBuffer(pass);
+    pass = graph.addPass("unused", draw);
+    graph.write(pass, debug, GL_COLOR_ATTACHMENT0);
+    graph.execute();
+    graphPool.endFrame();
+  });
+  const FrameGraph::Stats& graphStats = graph.stats();
+  nativePrint("FrameGraph: %u passes, %u culled, %u targets in %u pooled, %u attachments invalidated\n", graphStats.passes,
+              graphStats.culled, graphStats.targets, graphPool.stats().targets, graphStats.invalidated);
+  expectCalls(9, GLStub::CALL_glBindFramebuffer);
+  expectCalls(6, GLStub::CALL_glInvalidateFramebuffer);
+  expectCalls(15);
+  // "debug normals" and "unused" are culled; ldr reuses the target of albedo
+  expect(graphStats.passes == 7 && graphStats.culled == 2, "FrameGraph: 7 passes, 2 culled");
+  expect(graphStats.targets == 6 && graphPool.stats().targets == 5, "FrameGraph: 6 targets in 5 pooled");
+  expect(graphStats.invalidated == 6, "FrameGraph: 6 attachments invalidated");
+
+  // Scratch buffers released right after use, 100 per frame; the deletes run in a batch
+  // at the end of a later frame
+  measure("Buffer::create + release (deferred destroy)", [&](int i) {
+    if (i % 100 == 0) {
+      endFrame();
+    }
+    Buffer::create(1024, nullptr, GL_STREAM_DRAW)->release();
+  });
+  const DestroyStats& destroyStats = getDestroyStats();
+  nativePrint("DestroyQueue: %u pending, %u destroyed, %u revived\n", destroyStats.pending, destroyStats.destroyed,
+              destroyStats.revived);
+  expectCalls(1, GLStub::CALL_glCreateBuffer);
+  expectCalls(1, GLStub::CALL_glDeleteBuffer);
+  // Released in the last two frames, whose fences haven't been checked yet
+  expect(destroyStats.pending == 200, "DestroyQueue: 200 pending");
+  // A GPU that falls behind by more frames than there are fences
+  ui32 destroyedBefore = destroyStats.destroyed;
+  GLStub::config.syncSignaled = false;
+  for (int i = 0; i < MAX_DESTROY_FENCES * 2; ++i) {
+    Buffer::create(1024, nullptr, GL_STREAM_DRAW)->release();
+    endFrame();
+  }
+  expect(destroyStats.destroyed == destroyedBefore, "DestroyQueue: nothing destroyed before its fence signals");
+  GLStub::config.syncSignaled = true;
+  endFrame();
+  expect(destroyStats.pending == 0, "DestroyQueue: everything destroyed once the fences signal");
+
+  PipelineDesc opaqueDesc;
+  opaqueDesc.setDepth(GL_LEQUAL);
+  opaqueDesc.setCull(GL_BACK);
+  PipelineDesc translucentDesc = opaqueDesc;
+  translucentDesc.setBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  translucentDesc.depthMask = 0;
+  PipelineState* opaque = PipelineState::create(opaqueDesc);
+  PipelineState* translucent = PipelineState::create(translucentDesc);
+  PipelineState* interned = PipelineState::create(opaqueDesc);
+  nativePrint("PipelineState interning: %s\n", interned == opaque ? "shared" : "DISTINCT");
+  expect(interned == opaque, "PipelineState interning");
+  interned->release();
+
+  measure("setPipelineState (same)", [&](int) {
+    setPipelineState(opaque);
+  });
+  expectCalls(0);
+  measure("setPipelineState (opaque/translucent)", [&](int i) {
+    setPipelineState(i & 1 ? translucent : opaque);
+  });
+  expectCalls(1, GLStub::CALL_glDepthMask);
+  expectCalls(2);
+  measure("setPipelineState (opaque/defaults)", [&](int i) {
+    setPipelineState(i & 1 ? nullptr : opaque);
+  });
+  expectCalls(2);
+  measure("PipelineState::create (existing)", [&](int) {
+    PipelineState::create(translucentDesc)->release();
+  });
+  expectCalls(0);
+  endFrame();
+  const StateStats& stateStats = getStateStats();
+  nativePrint("State changes %u, calls issued %u, calls elided %u\n",
+              stateStats.stateChanges, stateStats.callsIssued, stateStats.callsElided);
+
+  // The bench keeps most of its objects to the end, so these are expected
+  shutdown();
+  nativePrint("Shutdown: %u objects still alive, %u leak reports\n", (ui32)GLBase::handles().size(),
+              (ui32)GLStub::stats.calls[GLStub::CALL_glReportLeaks]);
+
+  if (failures) {
+    nativePrint("%d check(s) FAILED\n", failures);
+    return 1;
+  }
+  return 0;
+}
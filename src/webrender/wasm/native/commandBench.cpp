@@ -0,0 +1,45 @@
+#include "../webgl.h"
+#include "native.h"
+
+// Encode throughput of the command buffer: a typical per-draw sequence (program, VAO, two
+// textures, a matrix and a vector uniform, draw) encoded FRAMES * DRAWS times with one
+// flush per frame.
+
+static const int FRAMES = 1000;
+static const int DRAWS = 2000;
+
+class BenchObject : public WebGL::Object<BenchObject> {
+};
+
+int main() {
+  static BenchObject program, vertexArray, texture0, texture1;
+  static float matrix[16];
+  for (int i = 0; i < 16; ++i) {
+    matrix[i] = (float)i;
+  }
+
+  unsigned long long start = nativeTime();
+  for (int frame = 0; frame < FRAMES; ++frame) {
+    for (int draw = 0; draw < DRAWS; ++draw) {
+      glUseProgram(&program);
+      glBindVertexArray(&vertexArray);
+      glActiveTexture(GL_TEXTURE0);
+      glBindTexture(GL_TEXTURE_2D, &texture0);
+      glActiveTexture(GL_TEXTURE1);
+      glBindTexture(GL_TEXTURE_2D, &texture1);
+      glUniformMatrix4fv(0, 1, false, matrix);
+      glUniform4f(1, 1.0f, 0.5f, 0.25f, (float)draw);
+      glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_SHORT, 0);
+    }
+    GLCommands::flush();
+  }
+  unsigned long long elapsed = nativeTime() - start;
+
+  const CommandStubStats& stats = commandStubStats;
+  nativePrint("commands: %llu in %llu flushes (%llu words)\n", stats.commands, stats.flushes, stats.words);
+  nativePrint("encode+decode: %.2f ns/command, %.2f ns/draw, %.1f MB/s\n",
+              (double)elapsed / stats.commands,
+              (double)elapsed / ((double)FRAMES * DRAWS),
+              stats.words * sizeof(ui32) * 1000.0 / elapsed);
+  return 0;
+}
@@ -0,0 +1,23 @@
+#include "../commandBuffer.h"
+#include "native.h"
+
+// Native stand-in for the JS command decoder: walks the stream, validates every header and
+// counts commands per opcode. Used to measure encode throughput without a GL context.
+
+CommandStubStats commandStubStats;
+
+void glExecuteCommands(const ui32* commands, size_t size) {
+  const ui32* end = commands + size;
+  commandStubStats.flushes += 1;
+  commandStubStats.words += size;
+  while (commands < end) {
+    ui32 opcode = commands[0] & 0xFF;
+    ui32 length = commands[0] >> 8;
+    if (opcode == 0 || opcode >= GLCommands::NUM_COMMANDS || commands + 1 + length > end) {
+      error("glExecuteCommands: malformed command stream");
+    }
+    commandStubStats.commands += 1;
+    commandStubStats.opcodes[opcode] += 1;
+    commands += 1 + length;
+  }
+}
@@ -0,0 +1,1570 @@
+#undef GL_COMMAND_BUFFER
+#include "glStub.h"
+
+#define RECORD(name) (GLStub::stats.total++, GLStub::stats.calls[GLStub::CALL_##name]++)
+
+namespace GLStub
+{
+
+const char* const functionNames[NUM_FUNCTIONS] = {
+  "glVersion",
+  "glCanvasWidth",
+  "glCanvasHeight",
+  "glIsContextLost",
+  "glScissor",
+  "glViewport",
+  "glActiveTexture",
+  "glBlendColor",
+  "glBlendEquation",
+  "glBlendEquationSeparate",
+  "glBlendFunc",
+  "glBlendFuncSeparate",
+  "glClearColor",
+  "glClearDepth",
+  "glClearStencil",
+  "glColorMask",
+  "glCullFace",
+  "glDepthFunc",
+  "glDepthMask",
+  "glDepthRange",
+  "glDisable",
+  "glEnable",
+  "glFrontFace",
+  "glGetError",
+  "glHint",
+  "glIsEnabled",
+  "glLineWidth",
+  "glPixelStorei",
+  "glPolygonOffset",
+  "glSampleCoverage",
+  "glStencilFunc",
+  "glStencilFuncSeparate",
+  "glStencilMask",
+  "glStencilMaskSeparate",
+  "glStencilOp",
+  "glStencilOpSeparate",
+  "glGetBoolean",
+  "glGetInteger",
+  "glGetFloat",
+  "glGetDouble",
+  "glGetIntegerv",
+  "glGetBooleanv",
+  "glGetFloatv",
+  "glGetDoublev",
+  "glGetString",
+  "glGetIntegeri",
+  "glGetIntegeri_v",
+  "glBindBuffer",
+  "glBufferData",
+  "glBufferSubData",
+  "glCreateBuffer",
+  "glDeleteBuffer",
+  "glGetBufferParameter",
+  "glIsBuffer",
+  "glCopyBufferSubData",
+  "glGetBufferSubData",
+  "glBindFramebuffer",
+  "glCheckFramebufferStatus",
+  "glCreateFramebuffer",
+  "glDeleteFramebuffer",
+  "glFramebufferRenderbuffer",
+  "glFramebufferTexture2D",
+  "glGetFramebufferAttachmentParameter",
+  "glIsFramebuffer",
+  "glReadPixels",
+  "glReadPixelsBuffer",
+  "glBlitFramebuffer",
+  "glFramebufferTextureLayer",
+  "glInvalidateFramebuffer",
+  "glInvalidateSubFramebuffer",
+  "glReadBuffer",
+  "glBindRenderbuffer",
+  "glCreateRenderbuffer",
+  "glDeleteRenderbuffer",
+  "glGetRenderbufferParameter",
+  "glIsRenderbuffer",
+  "glRenderbufferStorage",
+  "glGetInternalformativ",
+  "glRenderbufferStorageMultisample",
+  "glBindTexture",
+  "glCompressedTexImage2D",
+  "glCompressedTexImage2DBuffer",
+  "glCompressedTexSubImage2D",
+  "glCompressedTexSubImage2DBuffer",
+  "glCopyTexImage2D",
+  "glCopyTexSubImage2D",
+  "glCreateTexture",
+  "glDeleteTexture",
+  "glGenerateMipmap",
+  "glGetTexParameteri",
+  "glGetTexParameterf",
+  "glGetTexParameteriv",
+  "glGetTexParameterfv",
+  "glIsTexture",
+  "glTexImage2D",
+  "glTexImage2DBuffer",
+  "glTexSubImage2D",
+  "glTexSubImage2DBuffer",
+  "glTexParameteri",
+  "glTexParameterf",
+  "glTexStorage2D",
+  "glTexStorage3D",
+  "glTexImage3D",
+  "glTexImage3DBuffer",
+  "glTexSubImage3D",
+  "glTexSubImage3DBuffer",
+  "glCompressedTexImage3D",
+  "glCompressedTexImage3DBuffer",
+  "glCompressedTexSubImage3D",
+  "glCompressedTexSubImage3DBuffer",
+  "glAttachShader",
+  "glBindAttribLocation",
+  "glCompileShader",
+  "glCreateProgram",
+  "glCreateShader",
+  "glDeleteProgram",
+  "glDeleteShader",
+  "glDetachShader",
+  "glGetAttachedShaders",
+  "glGetProgrami",
+  "glGetProgramInfoLog",
+  "glGetShaderi",
+  "glGetShaderPrecisionFormat",
+  "glGetShaderInfoLog",
+  "glGetShaderSource",
+  "glIsProgram",
+  "glIsShader",
+  "glLinkProgram",
+  "glShaderSource",
+  "glUseProgram",
+  "glValidateProgram",
+  "glGetFragDataLocation",
+  "glDisableVertexAttribArray",
+  "glEnableVertexAttribArray",
+  "glGetActiveAttrib",
+  "glGetActiveUniform",
+  "glGetAttribLocation",
+  "glGetUniformfv",
+  "glGetUniformiv",
+  "glGetUniformuiv",
+  "glGetUniformLocation",
+  "glGetVertexAttribi",
+  "glGetVertexAttribiv",
+  "glGetVertexAttribIiv",
+  "glGetVertexAttribIuiv",
+  "glGetVertexAttribfv",
+  "glGetVertexAttribdv",
+  "glGetVertexAttribOffset",
+  "glUniform1f",
+  "glUniform2f",
+  "glUniform3f",
+  "glUniform4f",
+  "glUniform1i",
+  "glUniform2i",
+  "glUniform3i",
+  "glUniform4i",
+  "glUniform1ui",
+  "glUniform2ui",
+  "glUniform3ui",
+  "glUniform4ui",
+  "glUniform1fv",
+  "glUniform2fv",
+  "glUniform3fv",
+  "glUniform4fv",
+  "glUniform1iv",
+  "glUniform2iv",
+  "glUniform3iv",
+  "glUniform4iv",
+  "glUniform1uiv",
+  "glUniform2uiv",
+  "glUniform3uiv",
+  "glUniform4uiv",
+  "glUniformMatrix2fv",
+  "glUniformMatrix3fv",
+  "glUniformMatrix4fv",
+  "glUniformMatrix2x3fv",
+  "glUniformMatrix3x2fv",
+  "glUniformMatrix2x4fv",
+  "glUniformMatrix4x2fv",
+  "glUniformMatrix3x4fv",
+  "glUniformMatrix4x3fv",
+  "glVertexAttrib1f",
+  "glVertexAttrib2f",
+  "glVertexAttrib3f",
+  "glVertexAttrib4f",
+  "glVertexAttrib1fv",
+  "glVertexAttrib2fv",
+  "glVertexAttrib3fv",
+  "glVertexAttrib4fv",
+  "glVertexAttribPointer",
+  "glVertexAttribI4i",
+  "glVertexAttribI4iv",
+  "glVertexAttribI4ui",
+  "glVertexAttribI4uiv",
+  "glVertexAttribIPointer",
+  "glClear",
+  "glDrawArrays",
+  "glDrawElements",
+  "glFinish",
+  "glFlush",
+  "glVertexAttribDivisor",
+  "glDrawArraysInstanced",
+  "glDrawElementsInstanced",
+  "glDrawRangeElements",
+  "glDrawBuffers",
+  "glClearBufferiv",
+  "glClearBufferuiv",
+  "glClearBufferfv",
+  "glClearBufferfi",
+  "glCreateQuery",
+  "glDeleteQuery",
+  "glIsQuery",
+  "glBeginQuery",
+  "glEndQuery",
+  "glGetQuery",
+  "glGetQueryiv",
+  "glGetQueryParameter",
+  "glGetQueryObjectiv",
+  "glGetQueryObjectuiv",
+  "glCreateSampler",
+  "glDeleteSampler",
+  "glBindSampler",
+  "glIsSampler",
+  "glSamplerParameteri",
+  "glSamplerParameterf",
+  "glGetSamplerParameteri",
+  "glGetSamplerParameterf",
+  "glGetSamplerParameteriv",
+  "glGetSamplerParameterfv",
+  "glFenceSync",
+  "glDeleteSync",
+  "glIsSync",
+  "glClientWaitSync",
+  "glWaitSync",
+  "glGetSynci",
+  "glGetSynciv",
+  "glCreateTransformFeedback",
+  "glDeleteTransformFeedback",
+  "glIsTransformFeedback",
+  "glBindTransformFeedback",
+  "glBeginTransformFeedback",
+  "glEndTransformFeedback",
+  "glTransformFeedbackVaryings",
+  "glGetTransformFeedbackVarying",
+  "glPauseTransformFeedback",
+  "glResumeTransformFeedback",
+  "glBindBufferBase",
+  "glBindBufferRange",
+  "glGetUniformIndices",
+  "glGetActiveUniformsiv",
+  "glGetUniformBlockIndex",
+  "glGetActiveUniformBlockiv",
+  "glGetActiveUniformBlockName",
+  "glUniformBlockBinding",
+  "glCreateVertexArray",
+  "glDeleteVertexArray",
+  "glIsVertexArray",
+  "glBindVertexArray",
+  "glGetExtension",
+  "glQueryCounter",
+  "glGetTranslatedShaderSource",
+  "glLoseContext",
+  "glRestoreContext",
+  "glMultiDrawArrays",
+  "glMultiDrawElements",
+  "glMultiDrawElementsInstanced",
+  "glFrameStats",
+  "glSaveTrace",
+  "glReportLeaks",
+};
+
+Config config = {
+  2,
+  1280,
+  720,
+  true,
+  32,
+  256,
+  nullptr,
+  0,
+  nullptr,
+  0,
+  true,
+  100000,
+  false,
+};
+
+Stats stats;
+
+void reset() {
+  memset(&stats, 0, sizeof stats);
+}
+
+GLint getInteger(GLenum pname) {
+  switch (pname) {
+  case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+  case GL_MAX_TEXTURE_IMAGE_UNITS:
+    return config.maxTextureUnits;
+  case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+    return config.uniformBufferOffsetAlignment;
+  case GL_GPU_DISJOINT:
+    return config.gpuDisjoint;
+  default:
+    return 0;
+  }
+}
+
+GLint getProgrami(GLptr, GLenum pname) {
+  switch (pname) {
+  case GL_LINK_STATUS:
+  case GL_VALIDATE_STATUS:
+  case GL_COMPLETION_STATUS_KHR:
+    return 1;
+  case GL_ACTIVE_UNIFORMS:
+    return config.numUniforms;
+  default:
+    return 0;
+  }
+}
+
+static bool nameEqual(const char* lhs, const char* rhs) {
+  while (*lhs && *lhs == *rhs) {
+    ++lhs;
+    ++rhs;
+  }
+  return *lhs == *rhs;
+}
+
+const UniformInfo* findUniform(const GLchar* name) {
+  for (size_t i = 0; i < config.numUniforms; ++i) {
+    if (nameEqual(config.uniforms[i].name, name)) {
+      return &config.uniforms[i];
+    }
+  }
+  return nullptr;
+}
+
+GLint findUniformBlock(const GLchar* name) {
+  for (size_t i = 0; i < config.numUniformBlocks; ++i) {
+    if (nameEqual(config.uniformBlocks[i].name, name)) {
+      return (GLint)i;
+    }
+  }
+  return -1;
+}
+
+GLint getShaderi(GLptr, GLenum pname) {
+  switch (pname) {
+  case GL_COMPILE_STATUS:
+    return 1;
+  default:
+    return 0;
+  }
+}
+
+}
+
+GLint glVersion() {
+  RECORD(glVersion);
+  return GLStub::config.version;
+}
+
+GLsizei glCanvasWidth() {
+  RECORD(glCanvasWidth);
+  return GLStub::config.canvasWidth;
+}
+
+GLsizei glCanvasHeight() {
+  RECORD(glCanvasHeight);
+  return GLStub::config.canvasHeight;
+}
+
+GLboolean glIsContextLost() {
+  RECORD(glIsContextLost);
+  return true;
+}
+
+void glScissor(GLint, GLint, GLsizei, GLsizei) {
+  RECORD(glScissor);
+}
+
+void glViewport(GLint, GLint, GLsizei, GLsizei) {
+  RECORD(glViewport);
+}
+
+void glActiveTexture(GLenum) {
+  RECORD(glActiveTexture);
+}
+
+void glBlendColor(GLclampf, GLclampf, GLclampf, GLclampf) {
+  RECORD(glBlendColor);
+}
+
+void glBlendEquation(GLenum) {
+  RECORD(glBlendEquation);
+}
+
+void glBlendEquationSeparate(GLenum, GLenum) {
+  RECORD(glBlendEquationSeparate);
+}
+
+void glBlendFunc(GLenum, GLenum) {
+  RECORD(glBlendFunc);
+}
+
+void glBlendFuncSeparate(GLenum, GLenum, GLenum, GLenum) {
+  RECORD(glBlendFuncSeparate);
+}
+
+void glClearColor(GLclampf, GLclampf, GLclampf, GLclampf) {
+  RECORD(glClearColor);
+}
+
+void glClearDepth(GLclampf) {
+  RECORD(glClearDepth);
+}
+
+void glClearStencil(GLint) {
+  RECORD(glClearStencil);
+}
+
+void glColorMask(GLboolean, GLboolean, GLboolean, GLboolean) {
+  RECORD(glColorMask);
+}
+
+void glCullFace(GLenum) {
+  RECORD(glCullFace);
+}
+
+void glDepthFunc(GLenum) {
+  RECORD(glDepthFunc);
+}
+
+void glDepthMask(GLboolean) {
+  RECORD(glDepthMask);
+}
+
+void glDepthRange(GLclampf, GLclampf) {
+  RECORD(glDepthRange);
+}
+
+void glDisable(GLenum) {
+  RECORD(glDisable);
+}
+
+void glEnable(GLenum) {
+  RECORD(glEnable);
+}
+
+void glFrontFace(GLenum) {
+  RECORD(glFrontFace);
+}
+
+GLenum glGetError() {
+  RECORD(glGetError);
+  return 0;
+}
+
+void glHint(GLenum, GLenum) {
+  RECORD(glHint);
+}
+
+void glIsEnabled(GLenum) {
+  RECORD(glIsEnabled);
+}
+
+void glLineWidth(GLfloat) {
+  RECORD(glLineWidth);
+}
+
+void glPixelStorei(GLenum, GLint) {
+  RECORD(glPixelStorei);
+}
+
+void glPolygonOffset(GLfloat, GLfloat) {
+  RECORD(glPolygonOffset);
+}
+
+void glSampleCoverage(GLclampf, GLboolean) {
+  RECORD(glSampleCoverage);
+}
+
+void glStencilFunc(GLenum, GLint, GLuint) {
+  RECORD(glStencilFunc);
+}
+
+void glStencilFuncSeparate(GLenum, GLenum, GLint, GLuint) {
+  RECORD(glStencilFuncSeparate);
+}
+
+void glStencilMask(GLuint) {
+  RECORD(glStencilMask);
+}
+
+void glStencilMaskSeparate(GLenum, GLuint) {
+  RECORD(glStencilMaskSeparate);
+}
+
+void glStencilOp(GLenum, GLenum, GLenum) {
+  RECORD(glStencilOp);
+}
+
+void glStencilOpSeparate(GLenum, GLenum, GLenum, GLenum) {
+  RECORD(glStencilOpSeparate);
+}
+
+GLboolean glGetBoolean(GLenum) {
+  RECORD(glGetBoolean);
+  return true;
+}
+
+GLint glGetInteger(GLenum pname) {
+  RECORD(glGetInteger);
+  return GLStub::getInteger(pname);
+}
+
+GLfloat glGetFloat(GLenum) {
+  RECORD(glGetFloat);
+  return 0;
+}
+
+GLdouble glGetDouble(GLenum) {
+  RECORD(glGetDouble);
+  return 0;
+}
+
+void glGetIntegerv(GLenum, GLint*) {
+  RECORD(glGetIntegerv);
+}
+
+void glGetBooleanv(GLenum, GLboolean*) {
+  RECORD(glGetBooleanv);
+}
+
+void glGetFloatv(GLenum, GLfloat*) {
+  RECORD(glGetFloatv);
+}
+
+void glGetDoublev(GLenum, GLdouble*) {
+  RECORD(glGetDoublev);
+}
+
+void glGetString(GLenum, GLsizei, GLsizei*, GLchar*) {
+  RECORD(glGetString);
+}
+
+GLint glGetIntegeri(GLenum, GLuint) {
+  RECORD(glGetIntegeri);
+  return 0;
+}
+
+void glGetIntegeri_v(GLenum, GLuint, GLint*) {
+  RECORD(glGetIntegeri_v);
+}
+
+void glBindBuffer(GLenum, GLptr) {
+  RECORD(glBindBuffer);
+}
+
+void glBufferData(GLenum, GLsizeiptr, const GLvoid*, GLenum) {
+  RECORD(glBufferData);
+}
+
+void glBufferSubData(GLenum, GLintptr, GLsizeiptr, const GLvoid*) {
+  RECORD(glBufferSubData);
+}
+
+void glCreateBuffer(GLptr) {
+  RECORD(glCreateBuffer);
+}
+
+void glDeleteBuffer(GLptr) {
+  RECORD(glDeleteBuffer);
+}
+
+GLint glGetBufferParameter(GLenum, GLenum) {
+  RECORD(glGetBufferParameter);
+  return 0;
+}
+
+GLboolean glIsBuffer(GLptr) {
+  RECORD(glIsBuffer);
+  return true;
+}
+
+void glCopyBufferSubData(GLenum, GLenum, GLintptr, GLintptr, GLsizeiptr) {
+  RECORD(glCopyBufferSubData);
+}
+
+void glGetBufferSubData(GLenum, GLintptr, GLsizeiptr, GLvoid*) {
+  RECORD(glGetBufferSubData);
+}
+
+void glBindFramebuffer(GLenum, GLptr) {
+  RECORD(glBindFramebuffer);
+}
+
+GLenum glCheckFramebufferStatus(GLenum) {
+  RECORD(glCheckFramebufferStatus);
+  return GL_FRAMEBUFFER_COMPLETE;
+}
+
+void glCreateFramebuffer(GLptr) {
+  RECORD(glCreateFramebuffer);
+}
+
+void glDeleteFramebuffer(GLptr) {
+  RECORD(glDeleteFramebuffer);
+}
+
+void glFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLptr) {
+  RECORD(glFramebufferRenderbuffer);
+}
+
+void glFramebufferTexture2D(GLenum, GLenum, GLenum, GLptr, GLint) {
+  RECORD(glFramebufferTexture2D);
+}
+
+GLint glGetFramebufferAttachmentParameter(GLenum, GLenum, GLenum) {
+  RECORD(glGetFramebufferAttachmentParameter);
+  return 0;
+}
+
+GLboolean glIsFramebuffer(GLptr) {
+  RECORD(glIsFramebuffer);
+  return true;
+}
+
+void glReadPixels(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, GLvoid*) {
+  RECORD(glReadPixels);
+}
+
+void glReadPixelsBuffer(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, GLintptr) {
+  RECORD(glReadPixelsBuffer);
+}
+
+void glBlitFramebuffer(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum) {
+  RECORD(glBlitFramebuffer);
+}
+
+void glFramebufferTextureLayer(GLenum, GLenum, GLptr, GLint, GLint) {
+  RECORD(glFramebufferTextureLayer);
+}
+
+void glInvalidateFramebuffer(GLenum, GLsizei, const GLenum*) {
+  RECORD(glInvalidateFramebuffer);
+}
+
+void glInvalidateSubFramebuffer(GLenum, GLsizei, const GLenum*, GLint, GLint, GLsizei, GLsizei) {
+  RECORD(glInvalidateSubFramebuffer);
+}
+
+void glReadBuffer(GLenum) {
+  RECORD(glReadBuffer);
+}
+
+void glBindRenderbuffer(GLenum, GLptr) {
+  RECORD(glBindRenderbuffer);
+}
+
+void glCreateRenderbuffer(GLptr) {
+  RECORD(glCreateRenderbuffer);
+}
+
+void glDeleteRenderbuffer(GLptr) {
+  RECORD(glDeleteRenderbuffer);
+}
+
+GLint glGetRenderbufferParameter(GLenum, GLenum) {
+  RECORD(glGetRenderbufferParameter);
+  return 0;
+}
+
+GLboolean glIsRenderbuffer(GLptr) {
+  RECORD(glIsRenderbuffer);
+  return true;
+}
+
+void glRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) {
+  RECORD(glRenderbufferStorage);
+}
+
+void glGetInternalformativ(GLenum, GLenum, GLenum, GLsizei, GLint*) {
+  RECORD(glGetInternalformativ);
+}
+
+void glRenderbufferStorageMultisample(GLenum, GLsizei, GLenum, GLsizei, GLsizei) {
+  RECORD(glRenderbufferStorageMultisample);
+}
+
+void glBindTexture(GLenum, GLptr) {
+  RECORD(glBindTexture);
+}
+
+void glCompressedTexImage2D(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, const GLvoid*) {
+  RECORD(glCompressedTexImage2D);
+}
+
+void glCompressedTexImage2DBuffer(GLenum, GLint, GLenum, GLsizei, GLsizei, GLint, GLsizei, GLintptr) {
+  RECORD(glCompressedTexImage2DBuffer);
+}
+
+void glCompressedTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const GLvoid*) {
+  RECORD(glCompressedTexSubImage2D);
+}
+
+void glCompressedTexSubImage2DBuffer(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, GLintptr) {
+  RECORD(glCompressedTexSubImage2DBuffer);
+}
+
+void glCopyTexImage2D(GLenum, GLint, GLenum, GLint, GLint, GLsizei, GLsizei, GLint) {
+  RECORD(glCopyTexImage2D);
+}
+
+void glCopyTexSubImage2D(GLenum, GLint, GLint, GLint, GLint, GLint, GLsizei, GLsizei) {
+  RECORD(glCopyTexSubImage2D);
+}
+
+void glCreateTexture(GLptr) {
+  RECORD(glCreateTexture);
+}
+
+void glDeleteTexture(GLptr) {
+  RECORD(glDeleteTexture);
+}
+
+void glGenerateMipmap(GLenum) {
+  RECORD(glGenerateMipmap);
+}
+
+GLint glGetTexParameteri(GLenum, GLenum) {
+  RECORD(glGetTexParameteri);
+  return 0;
+}
+
+GLfloat glGetTexParameterf(GLenum, GLenum) {
+  RECORD(glGetTexParameterf);
+  return 0;
+}
+
+void glGetTexParameteriv(GLenum, GLenum, GLint*) {
+  RECORD(glGetTexParameteriv);
+}
+
+void glGetTexParameterfv(GLenum, GLenum, GLfloat*) {
+  RECORD(glGetTexParameterfv);
+}
+
+GLboolean glIsTexture(GLptr) {
+  RECORD(glIsTexture);
+  return true;
+}
+
+void glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*) {
+  RECORD(glTexImage2D);
+}
+
+void glTexImage2DBuffer(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, GLintptr) {
+  RECORD(glTexImage2DBuffer);
+}
+
+void glTexSubImage2D(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const GLvoid*) {
+  RECORD(glTexSubImage2D);
+}
+
+void glTexSubImage2DBuffer(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, GLintptr) {
+  RECORD(glTexSubImage2DBuffer);
+}
+
+void glTexParameteri(GLenum, GLenum, GLint) {
+  RECORD(glTexParameteri);
+}
+
+void glTexParameterf(GLenum, GLenum, GLfloat) {
+  RECORD(glTexParameterf);
+}
+
+void glTexStorage2D(GLenum, GLsizei, GLenum, GLsizei, GLsizei) {
+  RECORD(glTexStorage2D);
+}
+
+void glTexStorage3D(GLenum, GLsizei, GLenum, GLsizei, GLsizei, GLsizei) {
+  RECORD(glTexStorage3D);
+}
+
+void glTexImage3D(GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, const GLvoid*) {
+  RECORD(glTexImage3D);
+}
+
+void glTexImage3DBuffer(GLenum, GLint, GLint, GLsizei, GLsizei, GLsizei, GLint, GLenum, GLenum, GLintptr) {
+  RECORD(glTexImage3DBuffer);
+}
+
+void glTexSubImage3D(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, const GLvoid*) {
+  RECORD(glTexSubImage3D);
+}
+
+void glTexSubImage3DBuffer(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLenum, GLintptr) {
+  RECORD(glTexSubImage3DBuffer);
+}
+
+void glCompressedTexImage3D(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, const GLvoid*) {
+  RECORD(glCompressedTexImage3D);
+}
+
+void glCompressedTexImage3DBuffer(GLenum, GLint, GLenum, GLsizei, GLsizei, GLsizei, GLint, GLsizei, GLintptr) {
+  RECORD(glCompressedTexImage3DBuffer);
+}
+
+void glCompressedTexSubImage3D(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, const GLvoid*) {
+  RECORD(glCompressedTexSubImage3D);
+}
+
+void glCompressedTexSubImage3DBuffer(GLenum, GLint, GLint, GLint, GLint, GLsizei, GLsizei, GLsizei, GLenum, GLsizei, GLintptr) {
+  RECORD(glCompressedTexSubImage3DBuffer);
+}
+
+void glAttachShader(GLptr, GLptr) {
+  RECORD(glAttachShader);
+}
+
+void glBindAttribLocation(GLptr, GLuint, const GLchar*) {
+  RECORD(glBindAttribLocation);
+}
+
+void glCompileShader(GLptr) {
+  RECORD(glCompileShader);
+}
+
+void glCreateProgram(GLptr) {
+  RECORD(glCreateProgram);
+}
+
+void glCreateShader(GLptr, GLenum) {
+  RECORD(glCreateShader);
+}
+
+void glDeleteProgram(GLptr) {
+  RECORD(glDeleteProgram);
+}
+
+void glDeleteShader(GLptr) {
+  RECORD(glDeleteShader);
+}
+
+void glDetachShader(GLptr, GLptr) {
+  RECORD(glDetachShader);
+}
+
+void glGetAttachedShaders(GLptr, GLsizei, GLsizei*, GLptr*) {
+  RECORD(glGetAttachedShaders);
+}
+
+GLint glGetProgrami(GLptr program, GLenum pname) {
+  RECORD(glGetProgrami);
+  return GLStub::getProgrami(program, pname);
+}
+
+void glGetProgramInfoLog(GLptr, GLsizei, GLsizei*, GLchar*) {
+  RECORD(glGetProgramInfoLog);
+}
+
+GLint glGetShaderi(GLptr shader, GLenum pname) {
+  RECORD(glGetShaderi);
+  return GLStub::getShaderi(shader, pname);
+}
+
+void glGetShaderPrecisionFormat(GLenum, GLenum, GLint*, GLint*) {
+  RECORD(glGetShaderPrecisionFormat);
+}
+
+void glGetShaderInfoLog(GLptr, GLsizei, GLsizei*, GLchar*) {
+  RECORD(glGetShaderInfoLog);
+}
+
+void glGetShaderSource(GLptr, GLsizei, GLsizei*, GLchar*) {
+  RECORD(glGetShaderSource);
+}
+
+GLboolean glIsProgram(GLptr) {
+  RECORD(glIsProgram);
+  return true;
+}
+
+GLboolean glIsShader(GLptr) {
+  RECORD(glIsShader);
+  return true;
+}
+
+void glLinkProgram(GLptr) {
+  RECORD(glLinkProgram);
+}
+
+void glShaderSource(GLptr, const GLchar*) {
+  RECORD(glShaderSource);
+}
+
+void glUseProgram(GLptr) {
+  RECORD(glUseProgram);
+}
+
+void glValidateProgram(GLptr) {
+  RECORD(glValidateProgram);
+}
+
+GLint glGetFragDataLocation(GLptr, const GLchar*) {
+  RECORD(glGetFragDataLocation);
+  return 0;
+}
+
+void glDisableVertexAttribArray(GLuint) {
+  RECORD(glDisableVertexAttribArray);
+}
+
+void glEnableVertexAttribArray(GLuint) {
+  RECORD(glEnableVertexAttribArray);
+}
+
+void glGetActiveAttrib(GLptr, GLuint, GLsizei, GLsizei*, GLint*, GLenum*, GLchar*) {
+  RECORD(glGetActiveAttrib);
+}
+
+void glGetActiveUniform(GLptr, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name) {
+  RECORD(glGetActiveUniform);
+  if (index >= GLStub::config.numUniforms) {
+    return;
+  }
+  const GLStub::UniformInfo& info = GLStub::config.uniforms[index];
+  GLsizei pos = 0;
+  for (const char* src = info.name; *src && pos + 4 < bufSize; ++src) {
+    name[pos++] = *src;
+  }
+  if (info.size > 1) {
+    name[pos++] = '[';
+    name[pos++] = '0';
+    name[pos++] = ']';
+  }
+  name[pos] = 0;
+  if (length) {
+    *length = pos;
+  }
+  *size = info.size;
+  *type = info.type;
+}
+
+GLint glGetAttribLocation(GLptr, const GLchar*) {
+  RECORD(glGetAttribLocation);
+  return 0;
+}
+
+void glGetUniformfv(GLptr, GLuint, GLfloat*) {
+  RECORD(glGetUniformfv);
+}
+
+void glGetUniformiv(GLptr, GLuint, GLint*) {
+  RECORD(glGetUniformiv);
+}
+
+void glGetUniformuiv(GLptr, GLuint, GLuint*) {
+  RECORD(glGetUniformuiv);
+}
+
+GLint glGetUniformLocation(GLptr, const GLchar* name) {
+  RECORD(glGetUniformLocation);
+  const GLStub::UniformInfo* info = GLStub::findUniform(name);
+  if (!info || info->blockIndex >= 0) {
+    return -1;
+  }
+  return (GLint)(info - GLStub::config.uniforms) + 1;
+}
+
+GLint glGetVertexAttribi(GLuint, GLenum) {
+  RECORD(glGetVertexAttribi);
+  return 0;
+}
+
+void glGetVertexAttribiv(GLuint, GLenum, GLint*) {
+  RECORD(glGetVertexAttribiv);
+}
+
+void glGetVertexAttribIiv(GLuint, GLenum, GLint*) {
+  RECORD(glGetVertexAttribIiv);
+}
+
+void glGetVertexAttribIuiv(GLuint, GLenum, GLuint*) {
+  RECORD(glGetVertexAttribIuiv);
+}
+
+void glGetVertexAttribfv(GLuint, GLenum, GLfloat*) {
+  RECORD(glGetVertexAttribfv);
+}
+
+void glGetVertexAttribdv(GLuint, GLenum, GLdouble*) {
+  RECORD(glGetVertexAttribdv);
+}
+
+GLsizeiptr glGetVertexAttribOffset(GLuint, GLenum) {
+  RECORD(glGetVertexAttribOffset);
+  return 0;
+}
+
+void glUniform1f(GLint, GLfloat) {
+  RECORD(glUniform1f);
+}
+
+void glUniform2f(GLint, GLfloat, GLfloat) {
+  RECORD(glUniform2f);
+}
+
+void glUniform3f(GLint, GLfloat, GLfloat, GLfloat) {
+  RECORD(glUniform3f);
+}
+
+void glUniform4f(GLint, GLfloat, GLfloat, GLfloat, GLfloat) {
+  RECORD(glUniform4f);
+}
+
+void glUniform1i(GLint, GLint) {
+  RECORD(glUniform1i);
+}
+
+void glUniform2i(GLint, GLint, GLint) {
+  RECORD(glUniform2i);
+}
+
+void glUniform3i(GLint, GLint, GLint, GLint) {
+  RECORD(glUniform3i);
+}
+
+void glUniform4i(GLint, GLint, GLint, GLint, GLint) {
+  RECORD(glUniform4i);
+}
+
+void glUniform1ui(GLint, GLuint) {
+  RECORD(glUniform1ui);
+}
+
+void glUniform2ui(GLint, GLuint, GLuint) {
+  RECORD(glUniform2ui);
+}
+
+void glUniform3ui(GLint, GLuint, GLuint, GLuint) {
+  RECORD(glUniform3ui);
+}
+
+void glUniform4ui(GLint, GLuint, GLuint, GLuint, GLuint) {
+  RECORD(glUniform4ui);
+}
+
+void glUniform1fv(GLint, GLsizei, const GLfloat*) {
+  RECORD(glUniform1fv);
+}
+
+void glUniform2fv(GLint, GLsizei, const GLfloat*) {
+  RECORD(glUniform2fv);
+}
+
+void glUniform3fv(GLint, GLsizei, const GLfloat*) {
+  RECORD(glUniform3fv);
+}
+
+void glUniform4fv(GLint, GLsizei, const GLfloat*) {
+  RECORD(glUniform4fv);
+}
+
+void glUniform1iv(GLint, GLsizei, const GLint*) {
+  RECORD(glUniform1iv);
+}
+
+void glUniform2iv(GLint, GLsizei, const GLint*) {
+  RECORD(glUniform2iv);
+}
+
+void glUniform3iv(GLint, GLsizei, const GLint*) {
+  RECORD(glUniform3iv);
+}
+
+void glUniform4iv(GLint, GLsizei, const GLint*) {
+  RECORD(glUniform4iv);
+}
+
+void glUniform1uiv(GLint, GLsizei, const GLuint*) {
+  RECORD(glUniform1uiv);
+}
+
+void glUniform2uiv(GLint, GLsizei, const GLuint*) {
+  RECORD(glUniform2uiv);
+}
+
+void glUniform3uiv(GLint, GLsizei, const GLuint*) {
+  RECORD(glUniform3uiv);
+}
+
+void glUniform4uiv(GLint, GLsizei, const GLuint*) {
+  RECORD(glUniform4uiv);
+}
+
+void glUniformMatrix2fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix2fv);
+}
+
+void glUniformMatrix3fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix3fv);
+}
+
+void glUniformMatrix4fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix4fv);
+}
+
+void glUniformMatrix2x3fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix2x3fv);
+}
+
+void glUniformMatrix3x2fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix3x2fv);
+}
+
+void glUniformMatrix2x4fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix2x4fv);
+}
+
+void glUniformMatrix4x2fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix4x2fv);
+}
+
+void glUniformMatrix3x4fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix3x4fv);
+}
+
+void glUniformMatrix4x3fv(GLint, GLsizei, GLboolean, const GLfloat*) {
+  RECORD(glUniformMatrix4x3fv);
+}
+
+void glVertexAttrib1f(GLuint, GLfloat) {
+  RECORD(glVertexAttrib1f);
+}
+
+void glVertexAttrib2f(GLuint, GLfloat, GLfloat) {
+  RECORD(glVertexAttrib2f);
+}
+
+void glVertexAttrib3f(GLuint, GLfloat, GLfloat, GLfloat) {
+  RECORD(glVertexAttrib3f);
+}
+
+void glVertexAttrib4f(GLuint, GLfloat, GLfloat, GLfloat, GLfloat) {
+  RECORD(glVertexAttrib4f);
+}
+
+void glVertexAttrib1fv(GLuint, const GLfloat*) {
+  RECORD(glVertexAttrib1fv);
+}
+
+void glVertexAttrib2fv(GLuint, const GLfloat*) {
+  RECORD(glVertexAttrib2fv);
+}
+
+void glVertexAttrib3fv(GLuint, const GLfloat*) {
+  RECORD(glVertexAttrib3fv);
+}
+
+void glVertexAttrib4fv(GLuint, const GLfloat*) {
+  RECORD(glVertexAttrib4fv);
+}
+
+void glVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, GLintptr) {
+  RECORD(glVertexAttribPointer);
+}
+
+void glVertexAttribI4i(GLuint, GLint, GLint, GLint, GLint) {
+  RECORD(glVertexAttribI4i);
+}
+
+void glVertexAttribI4iv(GLuint, const GLint*) {
+  RECORD(glVertexAttribI4iv);
+}
+
+void glVertexAttribI4ui(GLuint, GLuint, GLuint, GLuint, GLuint) {
+  RECORD(glVertexAttribI4ui);
+}
+
+void glVertexAttribI4uiv(GLuint, const GLuint*) {
+  RECORD(glVertexAttribI4uiv);
+}
+
+void glVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, GLintptr) {
+  RECORD(glVertexAttribIPointer);
+}
+
+void glClear(GLbitfield) {
+  RECORD(glClear);
+}
+
+void glDrawArrays(GLenum, GLint, GLsizei) {
+  RECORD(glDrawArrays);
+}
+
+void glDrawElements(GLenum, GLsizei, GLenum, GLintptr) {
+  RECORD(glDrawElements);
+}
+
+void glFinish() {
+  RECORD(glFinish);
+}
+
+void glFlush() {
+  RECORD(glFlush);
+}
+
+void glVertexAttribDivisor(GLuint, GLuint) {
+  RECORD(glVertexAttribDivisor);
+}
+
+void glDrawArraysInstanced(GLenum, GLint, GLsizei, GLsizei) {
+  RECORD(glDrawArraysInstanced);
+}
+
+void glDrawElementsInstanced(GLenum, GLsizei, GLenum, GLintptr, GLsizei) {
+  RECORD(glDrawElementsInstanced);
+}
+
+void glDrawRangeElements(GLenum, GLuint, GLuint, GLsizei, GLenum, GLintptr) {
+  RECORD(glDrawRangeElements);
+}
+
+void glDrawBuffers(GLsizei, const GLenum*) {
+  RECORD(glDrawBuffers);
+}
+
+void glClearBufferiv(GLenum, GLint, const GLint*) {
+  RECORD(glClearBufferiv);
+}
+
+void glClearBufferuiv(GLenum, GLint, const GLuint*) {
+  RECORD(glClearBufferuiv);
+}
+
+void glClearBufferfv(GLenum, GLint, const GLfloat*) {
+  RECORD(glClearBufferfv);
+}
+
+void glClearBufferfi(GLenum, GLint, GLfloat, GLint) {
+  RECORD(glClearBufferfi);
+}
+
+void glCreateQuery(GLptr) {
+  RECORD(glCreateQuery);
+}
+
+void glDeleteQuery(GLptr) {
+  RECORD(glDeleteQuery);
+}
+
+GLboolean glIsQuery(GLptr) {
+  RECORD(glIsQuery);
+  return true;
+}
+
+void glBeginQuery(GLenum, GLptr) {
+  RECORD(glBeginQuery);
+}
+
+void glEndQuery(GLenum) {
+  RECORD(glEndQuery);
+}
+
+GLint glGetQuery(GLenum, GLenum) {
+  RECORD(glGetQuery);
+  return 0;
+}
+
+void glGetQueryiv(GLenum, GLenum, GLint*) {
+  RECORD(glGetQueryiv);
+}
+
+GLint glGetQueryParameter(GLptr, GLenum pname) {
+  RECORD(glGetQueryParameter);
+  switch (pname) {
+  case GL_QUERY_RESULT_AVAILABLE:
+    return 1;
+  case GL_QUERY_RESULT:
+    return GLStub::config.queryResult;
+  default:
+    return 0;
+  }
+}
+
+void glGetQueryObjectiv(GLptr, GLenum, GLint*) {
+  RECORD(glGetQueryObjectiv);
+}
+
+void glGetQueryObjectuiv(GLptr, GLenum, GLuint*) {
+  RECORD(glGetQueryObjectuiv);
+}
+
+void glCreateSampler(GLptr) {
+  RECORD(glCreateSampler);
+}
+
+void glDeleteSampler(GLptr) {
+  RECORD(glDeleteSampler);
+}
+
+void glBindSampler(GLuint, GLptr) {
+  RECORD(glBindSampler);
+}
+
+GLboolean glIsSampler(GLptr) {
+  RECORD(glIsSampler);
+  return true;
+}
+
+void glSamplerParameteri(GLptr, GLenum, GLint) {
+  RECORD(glSamplerParameteri);
+}
+
+void glSamplerParameterf(GLptr, GLenum, GLfloat) {
+  RECORD(glSamplerParameterf);
+}
+
+GLint glGetSamplerParameteri(GLptr, GLenum) {
+  RECORD(glGetSamplerParameteri);
+  return 0;
+}
+
+GLfloat glGetSamplerParameterf(GLptr, GLenum) {
+  RECORD(glGetSamplerParameterf);
+  return 0;
+}
+
+void glGetSamplerParameteriv(GLptr, GLenum, GLint*) {
+  RECORD(glGetSamplerParameteriv);
+}
+
+void glGetSamplerParameterfv(GLptr, GLenum, GLfloat*) {
+  RECORD(glGetSamplerParameterfv);
+}
+
+void glFenceSync(GLptr, GLenum, GLbitfield) {
+  RECORD(glFenceSync);
+}
+
+void glDeleteSync(GLptr) {
+  RECORD(glDeleteSync);
+}
+
+GLboolean glIsSync(GLptr) {
+  RECORD(glIsSync);
+  return true;
+}
+
+GLenum glClientWaitSync(GLptr, GLbitfield, GLuint) {
+  RECORD(glClientWaitSync);
+  return GLStub::config.syncSignaled ? GL_ALREADY_SIGNALED : GL_TIMEOUT_EXPIRED;
+}
+
+void glWaitSync(GLptr, GLbitfield, GLuint) {
+  RECORD(glWaitSync);
+}
+
+GLint glGetSynci(GLptr, GLenum pname) {
+  RECORD(glGetSynci);
+  if (pname == GL_SYNC_STATUS) {
+    return GLStub::config.syncSignaled ? GL_SIGNALED : GL_UNSIGNALED;
+  }
+  return 0;
+}
+
+void glGetSynciv(GLptr, GLenum, GLsizei, GLsizei*, GLint*) {
+  RECORD(glGetSynciv);
+}
+
+void glCreateTransformFeedback(GLptr) {
+  RECORD(glCreateTransformFeedback);
+}
+
+void glDeleteTransformFeedback(GLptr) {
+  RECORD(glDeleteTransformFeedback);
+}
+
+GLboolean glIsTransformFeedback(GLptr) {
+  RECORD(glIsTransformFeedback);
+  return true;
+}
+
+void glBindTransformFeedback(GLenum, GLptr) {
+  RECORD(glBindTransformFeedback);
+}
+
+void glBeginTransformFeedback(GLenum) {
+  RECORD(glBeginTransformFeedback);
+}
+
+void glEndTransformFeedback() {
+  RECORD(glEndTransformFeedback);
+}
+
+void glTransformFeedbackVaryings(GLptr, GLsizei, const char**, GLenum) {
+  RECORD(glTransformFeedbackVaryings);
+}
+
+void glGetTransformFeedbackVarying(GLptr, GLuint, GLsizei, GLsizei*, GLsizei*, GLenum*, char*) {
+  RECORD(glGetTransformFeedbackVarying);
+}
+
+void glPauseTransformFeedback() {
+  RECORD(glPauseTransformFeedback);
+}
+
+void glResumeTransformFeedback() {
+  RECORD(glResumeTransformFeedback);
+}
+
+void glBindBufferBase(GLenum, GLuint, GLptr) {
+  RECORD(glBindBufferBase);
+}
+
+void glBindBufferRange(GLenum, GLuint, GLptr, GLintptr, GLsizeiptr) {
+  RECORD(glBindBufferRange);
+}
+
+void glGetUniformIndices(GLptr, GLsizei, const GLchar**, GLuint*) {
+  RECORD(glGetUniformIndices);
+}
+
+void glGetActiveUniformsiv(GLptr, GLsizei uniformCount, const GLuint* uniformIndices, GLenum pname, GLint* params) {
+  RECORD(glGetActiveUniformsiv);
+  for (GLsizei i = 0; i < uniformCount; ++i) {
+    if (uniformIndices[i] >= GLStub::config.numUniforms) {
+      continue;
+    }
+    const GLStub::UniformInfo& info = GLStub::config.uniforms[uniformIndices[i]];
+    switch (pname) {
+    case GL_UNIFORM_TYPE:
+      params[i] = info.type;
+      break;
+    case GL_UNIFORM_SIZE:
+      params[i] = info.size;
+      break;
+    case GL_UNIFORM_BLOCK_INDEX:
+      params[i] = info.blockIndex;
+      break;
+    case GL_UNIFORM_OFFSET:
+      params[i] = info.offset;
+      break;
+    case GL_UNIFORM_ARRAY_STRIDE:
+      params[i] = info.arrayStride;
+      break;
+    case GL_UNIFORM_MATRIX_STRIDE:
+      params[i] = info.matrixStride;
+      break;
+    }
+  }
+}
+
+GLuint glGetUniformBlockIndex(GLptr, const GLchar* uniformBlockName) {
+  RECORD(glGetUniformBlockIndex);
+  GLint index = GLStub::findUniformBlock(uniformBlockName);
+  return index < 0 ? (GLuint)GL_INVALID_INDEX : (GLuint)index;
+}
+
+void glGetActiveUniformBlockiv(GLptr, GLuint uniformBlockIndex, GLenum pname, GLint* params) {
+  RECORD(glGetActiveUniformBlockiv);
+  if (uniformBlockIndex >= GLStub::config.numUniformBlocks) {
+    return;
+  }
+  GLint count = 0;
+  switch (pname) {
+  case GL_UNIFORM_BLOCK_DATA_SIZE:
+    *params = GLStub::config.uniformBlocks[uniformBlockIndex].dataSize;
+    break;
+  case GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS:
+  case GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES:
+    for (size_t i = 0; i < GLStub::config.numUniforms; ++i) {
+      if (GLStub::config.uniforms[i].blockIndex == (GLint)uniformBlockIndex) {
+        if (pname == GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES) {
+          params[count] = (GLint)i;
+        }
+        count += 1;
+      }
+    }
+    if (pname == GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS) {
+      *params = count;
+    }
+    break;
+  default:
+    *params = 0;
+    break;
+  }
+}
+
+void glGetActiveUniformBlockName(GLptr, GLuint, GLsizei, GLsizei*, GLchar*) {
+  RECORD(glGetActiveUniformBlockName);
+}
+
+void glUniformBlockBinding(GLptr, GLuint, GLuint) {
+  RECORD(glUniformBlockBinding);
+}
+
+void glCreateVertexArray(GLptr) {
+  RECORD(glCreateVertexArray);
+}
+
+void glDeleteVertexArray(GLptr) {
+  RECORD(glDeleteVertexArray);
+}
+
+GLboolean glIsVertexArray(GLptr) {
+  RECORD(glIsVertexArray);
+  return true;
+}
+
+void glBindVertexArray(GLptr) {
+  RECORD(glBindVertexArray);
+}
+
+GLboolean glGetExtension(const char*) {
+  RECORD(glGetExtension);
+  return GLStub::config.extensions;
+}
+
+void glQueryCounter(GLptr, GLenum) {
+  RECORD(glQueryCounter);
+}
+
+void glGetTranslatedShaderSource(GLptr, GLsizei, GLsizei*, GLchar*) {
+  RECORD(glGetTranslatedShaderSource);
+}
+
+void glLoseContext() {
+  RECORD(glLoseContext);
+}
+
+void glRestoreContext() {
+  RECORD(glRestoreContext);
+}
+
+void glMultiDrawArrays(GLenum, const GLint*, const GLsizei*, GLsizei) {
+  RECORD(glMultiDrawArrays);
+}
+
+void glMultiDrawElements(GLenum, const GLsizei*, GLenum, const GLintptr*, GLsizei) {
+  RECORD(glMultiDrawElements);
+}
+
+void glMultiDrawElementsInstanced(GLenum, const GLsizei*, GLenum, const GLintptr*,
+                                  const GLsizei*, GLsizei) {
+  RECORD(glMultiDrawElementsInstanced);
+}
+
+void glFrameStats(const void*) {
+  RECORD(glFrameStats);
+}
+
+void glSaveTrace(const void*, size_t) {
+  RECORD(glSaveTrace);
+}
+
+void glReportLeaks(const ui32*, size_t) {
+  RECORD(glReportLeaks);
+}
@@ -0,0 +1,333 @@
+#pragma once
+#include "../common.h"
+#include "../glbindings.h"
+
+// Recording no-op implementation of glbindings.h for native builds.
+// Every entry point bumps its call counter; queries return plausible constants.
+
+namespace GLStub
+{
+
+enum Function {
+  CALL_glVersion,
+  CALL_glCanvasWidth,
+  CALL_glCanvasHeight,
+  CALL_glIsContextLost,
+  CALL_glScissor,
+  CALL_glViewport,
+  CALL_glActiveTexture,
+  CALL_glBlendColor,
+  CALL_glBlendEquation,
+  CALL_glBlendEquationSeparate,
+  CALL_glBlendFunc,
+  CALL_glBlendFuncSeparate,
+  CALL_glClearColor,
+  CALL_glClearDepth,
+  CALL_glClearStencil,
+  CALL_glColorMask,
+  CALL_glCullFace,
+  CALL_glDepthFunc,
+  CALL_glDepthMask,
+  CALL_glDepthRange,
+  CALL_glDisable,
+  CALL_glEnable,
+  CALL_glFrontFace,
+  CALL_glGetError,
+  CALL_glHint,
+  CALL_glIsEnabled,
+  CALL_glLineWidth,
+  CALL_glPixelStorei,
+  CALL_glPolygonOffset,
+  CALL_glSampleCoverage,
+  CALL_glStencilFunc,
+  CALL_glStencilFuncSeparate,
+  CALL_glStencilMask,
+  CALL_glStencilMaskSeparate,
+  CALL_glStencilOp,
+  CALL_glStencilOpSeparate,
+  CALL_glGetBoolean,
+  CALL_glGetInteger,
+  CALL_glGetFloat,
+  CALL_glGetDouble,
+  CALL_glGetIntegerv,
+  CALL_glGetBooleanv,
+  CALL_glGetFloatv,
+  CALL_glGetDoublev,
+  CALL_glGetString,
+  CALL_glGetIntegeri,
+  CALL_glGetIntegeri_v,
+  CALL_glBindBuffer,
+  CALL_glBufferData,
+  CALL_glBufferSubData,
+  CALL_glCreateBuffer,
+  CALL_glDeleteBuffer,
+  CALL_glGetBufferParameter,
+  CALL_glIsBuffer,
+  CALL_glCopyBufferSubData,
+  CALL_glGetBufferSubData,
+  CALL_glBindFramebuffer,
+  CALL_glCheckFramebufferStatus,
+  CALL_glCreateFramebuffer,
+  CALL_glDeleteFramebuffer,
+  CALL_glFramebufferRenderbuffer,
+  CALL_glFramebufferTexture2D,
+  CALL_glGetFramebufferAttachmentParameter,
+  CALL_glIsFramebuffer,
+  CALL_glReadPixels,
+  CALL_glReadPixelsBuffer,
+  CALL_glBlitFramebuffer,
+  CALL_glFramebufferTextureLayer,
+  CALL_glInvalidateFramebuffer,
+  CALL_glInvalidateSubFramebuffer,
+  CALL_glReadBuffer,
+  CALL_glBindRenderbuffer,
+  CALL_glCreateRenderbuffer,
+  CALL_glDeleteRenderbuffer,
+  CALL_glGetRenderbufferParameter,
+  CALL_glIsRenderbuffer,
+  CALL_glRenderbufferStorage,
+  CALL_glGetInternalformativ,
+  CALL_glRenderbufferStorageMultisample,
+  CALL_glBindTexture,
+  CALL_glCompressedTexImage2D,
+  CALL_glCompressedTexImage2DBuffer,
+  CALL_glCompressedTexSubImage2D,
+  CALL_glCompressedTexSubImage2DBuffer,
+  CALL_glCopyTexImage2D,
+  CALL_glCopyTexSubImage2D,
+  CALL_glCreateTexture,
+  CALL_glDeleteTexture,
+  CALL_glGenerateMipmap,
+  CALL_glGetTexParameteri,
+  CALL_glGetTexParameterf,
+  CALL_glGetTexParameteriv,
+  CALL_glGetTexParameterfv,
+  CALL_glIsTexture,
+  CALL_glTexImage2D,
+  CALL_glTexImage2DBuffer,
+  CALL_glTexSubImage2D,
+  CALL_glTexSubImage2DBuffer,
+  CALL_glTexParameteri,
+  CALL_glTexParameterf,
+  CALL_glTexStorage2D,
+  CALL_glTexStorage3D,
+  CALL_glTexImage3D,
+  CALL_glTexImage3DBuffer,
+  CALL_glTexSubImage3D,
+  CALL_glTexSubImage3DBuffer,
+  CALL_glCompressedTexImage3D,
+  CALL_glCompressedTexImage3DBuffer,
+  CALL_glCompressedTexSubImage3D,
+  CALL_glCompressedTexSubImage3DBuffer,
+  CALL_glAttachShader,
+  CALL_glBindAttribLocation,
+  CALL_glCompileShader,
+  CALL_glCreateProgram,
+  CALL_glCreateShader,
+  CALL_glDeleteProgram,
+  CALL_glDeleteShader,
+  CALL_glDetachShader,
+  CALL_glGetAttachedShaders,
+  CALL_glGetProgrami,
+  CALL_glGetProgramInfoLog,
+  CALL_glGetShaderi,
+  CALL_glGetShaderPrecisionFormat,
+  CALL_glGetShaderInfoLog,
+  CALL_glGetShaderSource,
+  CALL_glIsProgram,
+  CALL_glIsShader,
+  CALL_glLinkProgram,
+  CALL_glShaderSource,
+  CALL_glUseProgram,
+  CALL_glValidateProgram,
+  CALL_glGetFragDataLocation,
+  CALL_glDisableVertexAttribArray,
+  CALL_glEnableVertexAttribArray,
+  CALL_glGetActiveAttrib,
+  CALL_glGetActiveUniform,
+  CALL_glGetAttribLocation,
+  CALL_glGetUniformfv,
+  CALL_glGetUniformiv,
+  CALL_glGetUniformuiv,
+  CALL_glGetUniformLocation,
+  CALL_glGetVertexAttribi,
+  CALL_glGetVertexAttribiv,
+  CALL_glGetVertexAttribIiv,
+  CALL_glGetVertexAttribIuiv,
+  CALL_glGetVertexAttribfv,
+  CALL_glGetVertexAttribdv,
+  CALL_glGetVertexAttribOffset,
+  CALL_glUniform1f,
+  CALL_glUniform2f,
+  CALL_glUniform3f,
+  CALL_glUniform4f,
+  CALL_glUniform1i,
+  CALL_glUniform2i,
+  CALL_glUniform3i,
+  CALL_glUniform4i,
+  CALL_glUniform1ui,
+  CALL_glUniform2ui,
+  CALL_glUniform3ui,
+  CALL_glUniform4ui,
+  CALL_glUniform1fv,
+  CALL_glUniform2fv,
+  CALL_glUniform3fv,
+  CALL_glUniform4fv,
+  CALL_glUniform1iv,
+  CALL_glUniform2iv,
+  CALL_glUniform3iv,
+  CALL_glUniform4iv,
+  CALL_glUniform1uiv,
+  CALL_glUniform2uiv,
+  CALL_glUniform3uiv,
+  CALL_glUniform4uiv,
+  CALL_glUniformMatrix2fv,
+  CALL_glUniformMatrix3fv,
+  CALL_glUniformMatrix4fv,
+  CALL_glUniformMatrix2x3fv,
+  CALL_glUniformMatrix3x2fv,
+  CALL_glUniformMatrix2x4fv,
+  CALL_glUniformMatrix4x2fv,
+  CALL_glUniformMatrix3x4fv,
+  CALL_glUniformMatrix4x3fv,
+  CALL_glVertexAttrib1f,
+  CALL_glVertexAttrib2f,
+  CALL_glVertexAttrib3f,
+  CALL_glVertexAttrib4f,
+  CALL_glVertexAttrib1fv,
+  CALL_glVertexAttrib2fv,
+  CALL_glVertexAttrib3fv,
+  CALL_glVertexAttrib4fv,
+  CALL_glVertexAttribPointer,
+  CALL_glVertexAttribI4i,
+  CALL_glVertexAttribI4iv,
+  CALL_glVertexAttribI4ui,
+  CALL_glVertexAttribI4uiv,
+  CALL_glVertexAttribIPointer,
+  CALL_glClear,
+  CALL_glDrawArrays,
+  CALL_glDrawElements,
+  CALL_glFinish,
+  CALL_glFlush,
+  CALL_glVertexAttribDivisor,
+  CALL_glDrawArraysInstanced,
+  CALL_glDrawElementsInstanced,
+  CALL_glDrawRangeElements,
+  CALL_glDrawBuffers,
+  CALL_glClearBufferiv,
+  CALL_glClearBufferuiv,
+  CALL_glClearBufferfv,
+  CALL_glClearBufferfi,
+  CALL_glCreateQuery,
+  CALL_glDeleteQuery,
+  CALL_glIsQuery,
+  CALL_glBeginQuery,
+  CALL_glEndQuery,
+  CALL_glGetQuery,
+  CALL_glGetQueryiv,
+  CALL_glGetQueryParameter,
+  CALL_glGetQueryObjectiv,
+  CALL_glGetQueryObjectuiv,
+  CALL_glCreateSampler,
+  CALL_glDeleteSampler,
+  CALL_glBindSampler,
+  CALL_glIsSampler,
+  CALL_glSamplerParameteri,
+  CALL_glSamplerParameterf,
+  CALL_glGetSamplerParameteri,
+  CALL_glGetSamplerParameterf,
+  CALL_glGetSamplerParameteriv,
+  CALL_glGetSamplerParameterfv,
+  CALL_glFenceSync,
+  CALL_glDeleteSync,
+  CALL_glIsSync,
+  CALL_glClientWaitSync,
+  CALL_glWaitSync,
+  CALL_glGetSynci,
+  CALL_glGetSynciv,
+  CALL_glCreateTransformFeedback,
+  CALL_glDeleteTransformFeedback,
+  CALL_glIsTransformFeedback,
+  CALL_glBindTransformFeedback,
+  CALL_glBeginTransformFeedback,
+  CALL_glEndTransformFeedback,
+  CALL_glTransformFeedbackVaryings,
+  CALL_glGetTransformFeedbackVarying,
+  CALL_glPauseTransformFeedback,
+  CALL_glResumeTransformFeedback,
+  CALL_glBindBufferBase,
+  CALL_glBindBufferRange,
+  CALL_glGetUniformIndices,
+  CALL_glGetActiveUniformsiv,
+  CALL_glGetUniformBlockIndex,
+  CALL_glGetActiveUniformBlockiv,
+  CALL_glGetActiveUniformBlockName,
+  CALL_glUniformBlockBinding,
+  CALL_glCreateVertexArray,
+  CALL_glDeleteVertexArray,
+  CALL_glIsVertexArray,
+  CALL_glBindVertexArray,
+  CALL_glGetExtension,
+  CALL_glQueryCounter,
+  CALL_glGetTranslatedShaderSource,
+  CALL_glLoseContext,
+  CALL_glRestoreContext,
+  CALL_glMultiDrawArrays,
+  CALL_glMultiDrawElements,
+  CALL_glMultiDrawElementsInstanced,
+  CALL_glFrameStats,
+  CALL_glSaveTrace,
+  CALL_glReportLeaks,
+  NUM_FUNCTIONS,
+};
+extern const char* const functionNames[NUM_FUNCTIONS];
+
+// Active uniforms reported for every linked program
+struct UniformInfo {
+  const char* name;
+  GLenum type;
+  GLint size;
+  GLint blockIndex;
+  GLint offset = -1;
+  GLint arrayStride = -1;
+  GLint matrixStride = -1;
+};
+struct UniformBlockInfo {
+  const char* name;
+  GLint dataSize;
+};
+
+struct Config {
+  GLint version;
+  GLsizei canvasWidth;
+  GLsizei canvasHeight;
+  GLboolean extensions;
+  GLint maxTextureUnits;
+  GLint uniformBufferOffsetAlignment;
+  const UniformInfo* uniforms;
+  size_t numUniforms;
+  const UniformBlockInfo* uniformBlocks;
+  size_t numUniformBlocks;
+  // Status reported for every fence
+  GLboolean syncSignaled;
+  // Value reported for GL_QUERY_RESULT (nanoseconds for timer queries)
+  GLint queryResult;
+  GLboolean gpuDisjoint;
+};
+extern Config config;
+
+struct Stats {
+  unsigned long long total;
+  unsigned long long calls[NUM_FUNCTIONS];
+};
+extern Stats stats;
+
+void reset();
+
+GLint getInteger(GLenum pname);
+GLint getProgrami(GLptr program, GLenum pname);
+GLint getShaderi(GLptr shader, GLenum pname);
+const UniformInfo* findUniform(const GLchar* name);
+GLint findUniformBlock(const GLchar* name);
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// Helpers for native builds, implemented in runtime.cpp on top of libc.
+
+unsigned long long nativeTime();
+void nativePrint(const char* format, ...) __attribute__((format(printf, 1, 2)));
+// Whole file in a malloc'd buffer, nullptr if it can't be read
+void* nativeReadFile(const char* path, unsigned long* size);
+bool nativeWriteFile(const char* path, const void* data, unsigned long size);
+
+// Command stream decoder stub (commandStub.cpp)
+struct CommandStubStats {
+  unsigned long long flushes;
+  unsigned long long words;
+  unsigned long long commands;
+  unsigned long long opcodes[256];
+};
+extern CommandStubStats commandStubStats;
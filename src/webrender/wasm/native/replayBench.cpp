@@ -0,0 +1,141 @@
+#include "../webgl.h"
+#include "../buffer.h"
+#include "../texture.h"
+#include "../vertexArray.h"
+#include "../pipelineState.h"
+#include "../program.h"
+#include "../shader.h"
+#include "../drawQueue.h"
+#include "../frameCapture.h"
+#include "glStub.h"
+#include "native.h"
+
+// Frame capture and replay. Runs a scene of 1000 scattered draws with per-frame buffer
+// and texture uploads through the command buffer, captures a few frames into
+// build/frame.trace, and replays the last one many times against the stubs.
+// Recording measures state tracking and encoding, replay measures the trace itself.
+//
+// With a trace path argument, replays that trace instead, e.g. one captured on a
+// user's machine.
+
+using namespace WebGL;
+using namespace GLCommands;
+
+static const int FRAMES = 1000;
+static const int CAPTURED_FRAMES = 3;
+static const int DRAWS = 1000;
+
+static void replay(const ui32* trace, size_t size) {
+  TraceReplayer replayer(trace, size);
+  if (!replayer.valid() || !replayer.numFrames()) {
+    nativePrint("replay: not a valid trace\n");
+    return;
+  }
+  nativePrint("replay: %u frames, %u KB\n", replayer.numFrames(), (ui32)(size * sizeof(ui32) >> 10));
+
+  // Everything up to the last frame sets up the objects it uses
+  ui32 last = replayer.numFrames() - 1;
+  for (ui32 frame = 0; frame < last; ++frame) {
+    replayer.playFrame(frame);
+  }
+  GLStub::reset();
+  commandStubStats = CommandStubStats();
+  unsigned long long start = nativeTime();
+  for (int i = 0; i < FRAMES; ++i) {
+    replayer.playFrame(last);
+  }
+  unsigned long long elapsed = nativeTime() - start;
+  nativePrint("replay: %.2f us/frame, %llu commands and %llu direct calls per frame, %u mismatches\n",
+              (double)elapsed / FRAMES / 1000.0, commandStubStats.commands / FRAMES,
+              GLStub::stats.total / FRAMES, replayer.mismatches());
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1) {
+    unsigned long size = 0;
+    void* trace = nativeReadFile(argv[1], &size);
+    if (!trace) {
+      nativePrint("replay: can't read %s\n", argv[1]);
+      return 1;
+    }
+    replay((const ui32*)trace, size / sizeof(ui32));
+    return 0;
+  }
+
+  // Captured from the start so the trace creates every object it uses
+  beginCapture();
+
+  enum {
+    NUM_TEXTURES = 8,
+    NUM_PROGRAMS = 4,
+  };
+  Texture* textures[NUM_TEXTURES];
+  for (int i = 0; i < NUM_TEXTURES; ++i) {
+    textures[i] = Texture::create2D(GL_RGBA8, 256, 256);
+  }
+  static ui32 pixels[64 * 64];
+  static float vertexData[1024];
+  Buffer* vertices = Buffer::create(65536, nullptr, GL_DYNAMIC_DRAW);
+  Buffer* indices = Buffer::create(65536, nullptr, GL_STATIC_DRAW, GL_ELEMENT_ARRAY_BUFFER);
+  VertexArray* vertexArrays[2];
+  for (int i = 0; i < 2; ++i) {
+    vertexArrays[i] = VertexArray::create();
+    vertexArrays[i]->setAttribute(0, vertices, 3, GL_FLOAT, false, 32, 0);
+    vertexArrays[i]->setAttribute(1, vertices, 3, GL_FLOAT, false, 32, 12);
+    vertexArrays[i]->setAttribute(2, vertices, 2, GL_FLOAT, false, 32, 24);
+    vertexArrays[i]->setIndices(indices);
+  }
+  Program* programs[NUM_PROGRAMS];
+  for (int i = 0; i < NUM_PROGRAMS; ++i) {
+    Shader* vertex = Shader::create(GL_VERTEX_SHADER);
+    Shader* fragment = Shader::create(GL_FRAGMENT_SHADER);
+    programs[i] = Program::create(vertex, fragment);
+    vertex->release();
+    fragment->release();
+  }
+  PipelineDesc blendDesc;
+  blendDesc.setDepth(GL_LEQUAL, false);
+  blendDesc.setBlend(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  PipelineDesc depthDesc;
+  depthDesc.setDepth(GL_LEQUAL);
+  PipelineState* states[2] = {PipelineState::create(depthDesc), PipelineState::create(blendDesc)};
+  DrawQueue queue;
+
+  auto frame = [&](int index) {
+    vertices->setData(0, sizeof vertexData, vertexData);
+    textures[index & 7]->subImage2D(0, 0, 64, 64, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    for (int i = 0; i < DRAWS; ++i) {
+      ui32 hash = (ui32)(index * DRAWS + i) * 2654435761U;
+      DrawItem item;
+      item.program = programs[(hash >> 8) & 3];
+      item.vertexArray = vertexArrays[(hash >> 12) & 1];
+      item.pipelineState = states[((hash >> 16) & 7) == 0];
+      item.textures[0] = textures[(hash >> 20) & 7];
+      item.numTextures = 1;
+      item.indexType = GL_UNSIGNED_SHORT;
+      item.count = 36;
+      queue.add(item, 0, (float)(hash & 255));
+    }
+    queue.submit();
+    endFrame();
+  };
+
+  for (int i = 0; i < CAPTURED_FRAMES; ++i) {
+    frame(i);
+  }
+  size_t size;
+  const ui32* trace = endCapture(&size);
+  if (nativeWriteFile("build/frame.trace", trace, size * sizeof(ui32))) {
+    nativePrint("capture: %d frames written to build/frame.trace\n", CAPTURED_FRAMES);
+  }
+
+  unsigned long long start = nativeTime();
+  for (int i = 0; i < FRAMES; ++i) {
+    frame(CAPTURED_FRAMES - 1);
+  }
+  unsigned long long elapsed = nativeTime() - start;
+  nativePrint("record: %.2f us/frame\n", (double)elapsed / FRAMES / 1000.0);
+
+  replay(trace, size);
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <time.h>
+#include "native.h"
+
+// Native replacements for the functions that the wasm build imports from JS (see common.h).
+// This file must not include common.h: its declarations clash with the libc headers above.
+
+static const size_t HEAP_SIZE = 1024 * 1024 * 1024;
+static char* heap_ = nullptr;
+static size_t heapSize_ = 0;
+
+void* sbrk(long increment) {
+  if (!heap_) {
+    heap_ = (char*)calloc(HEAP_SIZE, 1);
+  }
+  if (increment > 0 && heapSize_ + increment > HEAP_SIZE) {
+    fprintf(stderr, "sbrk: out of memory\n");
+    abort();
+  }
+  char* result = heap_ + heapSize_;
+  heapSize_ += increment;
+  return result;
+}
+
+void error(const char* message) {
+  fprintf(stderr, "error: %s\n", message);
+  abort();
+}
+
+void* memset(void* ptr, int value, size_t num) {
+  unsigned char* dst = (unsigned char*)ptr;
+  while (num--) {
+    *dst++ = (unsigned char)value;
+  }
+  return ptr;
+}
+
+void* memcpy(void* destination, const void* source, size_t num) {
+  unsigned char* dst = (unsigned char*)destination;
+  const unsigned char* src = (const unsigned char*)source;
+  while (num--) {
+    *dst++ = *src++;
+  }
+  return destination;
+}
+
+unsigned long long nativeTime() {
+  timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+void nativePrint(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  vprintf(format, args);
+  va_end(args);
+}
+
+void* nativeReadFile(const char* path, unsigned long* size) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    return nullptr;
+  }
+  fseek(file, 0, SEEK_END);
+  *size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  void* data = malloc(*size ? *size : 1);
+  if (fread(data, 1, *size, file) != *size) {
+    free(data);
+    data = nullptr;
+  }
+  fclose(file);
+  return data;
+}
+
+bool nativeWriteFile(const char* path, const void* data, unsigned long size) {
+  FILE* file = fopen(path, "wb");
+  if (!file) {
+    return false;
+  }
+  bool written = (fwrite(data, 1, size, file) == size);
+  fclose(file);
+  return written;
+}
@@ -0,0 +1,260 @@
+#include "occlusionCuller.h"
+#include "buffer.h"
+#include "program.h"
+#include "vertexArray.h"
+#include "pipelineState.h"
+#include "streamBuffer.h"
+#include "query.h"
+#include "malloc.h"
+#include "frameStats.h"
+
+namespace WebGL
+{
+
+static const char* const BoxVertexShader =
+  "#version 300 es\n"
+  "layout(location = 0) in vec3 aPosition;\n"
+  "uniform mat4 uViewProjection;\n"
+  "void main() {\n"
+  "  gl_Position = uViewProjection * vec4(aPosition, 1.0);\n"
+  "}\n";
+static const char* const BoxFragmentShader =
+  "#version 300 es\n"
+  "precision lowp float;\n"
+  "out vec4 color;\n"
+  "void main() {\n"
+  "  color = vec4(1.0);\n"
+  "}\n";
+
+// Cube corners as a single triangle strip; bit 0 selects max x, bit 1 max y, bit 2 max z
+static const ui32 BoxStrip[] = {6, 7, 2, 3, 1, 7, 5, 6, 4, 2, 0, 1, 4, 5};
+enum {
+  BOX_VERTICES = sizeof(BoxStrip) / sizeof(BoxStrip[0]),
+  BOX_VERTEX_SIZE = 3 * sizeof(float),
+  BOX_SIZE = BOX_VERTICES * BOX_VERTEX_SIZE,
+};
+
+OcclusionCuller::OcclusionCuller(size_t capacity, size_t testsPerFrame)
+  : capacity_(capacity ? capacity : 1)
+  , testsPerFrame_(testsPerFrame ? testsPerFrame : 1)
+{
+  objects_ = (Occludee*)_mem::malloc(capacity_ * sizeof(Occludee));
+  pool_ = (Query**)_mem::malloc(capacity_ * sizeof(Query*));
+  stats_.objects = stats_.culled = stats_.tested = stats_.eyeInside = 0;
+  for (int i = 0; i < 16; ++i) {
+    viewProjection_[i] = (i % 5 ? 0.0f : 1.0f);
+  }
+}
+
+OcclusionCuller::~OcclusionCuller() {
+  for (size_t i = 0; i < size_; ++i) {
+    if (objects_[i].used && objects_[i].query) {
+      objects_[i].query->release();
+    }
+  }
+  for (ui32 i = 0; i < numBatches_; ++i) {
+    batches_[(firstBatch_ + i) % MAX_BATCHES].last->release();
+  }
+  for (ui32 i = 0; i < poolSize_; ++i) {
+    pool_[i]->release();
+  }
+  _mem::free(objects_);
+  _mem::free(pool_);
+  if (program_) {
+    program_->release();
+    pipelineState_->release();
+    vertexArray_->release();
+    vertices_->release();
+  }
+  _mem::free(boxes_);
+}
+
+ui32 OcclusionCuller::add(const float min[3], const float max[3]) {
+  ui32 index = freeList_;
+  if (index != INVALID_OBJECT) {
+    freeList_ = objects_[index].nextFree;
+  } else {
+    if (size_ == capacity_) {
+      capacity_ *= 2;
+      objects_ = (Occludee*)_mem::realloc(objects_, capacity_ * sizeof(Occludee));
+      pool_ = (Query**)_mem::realloc(pool_, capacity_ * sizeof(Query*));
+    }
+    index = (ui32)size_++;
+  }
+  Occludee& object = objects_[index];
+  object.query = nullptr;
+  object.occluded = 0;
+  object.used = true;
+  object.visible = true;
+  object.eyeInside = false;
+  setBounds(index, min, max);
+  ++stats_.objects;
+  return index;
+}
+
+void OcclusionCuller::remove(ui32 index) {
+  Occludee& object = objects_[index];
+  assert(object.used);
+  if (object.query) {
+    releaseQuery_(object.query);
+    object.query = nullptr;
+  }
+  object.used = false;
+  object.nextFree = freeList_;
+  freeList_ = index;
+  --stats_.objects;
+}
+
+void OcclusionCuller::setBounds(ui32 index, const float min[3], const float max[3]) {
+  Occludee& object = objects_[index];
+  for (int i = 0; i < 3; ++i) {
+    object.min[i] = min[i];
+    object.max[i] = max[i];
+  }
+}
+
+void OcclusionCuller::beginFrame(const float viewProjection[16], const float eye[3], float eyeMargin) {
+  enabled_ = (version() >= 2);
+  if (!enabled_) {
+    return;
+  }
+  memcpy(viewProjection_, viewProjection, sizeof viewProjection_);
+
+  while (numBatches_) {
+    Batch& batch = batches_[firstBatch_];
+    if (!batch.last->available()) {
+      break;
+    }
+    resolvedFrame_ = batch.frame;
+    anyResolved_ = true;
+    batch.last->release();
+    firstBatch_ = (firstBatch_ + 1) % MAX_BATCHES;
+    --numBatches_;
+  }
+
+  stats_.culled = stats_.tested = stats_.eyeInside = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    Occludee& object = objects_[i];
+    if (!object.used) {
+      continue;
+    }
+    if (object.query && anyResolved_ && (i32)(resolvedFrame_ - object.queryFrame) >= 0) {
+      resolve_(object);
+    }
+    object.eyeInside = true;
+    for (int j = 0; j < 3; ++j) {
+      if (eye[j] < object.min[j] - eyeMargin || eye[j] > object.max[j] + eyeMargin) {
+        object.eyeInside = false;
+      }
+    }
+    if (object.eyeInside) {
+      object.visible = true;
+      object.occluded = 0;
+      ++stats_.eyeInside;
+    }
+    if (!object.visible) {
+      ++stats_.culled;
+    }
+  }
+}
+
+void OcclusionCuller::resolve_(Occludee& object) {
+  bool passed = (object.query->result() != 0);
+  releaseQuery_(object.query);
+  object.query = nullptr;
+  if (passed) {
+    object.occluded = 0;
+    object.visible = true;
+  } else if (++object.occluded >= hysteresis_) {
+    object.visible = false;
+  }
+}
+
+void OcclusionCuller::releaseQuery_(Query* query) {
+  // Every query belongs to an object, so the pool never outgrows capacity_
+  pool_[poolSize_++] = query;
+}
+
+void OcclusionCuller::init_() {
+  program_ = Program::build(BoxVertexShader, BoxFragmentShader);
+
+  PipelineDesc desc;
+  desc.setDepth(GL_LEQUAL, false);
+  desc.setColorMask(false, false, false, false);
+  pipelineState_ = PipelineState::create(desc);
+
+  vertices_ = StreamBuffer::create(testsPerFrame_ * BOX_SIZE);
+  vertexArray_ = VertexArray::create();
+  vertexArray_->setAttribute(0, vertices_->buffer(), 3, GL_FLOAT, false, BOX_VERTEX_SIZE, 0);
+
+  boxes_ = (float*)_mem::malloc(testsPerFrame_ * (BOX_SIZE + sizeof(ui32)));
+  tested_ = (ui32*)(boxes_ + testsPerFrame_ * BOX_VERTICES * 3);
+}
+
+void OcclusionCuller::test() {
+  // Stop issuing queries if results are MAX_BATCHES frames behind
+  if (!enabled_ || !size_ || numBatches_ == MAX_BATCHES) {
+    return;
+  }
+  if (!program_) {
+    init_();
+  }
+  if (!program_->ready()) {
+    return;
+  }
+
+  size_t maxTests = (testsPerFrame_ < size_ ? testsPerFrame_ : size_);
+  float* vertices = boxes_;
+  ui32* tested = tested_;
+  size_t count = 0;
+  size_t index = (cursor_ < size_ ? cursor_ : 0);
+  for (size_t i = 0; i < size_ && count < maxTests; ++i) {
+    Occludee& object = objects_[index];
+    if (object.used && !object.query && !object.eyeInside) {
+      float* out = vertices + count * BOX_VERTICES * 3;
+      for (ui32 j = 0; j < BOX_VERTICES; ++j, out += 3) {
+        ui32 corner = BoxStrip[j];
+        out[0] = (corner & 1 ? object.max[0] : object.min[0]);
+        out[1] = (corner & 2 ? object.max[1] : object.min[1]);
+        out[2] = (corner & 4 ? object.max[2] : object.min[2]);
+      }
+      tested[count++] = (ui32)index;
+    }
+    index = (index + 1 < size_ ? index + 1 : 0);
+  }
+  cursor_ = (ui32)index;
+
+  size_t offset = StreamBuffer::INVALID_OFFSET;
+  if (count) {
+    offset = vertices_->write(vertices, count * BOX_SIZE, BOX_VERTEX_SIZE);
+  }
+  if (offset == StreamBuffer::INVALID_OFFSET) {
+    return;
+  }
+
+  setPipelineState(pipelineState_);
+  useProgram(program_);
+  program_->setUniformv(program_->getUniform("uViewProjection"), viewProjection_);
+  bindVertexArray(vertexArray_);
+  GLint first = (GLint)(offset / BOX_VERTEX_SIZE);
+  ui32 frame = frameIndex();
+  Query* query = nullptr;
+  for (size_t i = 0; i < count; ++i, first += BOX_VERTICES) {
+    Occludee& object = objects_[tested[i]];
+    query = (poolSize_ ? pool_[--poolSize_] : Query::create());
+    query->begin(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+    glDrawArrays(GL_TRIANGLE_STRIP, first, BOX_VERTICES);
+    FRAME_DRAW(GL_TRIANGLE_STRIP, BOX_VERTICES, 1);
+    Query::end(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+    object.query = query;
+    object.queryFrame = frame;
+  }
+  stats_.tested = (ui32)count;
+
+  Batch& batch = batches_[(firstBatch_ + numBatches_++) % MAX_BATCHES];
+  batch.last = query;
+  batch.frame = frame;
+  query->addref();
+}
+
+}
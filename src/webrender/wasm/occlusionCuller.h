@@ -0,0 +1,131 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Frame-delayed occlusion culling with ANY_SAMPLES_PASSED_CONSERVATIVE queries
+// (WebGL2). Objects are registered with a world-space bounding box. Once the
+// occluders are drawn, test() draws the boxes with color and depth writes off
+// against the current depth buffer, one query each. Results are collected by
+// later beginFrame() calls without waiting, and visible() reports the outcome
+// for deciding which draws to skip.
+//
+// An object is hidden only after `hysteresis` occluded results in a row and
+// becomes visible again on the first result that passes, so objects near the
+// edge of an occluder don't flicker. Objects whose box contains the eye are
+// always visible, because the near plane would clip their box away.
+// On WebGL1 nothing is tested and every object is visible.
+class OcclusionCuller {
+public:
+  enum {
+    INVALID_OBJECT = 0xFFFFFFFFU,
+    DEFAULT_HYSTERESIS = 3,
+    MAX_BATCHES = 4,
+  };
+
+  struct Stats {
+    // Registered objects
+    ui32 objects;
+    // Objects reported hidden this frame
+    ui32 culled;
+    // Bounding boxes drawn by test()
+    ui32 tested;
+    // Objects kept visible because the eye is inside their box
+    ui32 eyeInside;
+  };
+
+  // At most testsPerFrame boxes are drawn each frame; the rest are tested on
+  // following frames in round robin order
+  OcclusionCuller(size_t capacity = 256, size_t testsPerFrame = 1024);
+  ~OcclusionCuller();
+
+  OcclusionCuller(const OcclusionCuller&) = delete;
+  OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+  bool enabled() const {
+    return enabled_;
+  }
+
+  ui32 add(const float min[3], const float max[3]);
+  void remove(ui32 object);
+  void setBounds(ui32 object, const float min[3], const float max[3]);
+
+  void setHysteresis(ui32 frames) {
+    hysteresis_ = (frames ? frames : 1);
+  }
+
+  // Collects available query results. viewProjection is column-major; boxes grown
+  // by eyeMargin (at least the distance to the near plane corners) that contain
+  // eye are visible without a test.
+  void beginFrame(const float viewProjection[16], const float eye[3], float eyeMargin = 0.0f);
+
+  // False if the object was occluded in recent frames and its draws can be skipped
+  bool visible(ui32 object) const {
+    return objects_[object].visible;
+  }
+
+  // Issues queries for objects without one in flight. Call after the occluders
+  // are drawn, with their depth buffer bound; changes the pipeline state, program
+  // and vertex array bindings.
+  void test();
+
+  // Statistics of the current frame, complete after test()
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  struct Occludee {
+    float min[3];
+    float max[3];
+    Query* query;
+    ui32 queryFrame;
+    ui32 occluded;
+    ui32 nextFree;
+    bool used;
+    bool visible;
+    bool eyeInside;
+  };
+  struct Batch {
+    Query* last;
+    ui32 frame;
+  };
+
+  Occludee* objects_;
+  size_t size_ = 0;
+  size_t capacity_;
+  ui32 freeList_ = INVALID_OBJECT;
+  ui32 cursor_ = 0;
+  ui32 hysteresis_ = DEFAULT_HYSTERESIS;
+  size_t testsPerFrame_;
+  bool enabled_ = false;
+
+  // Queries complete in order, so only the last one of each frame is polled
+  Batch batches_[MAX_BATCHES];
+  ui32 firstBatch_ = 0;
+  ui32 numBatches_ = 0;
+  ui32 resolvedFrame_ = 0;
+  bool anyResolved_ = false;
+
+  Query** pool_;
+  ui32 poolSize_ = 0;
+
+  float viewProjection_[16];
+  Program* program_ = nullptr;
+  PipelineState* pipelineState_ = nullptr;
+  StreamBuffer* vertices_ = nullptr;
+  VertexArray* vertexArray_ = nullptr;
+  // Box vertices and object indices of one test(), kept across frames since
+  // queries and stream writes allocate while they are in use
+  float* boxes_ = nullptr;
+  ui32* tested_ = nullptr;
+
+  Stats stats_;
+
+  void init_();
+  void resolve_(Occludee& object);
+  void releaseQuery_(Query* query);
+};
+
+}
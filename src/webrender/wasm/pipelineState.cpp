@@ -0,0 +1,218 @@
+#include "pipelineState.h"
+#include "hash.h"
+
+namespace WebGL
+{
+
+enum {
+  TABLE_SIZE = 256,
+};
+static PipelineState* table_[TABLE_SIZE];
+
+static const GLenum EnableCaps[PipelineDesc::NUM_ENABLES] = {
+  GL_BLEND,
+  GL_DEPTH_TEST,
+  GL_STENCIL_TEST,
+  GL_CULL_FACE,
+  GL_POLYGON_OFFSET_FILL,
+  GL_SCISSOR_TEST,
+  GL_SAMPLE_ALPHA_TO_COVERAGE,
+};
+
+static const size_t DescWords = sizeof(PipelineDesc) / sizeof(ui32);
+
+bool PipelineDesc::operator==(const PipelineDesc& other) const {
+  const ui32* lhs = (const ui32*)this;
+  const ui32* rhs = (const ui32*)&other;
+  for (size_t i = 0; i < DescWords; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ui32 PipelineDesc::hash() const {
+  return hashWords((const ui32*)this, DescWords);
+}
+
+PipelineState* PipelineState::create(const PipelineDesc& desc) {
+  ui32 hash = desc.hash();
+  PipelineState** bucket = &table_[hash & (TABLE_SIZE - 1)];
+  for (PipelineState* state = *bucket; state; state = state->next_) {
+    if (state->hash_ == hash && state->desc_ == desc) {
+      state->addref();
+      return state;
+    }
+  }
+  PipelineState* state = new PipelineState;
+  state->desc_ = desc;
+  state->hash_ = hash;
+  state->next_ = *bucket;
+  *bucket = state;
+  return state;
+}
+
+PipelineState::~PipelineState() {
+  PipelineState** link = &table_[hash_ & (TABLE_SIZE - 1)];
+  while (*link != this) {
+    link = &(*link)->next_;
+  }
+  *link = next_;
+}
+
+static bool stencilFuncEqual(const PipelineDesc::StencilFace& a, const PipelineDesc::StencilFace& b) {
+  return a.func == b.func && a.ref == b.ref && a.readMask == b.readMask;
+}
+static bool stencilOpEqual(const PipelineDesc::StencilFace& a, const PipelineDesc::StencilFace& b) {
+  return a.fail == b.fail && a.zfail == b.zfail && a.zpass == b.zpass;
+}
+
+ui32 PipelineState::onBind(PipelineDesc& current) const {
+  const PipelineDesc& desc = desc_;
+  ui32 calls = 0;
+
+  ui32 toggled = desc.enables ^ current.enables;
+  if (toggled) {
+    for (int i = 0; i < PipelineDesc::NUM_ENABLES; ++i) {
+      if (toggled & (1 << i)) {
+        if (desc.enables & (1 << i)) {
+          glEnable(EnableCaps[i]);
+        } else {
+          glDisable(EnableCaps[i]);
+        }
+        calls += 1;
+      }
+    }
+    current.enables = desc.enables;
+  }
+
+  // Parameters of disabled stages don't affect rendering, so they are left as is until
+  // a state that enables the stage is bound. Write masks also apply to clears and are
+  // always synced.
+  if (desc.enables & PipelineDesc::fBLEND) {
+    if (desc.blendEquationRGB != current.blendEquationRGB || desc.blendEquationAlpha != current.blendEquationAlpha) {
+      glBlendEquationSeparate(desc.blendEquationRGB, desc.blendEquationAlpha);
+      current.blendEquationRGB = desc.blendEquationRGB;
+      current.blendEquationAlpha = desc.blendEquationAlpha;
+      calls += 1;
+    }
+    if (desc.blendSrcRGB != current.blendSrcRGB || desc.blendDstRGB != current.blendDstRGB ||
+        desc.blendSrcAlpha != current.blendSrcAlpha || desc.blendDstAlpha != current.blendDstAlpha) {
+      glBlendFuncSeparate(desc.blendSrcRGB, desc.blendDstRGB, desc.blendSrcAlpha, desc.blendDstAlpha);
+      current.blendSrcRGB = desc.blendSrcRGB;
+      current.blendDstRGB = desc.blendDstRGB;
+      current.blendSrcAlpha = desc.blendSrcAlpha;
+      current.blendDstAlpha = desc.blendDstAlpha;
+      calls += 1;
+    }
+    const ui32* color = (const ui32*)desc.blendColor;
+    const ui32* currentColor = (const ui32*)current.blendColor;
+    if (color[0] != currentColor[0] || color[1] != currentColor[1] || color[2] != currentColor[2] || color[3] != currentColor[3]) {
+      glBlendColor(desc.blendColor[0], desc.blendColor[1], desc.blendColor[2], desc.blendColor[3]);
+      for (int i = 0; i < 4; ++i) {
+        current.blendColor[i] = desc.blendColor[i];
+      }
+      calls += 1;
+    }
+  }
+
+  if ((desc.enables & PipelineDesc::fDEPTH_TEST) && desc.depthFunc != current.depthFunc) {
+    glDepthFunc(desc.depthFunc);
+    current.depthFunc = desc.depthFunc;
+    calls += 1;
+  }
+  if (desc.depthMask != current.depthMask) {
+    glDepthMask(desc.depthMask != 0);
+    current.depthMask = desc.depthMask;
+    calls += 1;
+  }
+
+  const PipelineDesc::StencilFace& front = desc.stencil[PipelineDesc::STENCIL_FRONT];
+  const PipelineDesc::StencilFace& back = desc.stencil[PipelineDesc::STENCIL_BACK];
+  PipelineDesc::StencilFace& curFront = current.stencil[PipelineDesc::STENCIL_FRONT];
+  PipelineDesc::StencilFace& curBack = current.stencil[PipelineDesc::STENCIL_BACK];
+  if (desc.enables & PipelineDesc::fSTENCIL_TEST) {
+    bool frontFunc = !stencilFuncEqual(front, curFront);
+    bool backFunc = !stencilFuncEqual(back, curBack);
+    if (frontFunc && backFunc && stencilFuncEqual(front, back)) {
+      glStencilFunc(front.func, front.ref, front.readMask);
+      calls += 1;
+    } else {
+      if (frontFunc) {
+        glStencilFuncSeparate(GL_FRONT, front.func, front.ref, front.readMask);
+        calls += 1;
+      }
+      if (backFunc) {
+        glStencilFuncSeparate(GL_BACK, back.func, back.ref, back.readMask);
+        calls += 1;
+      }
+    }
+    bool frontOp = !stencilOpEqual(front, curFront);
+    bool backOp = !stencilOpEqual(back, curBack);
+    if (frontOp && backOp && stencilOpEqual(front, back)) {
+      glStencilOp(front.fail, front.zfail, front.zpass);
+      calls += 1;
+    } else {
+      if (frontOp) {
+        glStencilOpSeparate(GL_FRONT, front.fail, front.zfail, front.zpass);
+        calls += 1;
+      }
+      if (backOp) {
+        glStencilOpSeparate(GL_BACK, back.fail, back.zfail, back.zpass);
+        calls += 1;
+      }
+    }
+    ui32 frontMask = curFront.writeMask;
+    ui32 backMask = curBack.writeMask;
+    curFront = front;
+    curBack = back;
+    curFront.writeMask = frontMask;
+    curBack.writeMask = backMask;
+  }
+  if (front.writeMask != curFront.writeMask && back.writeMask != curBack.writeMask && front.writeMask == back.writeMask) {
+    glStencilMask(front.writeMask);
+    curFront.writeMask = curBack.writeMask = front.writeMask;
+    calls += 1;
+  } else {
+    if (front.writeMask != curFront.writeMask) {
+      glStencilMaskSeparate(GL_FRONT, front.writeMask);
+      curFront.writeMask = front.writeMask;
+      calls += 1;
+    }
+    if (back.writeMask != curBack.writeMask) {
+      glStencilMaskSeparate(GL_BACK, back.writeMask);
+      curBack.writeMask = back.writeMask;
+      calls += 1;
+    }
+  }
+
+  if ((desc.enables & PipelineDesc::fCULL_FACE) && desc.cullFace != current.cullFace) {
+    glCullFace(desc.cullFace);
+    current.cullFace = desc.cullFace;
+    calls += 1;
+  }
+  if (desc.frontFace != current.frontFace) {
+    glFrontFace(desc.frontFace);
+    current.frontFace = desc.frontFace;
+    calls += 1;
+  }
+
+  if ((desc.enables & PipelineDesc::fPOLYGON_OFFSET_FILL) &&
+      (desc.polygonOffsetFactor != current.polygonOffsetFactor || desc.polygonOffsetUnits != current.polygonOffsetUnits)) {
+    glPolygonOffset(desc.polygonOffsetFactor, desc.polygonOffsetUnits);
+    current.polygonOffsetFactor = desc.polygonOffsetFactor;
+    current.polygonOffsetUnits = desc.polygonOffsetUnits;
+    calls += 1;
+  }
+
+  if (desc.colorMask != current.colorMask) {
+    glColorMask((desc.colorMask & 1) != 0, (desc.colorMask & 2) != 0, (desc.colorMask & 4) != 0, (desc.colorMask & 8) != 0);
+    current.colorMask = desc.colorMask;
+    calls += 1;
+  }
+
+  return calls;
+}
+
+}
@@ -0,0 +1,105 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Fixed-function state that changes between materials. All fields are 32-bit words so
+// descriptors can be hashed and compared as raw memory.
+struct PipelineDesc {
+  enum {
+    fBLEND                = 0x0001,
+    fDEPTH_TEST           = 0x0002,
+    fSTENCIL_TEST         = 0x0004,
+    fCULL_FACE            = 0x0008,
+    fPOLYGON_OFFSET_FILL  = 0x0010,
+    fSCISSOR_TEST         = 0x0020,
+    fALPHA_TO_COVERAGE    = 0x0040,
+    NUM_ENABLES           = 7,
+  };
+  enum {
+    STENCIL_FRONT = 0,
+    STENCIL_BACK = 1,
+  };
+  struct StencilFace {
+    ui32 func = GL_ALWAYS;
+    ui32 ref = 0;
+    ui32 readMask = 0xFFFFFFFFU;
+    ui32 fail = GL_KEEP;
+    ui32 zfail = GL_KEEP;
+    ui32 zpass = GL_KEEP;
+    ui32 writeMask = 0xFFFFFFFFU;
+  };
+
+  ui32 enables = 0;
+  ui32 blendEquationRGB = GL_FUNC_ADD;
+  ui32 blendEquationAlpha = GL_FUNC_ADD;
+  ui32 blendSrcRGB = GL_ONE;
+  ui32 blendDstRGB = GL_ZERO;
+  ui32 blendSrcAlpha = GL_ONE;
+  ui32 blendDstAlpha = GL_ZERO;
+  float blendColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+  ui32 depthFunc = GL_LESS;
+  ui32 depthMask = 1;
+  StencilFace stencil[2];
+  ui32 cullFace = GL_BACK;
+  ui32 frontFace = GL_CCW;
+  float polygonOffsetFactor = 0.0f;
+  float polygonOffsetUnits = 0.0f;
+  ui32 colorMask = 0xF;
+
+  void setBlend(GLenum src, GLenum dst, GLenum equation = GL_FUNC_ADD) {
+    enables |= fBLEND;
+    blendSrcRGB = blendSrcAlpha = src;
+    blendDstRGB = blendDstAlpha = dst;
+    blendEquationRGB = blendEquationAlpha = equation;
+  }
+  void setDepth(GLenum func, bool write = true) {
+    enables |= fDEPTH_TEST;
+    depthFunc = func;
+    depthMask = write;
+  }
+  void setCull(GLenum face, GLenum front = GL_CCW) {
+    enables |= fCULL_FACE;
+    cullFace = face;
+    frontFace = front;
+  }
+  void setColorMask(bool red, bool green, bool blue, bool alpha) {
+    colorMask = (red ? 1 : 0) | (green ? 2 : 0) | (blue ? 4 : 0) | (alpha ? 8 : 0);
+  }
+
+  bool operator==(const PipelineDesc& other) const;
+  bool operator!=(const PipelineDesc& other) const {
+    return !(*this == other);
+  }
+  ui32 hash() const;
+};
+
+// Immutable, interned pipeline state: equal descriptors always yield the same object,
+// so state changes can be detected with a pointer compare.
+class PipelineState : public Object<PipelineState> {
+public:
+  static PipelineState* create(const PipelineDesc& desc);
+  ~PipelineState();
+
+  enum {
+    // Calls a non-diffing implementation would issue for every state change
+    NUM_STATE_CALLS = PipelineDesc::NUM_ENABLES + 15,
+  };
+
+  const PipelineDesc& desc() const {
+    return desc_;
+  }
+
+  // Issues the GL calls that transition from current to this state, updates current
+  // and returns the number of calls issued.
+  ui32 onBind(PipelineDesc& current) const;
+
+private:
+  PipelineState() {}
+  PipelineDesc desc_;
+  ui32 hash_;
+  PipelineState* next_;
+};
+
+}
@@ -1,28 +1,339 @@
 #include "program.h"
 #include "shader.h"
+#include "hash.h"
+#include "malloc.h"
 
 namespace WebGL
 {
 
+ui32 Program::nextId_ = 0;
+
+ui32 getUniformLayout(GLenum type, GLenum& baseType) {
+  switch (type) {
+  case GL_FLOAT:              baseType = GL_FLOAT; return 1;
+  case GL_FLOAT_VEC2:         baseType = GL_FLOAT; return 2;
+  case GL_FLOAT_VEC3:         baseType = GL_FLOAT; return 3;
+  case GL_FLOAT_VEC4:         baseType = GL_FLOAT; return 4;
+  case GL_FLOAT_MAT2:         baseType = GL_FLOAT; return 4;
+  case GL_FLOAT_MAT3:         baseType = GL_FLOAT; return 9;
+  case GL_FLOAT_MAT4:         baseType = GL_FLOAT; return 16;
+  case GL_FLOAT_MAT2x3:       baseType = GL_FLOAT; return 6;
+  case GL_FLOAT_MAT3x2:       baseType = GL_FLOAT; return 6;
+  case GL_FLOAT_MAT2x4:       baseType = GL_FLOAT; return 8;
+  case GL_FLOAT_MAT4x2:       baseType = GL_FLOAT; return 8;
+  case GL_FLOAT_MAT3x4:       baseType = GL_FLOAT; return 12;
+  case GL_FLOAT_MAT4x3:       baseType = GL_FLOAT; return 12;
+  case GL_INT_VEC2:           baseType = GL_INT; return 2;
+  case GL_INT_VEC3:           baseType = GL_INT; return 3;
+  case GL_INT_VEC4:           baseType = GL_INT; return 4;
+  case GL_BOOL_VEC2:          baseType = GL_INT; return 2;
+  case GL_BOOL_VEC3:          baseType = GL_INT; return 3;
+  case GL_BOOL_VEC4:          baseType = GL_INT; return 4;
+  case GL_UNSIGNED_INT:       baseType = GL_UNSIGNED_INT; return 1;
+  case GL_UNSIGNED_INT_VEC2:  baseType = GL_UNSIGNED_INT; return 2;
+  case GL_UNSIGNED_INT_VEC3:  baseType = GL_UNSIGNED_INT; return 3;
+  case GL_UNSIGNED_INT_VEC4:  baseType = GL_UNSIGNED_INT; return 4;
+  default:
+    // GL_INT, GL_BOOL and all sampler types
+    baseType = GL_INT;
+    return 1;
+  }
+}
+
+enum {
+  TABLE_SIZE = 256,
+};
+static Program* table_[TABLE_SIZE];
+
+void Program::link_(Shader* vertex, Shader* fragment) {
+  glCreateProgram(this);
+  glAttachShader(this, vertex);
+  glAttachShader(this, fragment);
+  glLinkProgram(this);
+  glDetachShader(this, vertex);
+  glDetachShader(this, fragment);
+  pollFrame_ = WebGL::frameIndex();
+}
+
 Program* Program::create(Shader* vertex, Shader* fragment) {
   Program* program = new Program;
-  glCreateProgram(program);
-  glAttachShader(program, vertex);
-  glAttachShader(program, fragment);
-  glLinkProgram(program);
-  glDetachShader(program, vertex);
-  glDetachShader(program, fragment);
-}
-
-Program* Program::build(char const* vertex, char const* fragment) {
-  Shader* vshader = Shader::create(GL_VERTEX_SHADER);
-  vshader->compile(vertex);
-  Shader* fshader = Shader::create(GL_FRAGMENT_SHADER);
-  fshader->compile(fragment);
-  Program* program = create(vshader, fshader);
-  vshader->release();
-  fshader->release();
+  program->link_(vertex, fragment);
+  program->finishLink_();
   return program;
 }
 
+Program* Program::build(char const* vertex, char const* fragment, char const* defines) {
+  Ref<Shader> vshader = Ref<Shader>::adopt(Shader::get(GL_VERTEX_SHADER, vertex, defines));
+  Ref<Shader> fshader = Ref<Shader>::adopt(Shader::get(GL_FRAGMENT_SHADER, fragment, defines));
+  ui32 hash = hashMix(vshader->hash(), fshader->hash());
+  Program** bucket = &table_[hash & (TABLE_SIZE - 1)];
+  for (Program* program = *bucket; program; program = program->next_) {
+    if (program->vertex_ == vshader && program->fragment_ == fshader) {
+      program->addref();
+      return program;
+    }
+  }
+  // The program keeps its shaders, so their addresses identify it
+  Program* program = new Program;
+  program->vertex_ = move(vshader);
+  program->fragment_ = move(fshader);
+  program->hash_ = hash;
+  program->next_ = *bucket;
+  *bucket = program;
+  program->link_(program->vertex_, program->fragment_);
+  return program;
+}
+
+Program::~Program() {
+  glDeleteProgram(this);
+  if (uniforms_) {
+    _mem::free(uniforms_);
+  }
+  if (vertex_) {
+    Program** link = &table_[hash_ & (TABLE_SIZE - 1)];
+    while (*link != this) {
+      link = &(*link)->next_;
+    }
+    *link = next_;
+  }
+}
+
+// Completion status only changes between browser tasks, so it is checked at most
+// once per frame
+bool Program::poll_() {
+  if (WebGL::getFeature(FEATURE_PARALLEL_COMPILE)) {
+    ui32 frame = WebGL::frameIndex();
+    if (pollFrame_ == frame) {
+      return false;
+    }
+    pollFrame_ = frame;
+    if (!glGetProgrami(this, GL_COMPLETION_STATUS_KHR)) {
+      return false;
+    }
+  }
+  finishLink_();
+  return status_ == LINK_DONE;
+}
+
+void Program::finishLink_() {
+  if (glGetProgrami(this, GL_LINK_STATUS)) {
+    status_ = LINK_DONE;
+    reflect_();
+  } else {
+    status_ = LINK_FAILED;
+  }
+}
+
+bool Program::isCurrent_() const {
+  return WebGL::getProgram() == this;
+}
+
+void Program::reflect_() {
+  enum {
+    MAX_NAME_LENGTH = 256,
+  };
+  ui32 count = glGetProgrami(this, GL_ACTIVE_UNIFORMS);
+  if (!count) {
+    return;
+  }
+
+  // Gather into scratch memory first; members of uniform blocks are skipped, so the
+  // final sizes are only known afterwards. The scratch comes from malloc rather than
+  // sbrk, since the table is allocated (and GL calls may allocate) while it is in use.
+  size_t scratchSize = count * (sizeof(Uniform) + MAX_NAME_LENGTH + 2 * sizeof(GLint));
+  Uniform* uniforms = (Uniform*)_mem::malloc(scratchSize);
+  GLint* blockIndices = (GLint*)(uniforms + count);
+  GLuint* indices = (GLuint*)(blockIndices + count);
+  char* names = (char*)(indices + count);
+
+  for (ui32 i = 0; i < count; ++i) {
+    blockIndices[i] = -1;
+    indices[i] = i;
+  }
+  if (WebGL::version() >= 2) {
+    glGetActiveUniformsiv(this, count, indices, GL_UNIFORM_BLOCK_INDEX, blockIndices);
+  }
+
+  ui32 numUniforms = 0;
+  ui32 numValues = 0;
+  ui32 namesSize = 0;
+  for (ui32 i = 0; i < count; ++i) {
+    char* name = names + namesSize;
+    GLint size = 0;
+    GLenum type = 0;
+    name[0] = 0;
+    glGetActiveUniform(this, i, MAX_NAME_LENGTH, nullptr, &size, &type, name);
+    if (blockIndices[i] != -1 || !name[0]) {
+      continue;
+    }
+    ui32 length = 0;
+    while (name[length]) {
+      ++length;
+    }
+    // Arrays are reported as name[0]
+    if (length > 3 && name[length - 3] == '[' && name[length - 2] == '0' && name[length - 1] == ']') {
+      length -= 3;
+      name[length] = 0;
+    }
+
+    Uniform& uniform = uniforms[numUniforms++];
+    GLenum baseType;
+    uniform.location = glGetUniformLocation(this, name);
+    uniform.type = type;
+    uniform.size = (size > 0 ? size : 1);
+    uniform.components = getUniformLayout(type, baseType);
+    uniform.offset = numValues;
+    uniform.nameHash = hashString(name);
+    uniform.name = namesSize;
+    numValues += uniform.size * uniform.components;
+    namesSize += length + 1;
+  }
+
+  if (numUniforms) {
+    size_t dirtyWords = (numUniforms + 31) / 32;
+    size_t tableSize = numUniforms * sizeof(Uniform) + (dirtyWords + numValues) * sizeof(ui32);
+    uniforms_ = (Uniform*)_mem::malloc(tableSize + namesSize);
+    dirty_ = (ui32*)(uniforms_ + numUniforms);
+    values_ = dirty_ + dirtyWords;
+    names_ = (char*)(values_ + numValues);
+    numUniforms_ = numUniforms;
+    memcpy(uniforms_, uniforms, numUniforms * sizeof(Uniform));
+    // Uniforms start out as zero after linking
+    memset(dirty_, 0, (dirtyWords + numValues) * sizeof(ui32));
+    memcpy(names_, names, namesSize);
+  }
+
+  _mem::free(uniforms);
+}
+
+void Program::setUniformBlockBinding(const char* name, GLuint binding) {
+  GLuint index = glGetUniformBlockIndex(this, name);
+  if (index != GL_INVALID_INDEX) {
+    glUniformBlockBinding(this, index, binding);
+  }
+}
+
+int Program::getUniform(const char* name) const {
+  ui32 hash = hashString(name);
+  for (ui32 i = 0; i < numUniforms_; ++i) {
+    if (uniforms_[i].nameHash == hash && stringEqual(names_ + uniforms_[i].name, name)) {
+      return i;
+    }
+  }
+  return INVALID_UNIFORM;
+}
+
+void Program::upload_(const Uniform& uniform) {
+  GLint location = uniform.location;
+  GLsizei size = uniform.size;
+  const ui32* value = values_ + uniform.offset;
+  const GLfloat* fvalue = (const GLfloat*)value;
+  const GLint* ivalue = (const GLint*)value;
+  switch (uniform.type) {
+  case GL_FLOAT:              glUniform1fv(location, size, fvalue); break;
+  case GL_FLOAT_VEC2:         glUniform2fv(location, size, fvalue); break;
+  case GL_FLOAT_VEC3:         glUniform3fv(location, size, fvalue); break;
+  case GL_FLOAT_VEC4:         glUniform4fv(location, size, fvalue); break;
+  case GL_FLOAT_MAT2:         glUniformMatrix2fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT3:         glUniformMatrix3fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT4:         glUniformMatrix4fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT2x3:       glUniformMatrix2x3fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT3x2:       glUniformMatrix3x2fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT2x4:       glUniformMatrix2x4fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT4x2:       glUniformMatrix4x2fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT3x4:       glUniformMatrix3x4fv(location, size, false, fvalue); break;
+  case GL_FLOAT_MAT4x3:       glUniformMatrix4x3fv(location, size, false, fvalue); break;
+  case GL_INT_VEC2:
+  case GL_BOOL_VEC2:          glUniform2iv(location, size, ivalue); break;
+  case GL_INT_VEC3:
+  case GL_BOOL_VEC3:          glUniform3iv(location, size, ivalue); break;
+  case GL_INT_VEC4:
+  case GL_BOOL_VEC4:          glUniform4iv(location, size, ivalue); break;
+  case GL_UNSIGNED_INT:       glUniform1uiv(location, size, (const GLuint*)value); break;
+  case GL_UNSIGNED_INT_VEC2:  glUniform2uiv(location, size, (const GLuint*)value); break;
+  case GL_UNSIGNED_INT_VEC3:  glUniform3uiv(location, size, (const GLuint*)value); break;
+  case GL_UNSIGNED_INT_VEC4:  glUniform4uiv(location, size, (const GLuint*)value); break;
+  default:                    glUniform1iv(location, size, ivalue); break;
+  }
+}
+
+void Program::setValue_(int index, GLenum baseType, const ui32* value, size_t count, size_t first) {
+  if (index < 0) {
+    return;
+  }
+  const Uniform& uniform = uniforms_[index];
+  GLenum uniformBaseType;
+  getUniformLayout(uniform.type, uniformBaseType);
+  assert(uniformBaseType == baseType);
+  assert(first + count <= uniform.size);
+
+  ui32* dst = values_ + uniform.offset + first * uniform.components;
+  size_t words = count * uniform.components;
+  size_t i = 0;
+  while (i < words && dst[i] == value[i]) {
+    ++i;
+  }
+  if (i == words) {
+    return;
+  }
+  for (; i < words; ++i) {
+    dst[i] = value[i];
+  }
+
+  if (isCurrent_()) {
+    upload_(uniform);
+  } else if (!(dirty_[index >> 5] & (1U << (index & 31)))) {
+    dirty_[index >> 5] |= (1U << (index & 31));
+    numDirty_ += 1;
+  }
+}
+
+void Program::setUniform(int index, float x) {
+  setUniformv(index, &x);
+}
+void Program::setUniform(int index, float x, float y) {
+  float value[2] = {x, y};
+  setUniformv(index, value);
+}
+void Program::setUniform(int index, float x, float y, float z) {
+  float value[3] = {x, y, z};
+  setUniformv(index, value);
+}
+void Program::setUniform(int index, float x, float y, float z, float w) {
+  float value[4] = {x, y, z, w};
+  setUniformv(index, value);
+}
+void Program::setUniform(int index, i32 x) {
+  setUniformv(index, &x);
+}
+void Program::setUniform(int index, ui32 x) {
+  setUniformv(index, &x);
+}
+
+void Program::setUniformv(int index, const float* value, size_t count, size_t first) {
+  setValue_(index, GL_FLOAT, (const ui32*)value, count, first);
+}
+void Program::setUniformv(int index, const i32* value, size_t count, size_t first) {
+  setValue_(index, GL_INT, (const ui32*)value, count, first);
+}
+void Program::setUniformv(int index, const ui32* value, size_t count, size_t first) {
+  setValue_(index, GL_UNSIGNED_INT, value, count, first);
+}
+
+void Program::onBind() {
+  glUseProgram(this);
+  if (numDirty_) {
+    for (ui32 i = 0; i < numUniforms_; i += 32) {
+      ui32 mask = dirty_[i >> 5];
+      dirty_[i >> 5] = 0;
+      for (ui32 j = 0; mask; ++j, mask >>= 1) {
+        if (mask & 1) {
+          upload_(uniforms_[i + j]);
+        }
+      }
+    }
+    numDirty_ = 0;
+  }
+}
+
 }
@@ -1,24 +1,118 @@
 #pragma once
 #include "webgl.h"
+#include "shader.h"
 
 namespace WebGL
 {
 
+// Returns the number of 32-bit words per array element of a uniform type, and the
+// component type its setters take (GL_FLOAT, GL_INT or GL_UNSIGNED_INT)
+ui32 getUniformLayout(GLenum type, GLenum& baseType);
+
 class Program : public Object<Program> {
 public:
+  // Links and waits for the result
   static Program* create(Shader* vertex, Shader* fragment);
-  static Program* build(char const* vertex, char const* fragment);
+  // Cached by vertex source, fragment source and defines (see Shader::get); programs
+  // built from the same sources share one object and their shaders are shared with
+  // other programs. The link is not waited on: the program can only be used once
+  // ready() returns true, which with KHR_parallel_shader_compile happens on a later
+  // frame without blocking. Without the extension, the first ready() call waits.
+  static Program* build(char const* vertex, char const* fragment, char const* defines = nullptr);
+
+  ~Program();
 
-  ~Program() {
-    glDeleteProgram(this);
+  bool ready() {
+    return status_ == LINK_DONE || (status_ == LINK_PENDING && poll_());
+  }
+  bool failed() const {
+    return status_ == LINK_FAILED;
   }
 
   void validate() {
     glValidateProgram(this);
   }
 
+  // Small sequential id, used to group draws by program
+  ui32 id() const {
+    return id_;
+  }
+
+  // Active uniforms are reflected once the link completes. Setters compare against a shadow copy
+  // and only call glUniform* when the value changes; if the program is not current the
+  // upload is deferred until it is bound.
+  enum {
+    INVALID_UNIFORM = -1,
+  };
+  size_t numUniforms() const {
+    return numUniforms_;
+  }
+  int getUniform(const char* name) const;
+  const char* uniformName(int index) const {
+    return names_ + uniforms_[index].name;
+  }
+  GLenum uniformType(int index) const {
+    return uniforms_[index].type;
+  }
+  size_t uniformSize(int index) const {
+    return uniforms_[index].size;
+  }
+
+  void setUniform(int index, float x);
+  void setUniform(int index, float x, float y);
+  void setUniform(int index, float x, float y, float z);
+  void setUniform(int index, float x, float y, float z, float w);
+  void setUniform(int index, i32 x);
+  void setUniform(int index, ui32 x);
+  // Sets count array elements starting at element first; matrices are column-major
+  void setUniformv(int index, const float* value, size_t count = 1, size_t first = 0);
+  void setUniformv(int index, const i32* value, size_t count = 1, size_t first = 0);
+  void setUniformv(int index, const ui32* value, size_t count = 1, size_t first = 0);
+
+  // Assigns a uniform block to a GL_UNIFORM_BUFFER binding point (WebGL2)
+  void setUniformBlockBinding(const char* name, GLuint binding);
+
+  void onBind();
+
 private:
   Program() {}
+  static ui32 nextId_;
+  ui32 id_ = nextId_++;
+  enum {
+    LINK_PENDING,
+    LINK_DONE,
+    LINK_FAILED,
+  };
+  ui32 status_ = LINK_PENDING;
+  ui32 pollFrame_;
+  // Set for programs from build()
+  Ref<Shader> vertex_;
+  Ref<Shader> fragment_;
+  ui32 hash_;
+  Program* next_;
+  struct Uniform {
+    GLint location;
+    ui32 type;
+    ui32 size;
+    ui32 components;
+    ui32 offset;
+    ui32 nameHash;
+    ui32 name;
+  };
+  ui32 numUniforms_ = 0;
+  ui32 numDirty_ = 0;
+  Uniform* uniforms_ = nullptr;
+  ui32* dirty_ = nullptr;
+  ui32* values_ = nullptr;
+  char* names_ = nullptr;
+
+  bool isCurrent_() const;
+  void link_(Shader* vertex, Shader* fragment);
+  bool poll_();
+  void finishLink_();
+  void reflect_();
+  void setValue_(int index, GLenum baseType, const ui32* value, size_t count, size_t first);
+  void upload_(const Uniform& uniform);
 };
 
 }
@@ -0,0 +1,39 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Query object (WebGL2 or EXT_disjoint_timer_query). Results only become
+// available between browser tasks, so they are polled on later frames.
+class Query : public Object<Query> {
+public:
+  static Query* create() {
+    Query* query = new Query;
+    glCreateQuery(query);
+    return query;
+  }
+  ~Query() {
+    glDeleteQuery(this);
+  }
+
+  void begin(GLenum target) {
+    glBeginQuery(target, this);
+  }
+  static void end(GLenum target) {
+    glEndQuery(target);
+  }
+
+  bool available() {
+    return glGetQueryParameter(this, GL_QUERY_RESULT_AVAILABLE) != 0;
+  }
+  // Only valid once available() has returned true
+  GLuint result() {
+    return (GLuint) glGetQueryParameter(this, GL_QUERY_RESULT);
+  }
+
+private:
+  Query() {}
+};
+
+}
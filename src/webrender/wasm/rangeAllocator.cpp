@@ -0,0 +1,92 @@
+#include "rangeAllocator.h"
+#include "malloc.h"
+
+RangeAllocator::RangeAllocator(ui32 capacity) {
+  reset(capacity);
+}
+
+RangeAllocator::~RangeAllocator() {
+  if (ranges_) {
+    _mem::free(ranges_);
+  }
+}
+
+void RangeAllocator::reset(ui32 capacity) {
+  capacity_ = capacity;
+  used_ = 0;
+  size_ = 0;
+  if (capacity) {
+    insert_(0, 0, capacity);
+  }
+}
+
+void RangeAllocator::insert_(ui32 index, ui32 offset, ui32 size) {
+  if (size_ == maxSize_) {
+    maxSize_ = (maxSize_ ? maxSize_ * 2 : 16);
+    ranges_ = (Range*)_mem::realloc(ranges_, maxSize_ * sizeof(Range));
+  }
+  for (ui32 i = size_; i > index; --i) {
+    ranges_[i] = ranges_[i - 1];
+  }
+  ranges_[index].offset = offset;
+  ranges_[index].size = size;
+  ++size_;
+}
+
+void RangeAllocator::erase_(ui32 index) {
+  --size_;
+  for (ui32 i = index; i < size_; ++i) {
+    ranges_[i] = ranges_[i + 1];
+  }
+}
+
+ui32 RangeAllocator::allocate(ui32 size) {
+  ui32 best = INVALID_OFFSET;
+  for (ui32 i = 0; i < size_; ++i) {
+    if (ranges_[i].size >= size && (best == INVALID_OFFSET || ranges_[i].size < ranges_[best].size)) {
+      best = i;
+      if (ranges_[i].size == size) {
+        break;
+      }
+    }
+  }
+  if (best == INVALID_OFFSET) {
+    return INVALID_OFFSET;
+  }
+  Range& range = ranges_[best];
+  ui32 offset = range.offset;
+  range.offset += size;
+  range.size -= size;
+  if (!range.size) {
+    erase_(best);
+  }
+  used_ += size;
+  return offset;
+}
+
+void RangeAllocator::free(ui32 offset, ui32 size) {
+  assert(offset + size <= capacity_);
+  ui32 lo = 0, hi = size_;
+  while (lo < hi) {
+    ui32 mid = (lo + hi) / 2;
+    if (ranges_[mid].offset < offset) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  used_ -= size;
+  bool mergePrev = (lo > 0 && ranges_[lo - 1].offset + ranges_[lo - 1].size == offset);
+  bool mergeNext = (lo < size_ && offset + size == ranges_[lo].offset);
+  if (mergePrev && mergeNext) {
+    ranges_[lo - 1].size += size + ranges_[lo].size;
+    erase_(lo);
+  } else if (mergePrev) {
+    ranges_[lo - 1].size += size;
+  } else if (mergeNext) {
+    ranges_[lo].offset = offset;
+    ranges_[lo].size += size;
+  } else {
+    insert_(lo, offset, size);
+  }
+}
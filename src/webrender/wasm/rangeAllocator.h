@@ -0,0 +1,52 @@
+#pragma once
+#include "common.h"
+
+// Free-list allocator for ranges of [0, capacity). Free ranges are kept sorted by
+// offset and merged with their neighbors on release; allocation picks the smallest
+// range that fits. Only the bookkeeping lives here, the caller owns the storage.
+class RangeAllocator {
+public:
+  enum {
+    INVALID_OFFSET = 0xFFFFFFFFU,
+  };
+
+  RangeAllocator(ui32 capacity = 0);
+  ~RangeAllocator();
+
+  RangeAllocator(const RangeAllocator&) = delete;
+  RangeAllocator& operator=(const RangeAllocator&) = delete;
+
+  // Drops all allocations
+  void reset(ui32 capacity);
+
+  ui32 allocate(ui32 size);
+  void free(ui32 offset, ui32 size);
+
+  ui32 capacity() const {
+    return capacity_;
+  }
+  ui32 used() const {
+    return used_;
+  }
+  ui32 fragments() const {
+    return size_;
+  }
+  // True if all free space is in one range at the end
+  bool packed() const {
+    return size_ == 0 || (size_ == 1 && ranges_[0].offset + ranges_[0].size == capacity_);
+  }
+
+private:
+  struct Range {
+    ui32 offset;
+    ui32 size;
+  };
+  Range* ranges_ = nullptr;
+  ui32 size_ = 0;
+  ui32 maxSize_ = 0;
+  ui32 capacity_ = 0;
+  ui32 used_ = 0;
+
+  void insert_(ui32 index, ui32 offset, ui32 size);
+  void erase_(ui32 index);
+};
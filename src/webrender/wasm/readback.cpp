@@ -0,0 +1,186 @@
+#include "readback.h"
+#include "buffer.h"
+#include "frameBuffer.h"
+#include "sync.h"
+#include "malloc.h"
+#include "memoryTracker.h"
+
+namespace WebGL
+{
+
+// Rows are padded to the default PACK_ALIGNMENT of 4
+static size_t getPixelDataSize(size_t width, size_t height, GLenum format, GLenum type) {
+  size_t row = (width * getPixelSize(format, type) + 3) & ~(size_t)3;
+  return row * height;
+}
+
+// Completed requests without a callback hold their data until released
+bool ReadbackQueue::isReady_(const Request& request) {
+  return request.data && !request.buffer && !request.callback;
+}
+
+ReadbackQueue::~ReadbackQueue() {
+  for (int i = 0; i < MAX_REQUESTS; ++i) {
+    if (requests_[i].handle != INVALID_HANDLE) {
+      free_(requests_[i]);
+    }
+  }
+  for (ui32 i = 0; i < poolSize_; ++i) {
+    pool_[i]->release();
+  }
+}
+
+ReadbackQueue::Request* ReadbackQueue::find_(ui32 handle) const {
+  if (handle == INVALID_HANDLE) {
+    return nullptr;
+  }
+  for (int i = 0; i < MAX_REQUESTS; ++i) {
+    if (requests_[i].handle == handle) {
+      return const_cast<Request*>(&requests_[i]);
+    }
+  }
+  return nullptr;
+}
+
+Buffer* ReadbackQueue::acquireBuffer_(size_t size) {
+  int best = -1;
+  for (ui32 i = 0; i < poolSize_; ++i) {
+    if (pool_[i]->size() >= size && (best < 0 || pool_[i]->size() < pool_[best]->size())) {
+      best = i;
+    }
+  }
+  if (best >= 0) {
+    Buffer* buffer = pool_[best];
+    pool_[best] = pool_[--poolSize_];
+    return buffer;
+  }
+  return Buffer::create(size, nullptr, GL_STREAM_READ, GL_PIXEL_PACK_BUFFER);
+}
+
+void ReadbackQueue::releaseBuffer_(Buffer* buffer) {
+  if (poolSize_ < MAX_POOLED_BUFFERS) {
+    pool_[poolSize_++] = buffer;
+    return;
+  }
+  // Pool is full: keep the larger buffers
+  ui32 smallest = 0;
+  for (ui32 i = 1; i < poolSize_; ++i) {
+    if (pool_[i]->size() < pool_[smallest]->size()) {
+      smallest = i;
+    }
+  }
+  if (pool_[smallest]->size() < buffer->size()) {
+    pool_[smallest]->release();
+    pool_[smallest] = buffer;
+  } else {
+    buffer->release();
+  }
+}
+
+ui32 ReadbackQueue::read(FrameBuffer* frameBuffer, GLenum attachment, int x, int y, size_t width, size_t height,
+                         GLenum format, GLenum type, Callback callback, void* user) {
+  Request* request = nullptr;
+  for (int i = 0; i < MAX_REQUESTS && !request; ++i) {
+    if (requests_[i].handle == INVALID_HANDLE) {
+      request = &requests_[i];
+    }
+  }
+  if (!request) {
+    return INVALID_HANDLE;
+  }
+
+  request->handle = nextHandle_++;
+  if (nextHandle_ == INVALID_HANDLE) {
+    nextHandle_ = 1;
+  }
+  request->size = getPixelDataSize(width, height, format, type);
+  request->callback = callback;
+  request->user = user;
+
+  if (WebGL::getFeature(FEATURE_FENCE_SYNC)) {
+    request->buffer = acquireBuffer_(request->size);
+    frameBuffer->readPixelsBuffer(attachment, x, y, width, height, format, type, request->buffer);
+    request->fence = Sync::create();
+  } else {
+    request->data = _mem::malloc(request->size);
+    frameBuffer->readPixels(attachment, x, y, width, height, format, type, request->data);
+  }
+  return request->handle;
+}
+
+void ReadbackQueue::complete_(Request& request) {
+  if (request.buffer) {
+    if (!request.data) {
+      request.data = _mem::malloc(request.size);
+    }
+    request.buffer->getData(0, request.size, request.data);
+    releaseBuffer_(request.buffer);
+    request.buffer = nullptr;
+  }
+  if (request.fence) {
+    request.fence->release();
+    request.fence = nullptr;
+  }
+  if (request.callback) {
+    request.callback(request.user, request.handle, request.data, request.size);
+    free_(request);
+  }
+}
+
+void ReadbackQueue::poll() {
+  for (int i = 0; i < MAX_REQUESTS; ++i) {
+    Request& request = requests_[i];
+    if (request.handle == INVALID_HANDLE || isReady_(request)) {
+      continue;
+    }
+    if (!request.fence || request.fence->signaled()) {
+      complete_(request);
+    }
+  }
+}
+
+bool ReadbackQueue::ready(ui32 handle) const {
+  Request* request = find_(handle);
+  return request && isReady_(*request);
+}
+
+const void* ReadbackQueue::data(ui32 handle) const {
+  return ready(handle) ? find_(handle)->data : nullptr;
+}
+
+size_t ReadbackQueue::size(ui32 handle) const {
+  Request* request = find_(handle);
+  return request ? request->size : 0;
+}
+
+void ReadbackQueue::free_(Request& request) {
+  if (request.buffer) {
+    releaseBuffer_(request.buffer);
+  }
+  if (request.fence) {
+    request.fence->release();
+  }
+  if (request.data) {
+    _mem::free(request.data);
+  }
+  request = Request();
+}
+
+void ReadbackQueue::release(ui32 handle) {
+  Request* request = find_(handle);
+  if (request) {
+    free_(*request);
+  }
+}
+
+size_t ReadbackQueue::pending() const {
+  size_t count = 0;
+  for (int i = 0; i < MAX_REQUESTS; ++i) {
+    if (requests_[i].handle != INVALID_HANDLE && !isReady_(requests_[i])) {
+      count += 1;
+    }
+  }
+  return count;
+}
+
+}
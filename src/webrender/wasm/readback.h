@@ -0,0 +1,68 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Asynchronous framebuffer reads. On WebGL2 pixels are read into a pooled
+// PIXEL_PACK buffer followed by a fence; poll() copies them out with
+// Buffer::getData once the fence has signaled, so the CPU never waits on the GPU.
+// WebGL1 falls back to a synchronous read that is delivered on the next poll().
+//
+// Results go to the callback if one is given (the data is only valid during the
+// call), otherwise they stay available through the handle until release().
+class ReadbackQueue {
+public:
+  typedef void (*Callback)(void* user, ui32 handle, const void* data, size_t size);
+
+  enum {
+    MAX_REQUESTS = 32,
+    MAX_POOLED_BUFFERS = 8,
+    INVALID_HANDLE = 0,
+  };
+
+  ReadbackQueue() {}
+  ~ReadbackQueue();
+
+  ReadbackQueue(const ReadbackQueue&) = delete;
+  ReadbackQueue& operator=(const ReadbackQueue&) = delete;
+
+  // Returns INVALID_HANDLE if too many requests are outstanding
+  ui32 read(FrameBuffer* frameBuffer, GLenum attachment, int x, int y, size_t width, size_t height,
+            GLenum format, GLenum type, Callback callback = nullptr, void* user = nullptr);
+
+  // Delivers completed requests; call once per frame
+  void poll();
+
+  bool ready(ui32 handle) const;
+  // nullptr until the request is ready
+  const void* data(ui32 handle) const;
+  size_t size(ui32 handle) const;
+  void release(ui32 handle);
+
+  size_t pending() const;
+
+private:
+  struct Request {
+    ui32 handle = INVALID_HANDLE;
+    Buffer* buffer = nullptr;
+    Sync* fence = nullptr;
+    void* data = nullptr;
+    size_t size = 0;
+    Callback callback = nullptr;
+    void* user = nullptr;
+  };
+  Request requests_[MAX_REQUESTS];
+  Buffer* pool_[MAX_POOLED_BUFFERS];
+  ui32 poolSize_ = 0;
+  ui32 nextHandle_ = 1;
+
+  static bool isReady_(const Request& request);
+  Request* find_(ui32 handle) const;
+  Buffer* acquireBuffer_(size_t size);
+  void releaseBuffer_(Buffer* buffer);
+  void complete_(Request& request);
+  void free_(Request& request);
+};
+
+}
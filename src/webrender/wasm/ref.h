@@ -0,0 +1,130 @@
+#pragma once
+#include "glbindings.h"
+
+namespace WebGL
+{
+
+// Owning pointer to a reference counted object. A Ref holds one reference and
+// releases it when it goes away or is reassigned. Copies add a reference; moves hand
+// the reference over without touching the count, so passing a Ref along by move()
+// costs nothing.
+//
+// Refs are made with adopt() for a reference the caller already owns (the result of
+// create() or build()) and borrow() for an object owned elsewhere. They convert to a
+// plain pointer for calls that only use the object. A zero filled Ref is a null Ref.
+template<class T>
+class Ref {
+public:
+  Ref()
+    : object_(nullptr)
+  {
+  }
+  Ref(decltype(nullptr))
+    : object_(nullptr)
+  {
+  }
+  Ref(const Ref& other)
+    : object_(other.object_)
+  {
+    if (object_) {
+      object_->addref();
+    }
+  }
+  Ref(Ref&& other)
+    : object_(other.object_)
+  {
+    other.object_ = nullptr;
+  }
+  template<class U>
+  Ref(const Ref<U>& other)
+    : object_(other.get())
+  {
+    if (object_) {
+      object_->addref();
+    }
+  }
+  template<class U>
+  Ref(Ref<U>&& other)
+    : object_(other.detach())
+  {
+  }
+  ~Ref() {
+    if (object_) {
+      object_->release();
+    }
+  }
+
+  static Ref adopt(T* object) {
+    Ref ref;
+    ref.object_ = object;
+    return ref;
+  }
+  static Ref borrow(T* object) {
+    if (object) {
+      object->addref();
+    }
+    return adopt(object);
+  }
+
+  Ref& operator=(const Ref& other) {
+    if (other.object_) {
+      other.object_->addref();
+    }
+    replace_(other.object_);
+    return *this;
+  }
+  Ref& operator=(Ref&& other) {
+    if (this != &other) {
+      replace_(other.detach());
+    }
+    return *this;
+  }
+  template<class U>
+  Ref& operator=(Ref<U>&& other) {
+    replace_(other.detach());
+    return *this;
+  }
+  Ref& operator=(decltype(nullptr)) {
+    replace_(nullptr);
+    return *this;
+  }
+
+  T* get() const {
+    return object_;
+  }
+  T* operator->() const {
+    return object_;
+  }
+  T& operator*() const {
+    return *object_;
+  }
+  operator T*() const {
+    return object_;
+  }
+
+  // Gives up the reference without releasing it, e.g. to return an owned pointer
+  T* detach() {
+    T* object = object_;
+    object_ = nullptr;
+    return object;
+  }
+
+private:
+  T* object_;
+
+  // The old object is released last, in case it owns the new one
+  void replace_(T* object) {
+    T* old = object_;
+    object_ = object;
+    if (old) {
+      old->release();
+    }
+  }
+};
+
+template<class T>
+inline Ref<T>&& move(Ref<T>& ref) {
+  return static_cast<Ref<T>&&>(ref);
+}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include "webgl.h"
+#include "memoryTracker.h"
 
 namespace WebGL
 {
@@ -19,10 +20,12 @@ public:
     } else {
       glRenderbufferStorage(GL_RENDERBUFFER, format, width, height);
     }
+    trackMemory(MEMORY_RENDER_TARGET, buffer->memorySize(), 0);
     return buffer;
   }
   ~RenderBuffer() {
     glDeleteRenderbuffer(this);
+    trackMemory(MEMORY_RENDER_TARGET, 0, memorySize());
   }
 
   GLenum format() const {
@@ -37,6 +40,9 @@ public:
   GLsizei samples() const {
     return samples_;
   }
+  size_t memorySize() const {
+    return getImageSize(format_, width_, height_) * (samples_ > 1 ? samples_ : 1);
+  }
 
   void onBind(GLenum target) {
     glBindRenderbuffer(target, this);
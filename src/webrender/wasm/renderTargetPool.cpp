@@ -0,0 +1,223 @@
+#include "renderTargetPool.h"
+#include "texture.h"
+#include "renderBuffer.h"
+#include "frameBuffer.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+// Depth (without compare mode), 32-bit float and integer formats can't be sampled
+// with linear filtering
+static bool isFilterable(GLenum format) {
+  switch (format) {
+  case GL_DEPTH_COMPONENT16:
+  case GL_DEPTH_COMPONENT24:
+  case GL_DEPTH_COMPONENT32F:
+  case GL_DEPTH24_STENCIL8:
+  case GL_DEPTH32F_STENCIL8:
+  case GL_R32F:
+  case GL_RG32F:
+  case GL_RGB32F:
+  case GL_RGBA32F:
+  case GL_R8I:
+  case GL_R8UI:
+  case GL_R16I:
+  case GL_R16UI:
+  case GL_R32I:
+  case GL_R32UI:
+  case GL_RG8I:
+  case GL_RG8UI:
+  case GL_RG16I:
+  case GL_RG16UI:
+  case GL_RG32I:
+  case GL_RG32UI:
+  case GL_RGB8I:
+  case GL_RGB8UI:
+  case GL_RGB16I:
+  case GL_RGB16UI:
+  case GL_RGB32I:
+  case GL_RGB32UI:
+  case GL_RGBA8I:
+  case GL_RGBA8UI:
+  case GL_RGB10_A2UI:
+  case GL_RGBA16I:
+  case GL_RGBA16UI:
+  case GL_RGBA32I:
+  case GL_RGBA32UI:
+    return false;
+  default:
+    return true;
+  }
+}
+
+RenderTargetPool::RenderTargetPool(ui32 maxAge)
+  : maxAge_(maxAge)
+{
+}
+
+RenderTargetPool::~RenderTargetPool() {
+  for (size_t i = 0; i < numFrameBuffers_; ++i) {
+    frameBuffers_[i].frameBuffer->release();
+  }
+  for (size_t i = 0; i < numTargets_; ++i) {
+    targets_[i].object->release();
+  }
+  if (frameBuffers_) {
+    _mem::free(frameBuffers_);
+  }
+  if (targets_) {
+    _mem::free(targets_);
+  }
+}
+
+RenderTargetPool::Target* RenderTargetPool::acquire_(GLenum format, size_t width, size_t height, ui32 samples) {
+  for (size_t i = 0; i < numTargets_; ++i) {
+    Target& target = targets_[i];
+    if (!target.inUse && target.format == format && target.width == width && target.height == height && target.samples == samples) {
+      target.inUse = true;
+      target.lastUse = frame_;
+      stats_.reused += 1;
+      return &target;
+    }
+  }
+  if (numTargets_ == maxTargets_) {
+    maxTargets_ = (maxTargets_ ? maxTargets_ * 2 : 16);
+    targets_ = (Target*)_mem::realloc(targets_, maxTargets_ * sizeof(Target));
+  }
+  Target& target = targets_[numTargets_++];
+  target.object = nullptr;
+  target.format = format;
+  target.width = (ui32)width;
+  target.height = (ui32)height;
+  target.samples = samples;
+  target.lastUse = frame_;
+  target.inUse = true;
+  stats_.created += 1;
+  stats_.targets += 1;
+  return &target;
+}
+
+Texture* RenderTargetPool::acquireTexture(GLenum format, size_t width, size_t height) {
+  Target* target = acquire_(format, width, height, 0);
+  if (!target->object) {
+    Texture* texture = Texture::create2D(format, width, height);
+    GLenum filter = (isFilterable(format) ? GL_LINEAR : GL_NEAREST);
+    texture->setFilter(filter, filter);
+    texture->setWrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+    texture->setMemoryCategory(MEMORY_RENDER_TARGET);
+    target->object = texture;
+  }
+  return (Texture*)target->object;
+}
+
+RenderBuffer* RenderTargetPool::acquireRenderBuffer(GLenum format, size_t width, size_t height, size_t samples) {
+  Target* target = acquire_(format, width, height, samples ? (ui32)samples : 1);
+  if (!target->object) {
+    target->object = RenderBuffer::create(format, width, height, samples);
+  }
+  return (RenderBuffer*)target->object;
+}
+
+RenderTargetPool::Target* RenderTargetPool::find_(GLBase* object) {
+  for (size_t i = 0; i < numTargets_; ++i) {
+    if (targets_[i].object == object) {
+      return &targets_[i];
+    }
+  }
+  return nullptr;
+}
+
+void RenderTargetPool::recycle(GLBase* object) {
+  Target* target = find_(object);
+  assert(target && target->inUse);
+  target->inUse = false;
+}
+
+FrameBuffer* RenderTargetPool::frameBuffer(const GLenum* attachments, GLBase* const* targets, size_t count) {
+  assert(count <= MAX_ATTACHMENTS);
+  for (size_t i = 0; i < numFrameBuffers_; ++i) {
+    FrameBufferEntry& entry = frameBuffers_[i];
+    if (entry.count != count) {
+      continue;
+    }
+    size_t j = 0;
+    while (j < count && entry.attachments[j] == attachments[j] && entry.targets[j] == targets[j]) {
+      ++j;
+    }
+    if (j == count) {
+      entry.lastUse = frame_;
+      return entry.frameBuffer;
+    }
+  }
+
+  if (numFrameBuffers_ == maxFrameBuffers_) {
+    maxFrameBuffers_ = (maxFrameBuffers_ ? maxFrameBuffers_ * 2 : 16);
+    frameBuffers_ = (FrameBufferEntry*)_mem::realloc(frameBuffers_, maxFrameBuffers_ * sizeof(FrameBufferEntry));
+  }
+  FrameBufferEntry& entry = frameBuffers_[numFrameBuffers_++];
+  entry.frameBuffer = FrameBuffer::create(0, 0, 0);
+  entry.count = (ui32)count;
+  entry.lastUse = frame_;
+  for (size_t i = 0; i < count; ++i) {
+    Target* target = find_(targets[i]);
+    assert(target);
+    entry.attachments[i] = attachments[i];
+    entry.targets[i] = targets[i];
+    if (target->samples) {
+      entry.frameBuffer->renderBuffer(attachments[i], (RenderBuffer*)targets[i]);
+    } else {
+      entry.frameBuffer->texture2D(attachments[i], (Texture*)targets[i]);
+    }
+  }
+  stats_.frameBuffers += 1;
+  return entry.frameBuffer;
+}
+
+// Frame buffers hold references to their attachments, so they go first
+void RenderTargetPool::deleteFrameBuffers_(GLBase* target) {
+  for (size_t i = 0; i < numFrameBuffers_;) {
+    FrameBufferEntry& entry = frameBuffers_[i];
+    bool attached = false;
+    for (ui32 j = 0; j < entry.count; ++j) {
+      attached = attached || (entry.targets[j] == target);
+    }
+    if (attached) {
+      entry.frameBuffer->release();
+      entry = frameBuffers_[--numFrameBuffers_];
+      stats_.frameBuffers -= 1;
+    } else {
+      ++i;
+    }
+  }
+}
+
+void RenderTargetPool::endFrame() {
+  for (size_t i = 0; i < numTargets_;) {
+    Target& target = targets_[i];
+    target.inUse = false;
+    if (frame_ - target.lastUse >= maxAge_) {
+      deleteFrameBuffers_(target.object);
+      target.object->release();
+      target = targets_[--numTargets_];
+      stats_.targets -= 1;
+      stats_.deleted += 1;
+    } else {
+      ++i;
+    }
+  }
+  // Frame buffers of live targets age on their own, e.g. after a pass is disabled
+  for (size_t i = 0; i < numFrameBuffers_;) {
+    FrameBufferEntry& entry = frameBuffers_[i];
+    if (frame_ - entry.lastUse >= maxAge_) {
+      entry.frameBuffer->release();
+      entry = frameBuffers_[--numFrameBuffers_];
+      stats_.frameBuffers -= 1;
+    } else {
+      ++i;
+    }
+  }
+  frame_ += 1;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Transient render targets handed out by (format, width, height, samples). Targets
+// acquired during a frame belong to the caller until endFrame() or recycle(), then
+// go back to the pool; targets not acquired for maxAge frames are deleted. Frame
+// buffers are cached by their attachment set, so passes that render to the same
+// targets share one frame buffer and never re-attach.
+//
+// The pool owns everything it returns; callers must not release the objects.
+class RenderTargetPool {
+public:
+  enum {
+    MAX_ATTACHMENTS = 6,
+  };
+
+  struct Stats {
+    ui32 targets = 0;
+    ui32 frameBuffers = 0;
+    // Totals over the pool's lifetime
+    ui32 created = 0;
+    ui32 reused = 0;
+    ui32 deleted = 0;
+  };
+
+  RenderTargetPool(ui32 maxAge = 3);
+  ~RenderTargetPool();
+
+  RenderTargetPool(const RenderTargetPool&) = delete;
+  RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+  // Single sampled texture with clamped edges, for targets that are read by later
+  // passes. Filtering is linear where the format allows it and nearest otherwise.
+  Texture* acquireTexture(GLenum format, size_t width, size_t height);
+  // Render buffer for targets that are only rendered to, resolved or blitted
+  RenderBuffer* acquireRenderBuffer(GLenum format, size_t width, size_t height, size_t samples = 1);
+  // Returns a target before the end of the frame, so a later pass can reuse its memory
+  void recycle(GLBase* target);
+
+  // Frame buffer with exactly these attachments; targets must come from this pool
+  FrameBuffer* frameBuffer(const GLenum* attachments, GLBase* const* targets, size_t count);
+
+  // Returns all targets to the pool and deletes the ones that have aged out
+  void endFrame();
+
+  const Stats& stats() const {
+    return stats_;
+  }
+
+private:
+  struct Target {
+    GLBase* object;
+    GLenum format;
+    ui32 width;
+    ui32 height;
+    // 0 for textures
+    ui32 samples;
+    ui32 lastUse;
+    bool inUse;
+  };
+  struct FrameBufferEntry {
+    FrameBuffer* frameBuffer;
+    ui32 count;
+    GLenum attachments[MAX_ATTACHMENTS];
+    GLBase* targets[MAX_ATTACHMENTS];
+    ui32 lastUse;
+  };
+
+  ui32 maxAge_;
+  ui32 frame_ = 0;
+  Target* targets_ = nullptr;
+  size_t numTargets_ = 0;
+  size_t maxTargets_ = 0;
+  FrameBufferEntry* frameBuffers_ = nullptr;
+  size_t numFrameBuffers_ = 0;
+  size_t maxFrameBuffers_ = 0;
+  Stats stats_;
+
+  Target* acquire_(GLenum format, size_t width, size_t height, ui32 samples);
+  Target* find_(GLBase* object);
+  void deleteFrameBuffers_(GLBase* target);
+};
+
+}
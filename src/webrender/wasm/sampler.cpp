@@ -0,0 +1,90 @@
+#include "sampler.h"
+#include "hash.h"
+
+namespace WebGL
+{
+
+enum {
+  TABLE_SIZE = 64,
+};
+static Sampler* table_[TABLE_SIZE];
+
+static const size_t DescWords = sizeof(SamplerDesc) / sizeof(ui32);
+
+bool SamplerDesc::operator==(const SamplerDesc& other) const {
+  const ui32* lhs = (const ui32*)this;
+  const ui32* rhs = (const ui32*)&other;
+  for (size_t i = 0; i < DescWords; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+ui32 SamplerDesc::hash() const {
+  return hashWords((const ui32*)this, DescWords);
+}
+
+Sampler* Sampler::create(const SamplerDesc& desc) {
+  ui32 hash = desc.hash();
+  Sampler** bucket = &table_[hash & (TABLE_SIZE - 1)];
+  for (Sampler* sampler = *bucket; sampler; sampler = sampler->next_) {
+    if (sampler->hash_ == hash && sampler->desc_ == desc) {
+      sampler->addref();
+      return sampler;
+    }
+  }
+
+  Sampler* sampler = new Sampler;
+  sampler->desc_ = desc;
+  sampler->hash_ = hash;
+  sampler->next_ = *bucket;
+  *bucket = sampler;
+
+  // New sampler objects start with the GL defaults
+  const SamplerDesc defaults;
+  glCreateSampler(sampler);
+  if (desc.magFilter != defaults.magFilter) {
+    glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, desc.magFilter);
+  }
+  if (desc.minFilter != defaults.minFilter) {
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, desc.minFilter);
+  }
+  if (desc.wrapS != defaults.wrapS) {
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, desc.wrapS);
+  }
+  if (desc.wrapT != defaults.wrapT) {
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, desc.wrapT);
+  }
+  if (desc.wrapR != defaults.wrapR) {
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_R, desc.wrapR);
+  }
+  if (desc.compareFunc != defaults.compareFunc) {
+    glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_FUNC, desc.compareFunc);
+  }
+  if (desc.compareMode != defaults.compareMode) {
+    glSamplerParameteri(sampler, GL_TEXTURE_COMPARE_MODE, desc.compareMode);
+  }
+  if (desc.minLod != defaults.minLod) {
+    glSamplerParameterf(sampler, GL_TEXTURE_MIN_LOD, desc.minLod);
+  }
+  if (desc.maxLod != defaults.maxLod) {
+    glSamplerParameterf(sampler, GL_TEXTURE_MAX_LOD, desc.maxLod);
+  }
+  if (desc.maxAnisotropy != defaults.maxAnisotropy) {
+    glSamplerParameterf(sampler, GL_TEXTURE_MAX_ANISOTROPY, desc.maxAnisotropy);
+  }
+  return sampler;
+}
+
+Sampler::~Sampler() {
+  Sampler** link = &table_[hash_ & (TABLE_SIZE - 1)];
+  while (*link != this) {
+    link = &(*link)->next_;
+  }
+  *link = next_;
+  glDeleteSampler(this);
+}
+
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Sampling parameters, stored as 32-bit words so they can be hashed as raw memory.
+// Defaults match the GL defaults.
+struct SamplerDesc {
+  ui32 magFilter = GL_LINEAR;
+  ui32 minFilter = GL_NEAREST_MIPMAP_LINEAR;
+  ui32 wrapS = GL_REPEAT;
+  ui32 wrapT = GL_REPEAT;
+  ui32 wrapR = GL_REPEAT;
+  ui32 compareFunc = GL_LEQUAL;
+  ui32 compareMode = GL_NONE;
+  float minLod = -1000.0f;
+  float maxLod = 1000.0f;
+  float maxAnisotropy = 1.0f;
+
+  bool operator==(const SamplerDesc& other) const;
+  bool operator!=(const SamplerDesc& other) const {
+    return !(*this == other);
+  }
+  ui32 hash() const;
+};
+
+// Interned sampler object (WebGL2): equal parameter sets share one GL sampler.
+class Sampler : public Object<Sampler> {
+public:
+  static Sampler* create(const SamplerDesc& desc);
+  ~Sampler();
+
+  const SamplerDesc& desc() const {
+    return desc_;
+  }
+
+private:
+  Sampler() {}
+  SamplerDesc desc_;
+  ui32 hash_;
+  Sampler* next_;
+};
+
+}
@@ -0,0 +1,82 @@
+#include "shader.h"
+#include "hash.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+enum {
+  TABLE_SIZE = 256,
+};
+static Shader* table_[TABLE_SIZE];
+
+Shader* Shader::get(GLenum type, const char* source, const char* defines) {
+  if (!defines) {
+    defines = "";
+  }
+  ui32 hash = hashString(source, hashString(defines, type));
+  Shader** bucket = &table_[hash & (TABLE_SIZE - 1)];
+  for (Shader* shader = *bucket; shader; shader = shader->next_) {
+    if (shader->hash_ == hash && shader->type_ == type && stringEqual(shader->key_, defines)) {
+      const char* key = shader->key_ + stringLength(defines) + 1;
+      if (stringEqual(key, source)) {
+        shader->addref();
+        return shader;
+      }
+    }
+  }
+
+  size_t definesLength = stringLength(defines);
+  size_t sourceLength = stringLength(source);
+  Shader* shader = create(type);
+  shader->hash_ = hash;
+  shader->key_ = (char*)_mem::malloc(definesLength + sourceLength + 2);
+  memcpy(shader->key_, defines, definesLength + 1);
+  memcpy(shader->key_ + definesLength + 1, source, sourceLength + 1);
+  shader->next_ = *bucket;
+  *bucket = shader;
+
+  if (!definesLength) {
+    shader->compile(source);
+    return shader;
+  }
+  // #version has to stay on the first line
+  size_t versionLength = 0;
+  if (source[0] == '#' && source[1] == 'v') {
+    while (source[versionLength] && source[versionLength] != '\n') {
+      ++versionLength;
+    }
+    if (source[versionLength]) {
+      ++versionLength;
+    }
+  }
+  size_t scratchSize = sourceLength + definesLength + 2;
+  // Not sbrk scratch: compile may allocate, e.g. for frame capture
+  char* text = (char*)_mem::malloc(scratchSize);
+  char* out = text;
+  memcpy(out, source, versionLength);
+  out += versionLength;
+  memcpy(out, defines, definesLength);
+  out += definesLength;
+  if (defines[definesLength - 1] != '\n') {
+    *out++ = '\n';
+  }
+  memcpy(out, source + versionLength, sourceLength - versionLength + 1);
+  shader->compile(text);
+  _mem::free(text);
+  return shader;
+}
+
+Shader::~Shader() {
+  glDeleteShader(this);
+  if (key_) {
+    Shader** link = &table_[hash_ & (TABLE_SIZE - 1)];
+    while (*link != this) {
+      link = &(*link)->next_;
+    }
+    *link = next_;
+    _mem::free(key_);
+  }
+}
+
+}
@@ -12,18 +12,33 @@ public:
     shader->type_ = type;
     return shader;
   }
-  ~Shader() {
-    glDeleteShader(this);
-  }
+  // Compiled shader shared by everything built from the same type, source and
+  // defines. defines is inserted after the #version line, if there is one.
+  // Compile status is not checked here, so with KHR_parallel_shader_compile the
+  // call returns without waiting for the compiler.
+  static Shader* get(GLenum type, const char* source, const char* defines = nullptr);
+  ~Shader();
 
   void compile(char const* source) {
     glShaderSource(this, source);
     glCompileShader(this);
   }
 
+  GLenum type() const {
+    return type_;
+  }
+  // Hash of type, source and defines for shaders from get(), 0 otherwise
+  ui32 hash() const {
+    return hash_;
+  }
+
 private:
   Shader() {}
   GLenum type_;
+  ui32 hash_ = 0;
+  // defines and source, each null-terminated
+  char* key_ = nullptr;
+  Shader* next_ = nullptr;
 };
 
 }
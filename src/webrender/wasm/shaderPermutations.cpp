@@ -0,0 +1,133 @@
+#include "shaderPermutations.h"
+#include "program.h"
+#include "hash.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+ShaderPermutations::ShaderPermutations(const char* vertex, const char* fragment, const char* const* features, size_t numFeatures)
+  : vertex_(vertex)
+  , fragment_(fragment)
+  , numFeatures_((ui32)numFeatures)
+{
+  assert(numFeatures <= MAX_FEATURES);
+  for (ui32 i = 0; i < numFeatures_; ++i) {
+    features_[i] = features[i];
+  }
+  for (ui32 i = 0; i < NUM_BUCKETS; ++i) {
+    buckets_[i] = INVALID_INDEX;
+  }
+}
+
+ShaderPermutations::~ShaderPermutations() {
+  for (size_t i = 0; i < size_; ++i) {
+    permutations_[i].program->release();
+  }
+  if (permutations_) {
+    _mem::free(permutations_);
+  }
+  if (queue_) {
+    _mem::free(queue_);
+  }
+}
+
+ui32 ShaderPermutations::featureBit(const char* name) const {
+  for (ui32 i = 0; i < numFeatures_; ++i) {
+    if (stringEqual(features_[i], name)) {
+      return 1U << i;
+    }
+  }
+  return 0;
+}
+
+ui32 ShaderPermutations::find_(ui32 mask) const {
+  ui32 index = buckets_[hashWords(&mask, 1) & (NUM_BUCKETS - 1)];
+  while (index != INVALID_INDEX && permutations_[index].mask != mask) {
+    index = permutations_[index].next;
+  }
+  return index;
+}
+
+ui32 ShaderPermutations::build_(ui32 mask) {
+  size_t definesSize = 1;
+  for (ui32 i = 0; i < numFeatures_; ++i) {
+    if (mask & (1U << i)) {
+      definesSize += stringLength(features_[i]) + 9;
+    }
+  }
+  // Program::build allocates while the defines are in use, so they can't live in sbrk scratch
+  char* defines = (char*)_mem::malloc(definesSize);
+  char* out = defines;
+  for (ui32 i = 0; i < numFeatures_; ++i) {
+    if (mask & (1U << i)) {
+      size_t length = stringLength(features_[i]);
+      memcpy(out, "#define ", 8);
+      memcpy(out + 8, features_[i], length);
+      out[length + 8] = '\n';
+      out += length + 9;
+    }
+  }
+  *out = 0;
+  Program* program = Program::build(vertex_, fragment_, defines);
+  _mem::free(defines);
+
+  if (size_ == capacity_) {
+    capacity_ = (capacity_ ? capacity_ * 2 : 16);
+    permutations_ = (Permutation*)_mem::realloc(permutations_, capacity_ * sizeof(Permutation));
+  }
+  ui32 index = (ui32)size_++;
+  ui32* bucket = &buckets_[hashWords(&mask, 1) & (NUM_BUCKETS - 1)];
+  Permutation& permutation = permutations_[index];
+  permutation.mask = mask;
+  permutation.program = program;
+  permutation.uses = 0;
+  permutation.warmUp = false;
+  permutation.next = *bucket;
+  *bucket = index;
+  return index;
+}
+
+Program* ShaderPermutations::get(ui32 mask) {
+  ui32 index = find_(mask);
+  if (index == INVALID_INDEX) {
+    index = build_(mask);
+  }
+  Permutation& permutation = permutations_[index];
+  ++permutation.uses;
+  return permutation.program;
+}
+
+void ShaderPermutations::warmUp(const ui32* masks, size_t count) {
+  if (queueSize_ + count > queueCapacity_) {
+    queueCapacity_ = queueSize_ + count;
+    queue_ = (ui32*)_mem::realloc(queue_, queueCapacity_ * sizeof(ui32));
+  }
+  memcpy(queue_ + queueSize_, masks, count * sizeof(ui32));
+  queueSize_ += count;
+}
+
+size_t ShaderPermutations::update(size_t budget) {
+  while (queueHead_ < queueSize_ && budget) {
+    ui32 mask = queue_[queueHead_++];
+    ui32 index = find_(mask);
+    if (index == INVALID_INDEX) {
+      index = build_(mask);
+      --budget;
+    }
+    permutations_[index].warmUp = true;
+  }
+  if (queueHead_ == queueSize_) {
+    queueHead_ = queueSize_ = 0;
+  }
+  size_t pending = queueSize_ - queueHead_;
+  for (size_t i = 0; i < size_; ++i) {
+    Permutation& permutation = permutations_[i];
+    if (permutation.warmUp && !permutation.program->ready() && !permutation.program->failed()) {
+      ++pending;
+    }
+  }
+  return pending;
+}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Variants of one vertex/fragment shader pair selected by up to 32 feature bits.
+// Feature i is declared as a define body ("SKINNED", "NUM_LIGHTS 4") and bit i of
+// a mask adds "#define <feature>" to the preamble the variant is built with.
+// Programs come from Program::build, so they compile and link in the background
+// and have to be checked with ready() before use.
+//
+// warmUp() declares masks that are likely to be needed; update() builds a few of
+// them each frame so a burst of new materials doesn't stall a single frame.
+// Every mask is counted on get(), so the warm-up list can be compared with what
+// was actually drawn.
+class ShaderPermutations {
+public:
+  enum {
+    MAX_FEATURES = 32,
+    NUM_BUCKETS = 64,
+    INVALID_INDEX = 0xFFFFFFFFU,
+  };
+
+  struct Permutation {
+    ui32 mask;
+    Program* program;
+    // get() calls for this mask
+    ui32 uses;
+    // Listed in warmUp()
+    bool warmUp;
+    ui32 next;
+  };
+
+  // Sources and feature strings are stored by pointer and must stay valid
+  ShaderPermutations(const char* vertex, const char* fragment, const char* const* features, size_t numFeatures);
+  ~ShaderPermutations();
+
+  ShaderPermutations(const ShaderPermutations&) = delete;
+  ShaderPermutations& operator=(const ShaderPermutations&) = delete;
+
+  size_t numFeatures() const {
+    return numFeatures_;
+  }
+  const char* feature(ui32 index) const {
+    return features_[index];
+  }
+  // Bit for a declared feature, 0 if there is none by that name
+  ui32 featureBit(const char* name) const;
+
+  // Starts building the variant if this is the first request for mask
+  Program* get(ui32 mask);
+
+  void warmUp(const ui32* masks, size_t count);
+  // Builds up to budget queued warm-up variants; returns the number of warm-up
+  // variants that are queued or not linked yet
+  size_t update(size_t budget = 4);
+
+  // Every variant built so far, in creation order
+  size_t numPermutations() const {
+    return size_;
+  }
+  const Permutation& permutation(size_t index) const {
+    return permutations_[index];
+  }
+
+private:
+  const char* vertex_;
+  const char* fragment_;
+  const char* features_[MAX_FEATURES];
+  ui32 numFeatures_;
+
+  ui32 buckets_[NUM_BUCKETS];
+  Permutation* permutations_ = nullptr;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+
+  ui32* queue_ = nullptr;
+  size_t queueSize_ = 0;
+  size_t queueCapacity_ = 0;
+  size_t queueHead_ = 0;
+
+  ui32 find_(ui32 mask) const;
+  ui32 build_(ui32 mask);
+};
+
+}
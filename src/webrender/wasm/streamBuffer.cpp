@@ -0,0 +1,94 @@
+#include "streamBuffer.h"
+#include "buffer.h"
+#include "sync.h"
+
+namespace WebGL
+{
+
+StreamBuffer* StreamBuffer::create(size_t regionSize, GLenum target, size_t regions) {
+  assert(regions >= 1 && regions <= MAX_REGIONS);
+  StreamBuffer* stream = new StreamBuffer;
+  stream->regionSize_ = regionSize;
+  stream->numRegions_ = regions;
+  stream->frame_ = WebGL::frameIndex();
+  for (ui32 i = 0; i < MAX_REGIONS; ++i) {
+    stream->fences_[i] = nullptr;
+  }
+  stream->buffer_ = Buffer::create(regionSize * regions, nullptr, GL_STREAM_DRAW, target);
+  return stream;
+}
+
+StreamBuffer::~StreamBuffer() {
+  releaseFences_();
+  buffer_->release();
+}
+
+void StreamBuffer::releaseFences_() {
+  for (ui32 i = 0; i < MAX_REGIONS; ++i) {
+    if (fences_[i]) {
+      fences_[i]->release();
+      fences_[i] = nullptr;
+    }
+  }
+}
+
+size_t StreamBuffer::regionStart_() const {
+  return region_ * regionSize_;
+}
+size_t StreamBuffer::regionEnd_() const {
+  // Without fences the whole buffer is one region, orphaned every frame
+  if (!WebGL::getFeature(FEATURE_FENCE_SYNC)) {
+    return regionSize_ * numRegions_;
+  }
+  return regionStart_() + regionSize_;
+}
+
+void StreamBuffer::beginFrame_() {
+  frame_ = WebGL::frameIndex();
+  if (offset_ == regionStart_()) {
+    // Nothing was written last frame, keep the region
+    return;
+  }
+
+  if (!WebGL::getFeature(FEATURE_FENCE_SYNC)) {
+    buffer_->orphan();
+    offset_ = 0;
+    return;
+  }
+
+  // The last frame's draws have all been issued by now; fence them
+  if (fences_[region_]) {
+    fences_[region_]->release();
+  }
+  fences_[region_] = Sync::create();
+
+  region_ = (region_ + 1) % numRegions_;
+  offset_ = regionStart_();
+  Sync* fence = fences_[region_];
+  if (fence) {
+    if (fence->signaled() || fence->wait()) {
+      fence->release();
+      fences_[region_] = nullptr;
+    } else {
+      // The GPU is more than numRegions_ - 1 frames behind
+      buffer_->orphan();
+      releaseFences_();
+      orphans_ += 1;
+    }
+  }
+}
+
+size_t StreamBuffer::write(const void* data, size_t size, size_t alignment) {
+  if (frame_ != WebGL::frameIndex()) {
+    beginFrame_();
+  }
+  size_t offset = (offset_ + alignment - 1) / alignment * alignment;
+  if (offset + size > regionEnd_()) {
+    return INVALID_OFFSET;
+  }
+  buffer_->setData(offset, size, data);
+  offset_ = offset + size;
+  return offset;
+}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Vertex/index data rewritten every frame. The buffer is split into per-frame regions
+// used round robin; each region is fenced once its frame has been submitted and only
+// rewritten after the fence signals. If the GPU is still behind, or on WebGL1 where
+// there are no fences, the storage is orphaned instead of waiting.
+class StreamBuffer : public Object<StreamBuffer> {
+public:
+  enum {
+    MAX_REGIONS = 4,
+    INVALID_OFFSET = 0xFFFFFFFFU,
+  };
+
+  static StreamBuffer* create(size_t regionSize, GLenum target = GL_ARRAY_BUFFER, size_t regions = 3);
+  ~StreamBuffer();
+
+  Buffer* buffer() const {
+    return buffer_;
+  }
+  size_t regionSize() const {
+    return regionSize_;
+  }
+
+  // Uploads data into the current frame's region and returns its offset in buffer(),
+  // or INVALID_OFFSET if the region is full
+  size_t write(const void* data, size_t size, size_t alignment = 4);
+
+  // Number of times storage was orphaned because a region was still in use
+  ui32 orphans() const {
+    return orphans_;
+  }
+
+private:
+  StreamBuffer() {}
+  Buffer* buffer_;
+  size_t regionSize_;
+  ui32 numRegions_;
+  ui32 region_ = 0;
+  size_t offset_ = 0;
+  ui32 frame_;
+  ui32 orphans_ = 0;
+  Sync* fences_[MAX_REGIONS];
+
+  size_t regionStart_() const;
+  size_t regionEnd_() const;
+  void beginFrame_();
+  void releaseFences_();
+};
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "webgl.h"
+
+namespace WebGL
+{
+
+// Fence inserted into the command stream (WebGL2). Status only changes between
+// browser tasks, so fences are polled on later frames rather than waited on.
+class Sync : public Object<Sync> {
+public:
+  static Sync* create() {
+    Sync* sync = new Sync;
+    glFenceSync(sync, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    return sync;
+  }
+  ~Sync() {
+    glDeleteSync(this);
+  }
+
+  bool signaled() {
+    if (!signaled_) {
+      signaled_ = (glGetSynci(this, GL_SYNC_STATUS) == GL_SIGNALED);
+    }
+    return signaled_;
+  }
+
+  // Waits up to timeout nanoseconds; WebGL limits this to MAX_CLIENT_WAIT_TIMEOUT_WEBGL,
+  // which is usually 0
+  bool wait(GLuint timeout = 0) {
+    if (!signaled_) {
+      GLenum result = glClientWaitSync(this, GL_SYNC_FLUSH_COMMANDS_BIT, timeout);
+      signaled_ = (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED);
+    }
+    return signaled_;
+  }
+
+private:
+  Sync() {}
+  bool signaled_ = false;
+};
+
+}
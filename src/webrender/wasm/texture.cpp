@@ -1,4 +1,8 @@
 #include "texture.h"
+#include "sampler.h"
+#include "memoryTracker.h"
+#include "frameStats.h"
+#include "malloc.h"
 
 static inline size_t max(size_t a, size_t b) {
   return a > b ? a : b;
@@ -13,128 +17,9 @@ static size_t getLevels(size_t width) {
   return levels;
 }
 
-static size_t getCompressedSize(GLenum internalFormat, size_t width, size_t height) {
-  switch (internalFormat) {
-  case GL_COMPRESSED_RGB_S3TC_DXT1:
-  case GL_COMPRESSED_RGBA_S3TC_DXT1:
-  case GL_COMPRESSED_SRGB_S3TC_DXT1:
-  case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1:
-  case GL_COMPRESSED_R11_EAC:
-  case GL_COMPRESSED_SIGNED_R11_EAC:
-  case GL_COMPRESSED_RGB8_ETC2:
-  case GL_COMPRESSED_SRGB8_ETC2:
-  case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
-  case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
-  case GL_COMPRESSED_RGB_ETC1:
-  case GL_COMPRESSED_RGB_ATC:
-    return ((width + 3) / 4) * ((height + 3) / 4) * 8;
-  case GL_COMPRESSED_RGBA_S3TC_DXT3:
-  case GL_COMPRESSED_RGBA_S3TC_DXT5:
-  case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT3:
-  case GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5:
-  case GL_COMPRESSED_RG11_EAC:
-  case GL_COMPRESSED_SIGNED_RG11_EAC:
-  case GL_COMPRESSED_RGBA8_ETC2_EAC:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
-  case GL_COMPRESSED_RGBA_ATC_EXPLICIT_ALPHA:
-  case GL_COMPRESSED_RGBA_ATC_INTERPOLATED_ALPHA:
-    return ((width + 3) / 4) * ((height + 3) / 4) * 16;
-  case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
-  case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
-    return max(width, 8) * max(height, 8) / 2;
-  case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
-  case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
-    return max(width, 16) * max(height, 8) / 4;
-  case GL_COMPRESSED_RGBA_ASTC_4x4:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4:
-    return ((width + 3) / 4) * ((height + 3) / 4) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_5x4:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x4:
-    return ((width + 4) / 5) * ((height + 3) / 4) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_5x5:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_5x5:
-    return ((width + 4) / 5) * ((height + 4) / 5) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_6x5:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x5:
-    return ((width + 5) / 6) * ((height + 4) / 5) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_6x6:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_6x6:
-    return ((width + 5) / 6) * ((height + 5) / 6) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_8x5:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x5:
-    return ((width + 7) / 8) * ((height + 4) / 5) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_8x6:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x6:
-    return ((width + 7) / 8) * ((height + 5) / 6) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_8x8:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_8x8:
-    return ((width + 7) / 8) * ((height + 7) / 8) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_10x5:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x5:
-    return ((width + 9) / 10) * ((height + 4) / 5) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_10x6:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x6:
-    return ((width + 9) / 10) * ((height + 5) / 6) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_10x8:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x8:
-    return ((width + 9) / 10) * ((height + 7) / 8) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_10x10:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10:
-    return ((width + 9) / 10) * ((height + 9) / 10) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_12x10:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10:
-    return ((width + 11) / 12) * ((height + 9) / 10) * 16;
-  case GL_COMPRESSED_RGBA_ASTC_12x12:
-  case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12:
-    return ((width + 11) / 12) * ((height + 11) / 12) * 16;
-
-  default:
-    return 0;
-  }
-}
-
 namespace WebGL
 {
 
-Texture* Texture::create2D(GLenum format, size_t width, size_t height, size_t levels) {
-  Texture* texture = new Texture;
-  glCreateTexture(texture);
-  glBindTexture(GL_TEXTURE_2D, texture);
-  if (levels == 0) {
-    levels = getLevels(max(width, height));
-  }
-  texture->target_ = GL_TEXTURE_2D;
-  texture->format_ = format;
-  texture->width_ = width;
-  texture->height_ = height;
-  texture->depth_ = 0;
-  texture->levels_ = levels;
-
-  if (WebGL::version() >= 2) {
-    glTexStorage2D(GL_TEXTURE_2D, levels, format, width, height);
-  } else {
-    size_t compressed = getCompressedSize(format, width, height);
-    if (compressed == 0) {
-      for (size_t i = 0; i < levels; ++i) {
-        glTexImage2D(GL_TEXTURE_2D, i, format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
-        width = max(width >> 1, 1);
-        height = max(height >> 1, 1);
-      }
-    } else {
-      void* ptr = sbrk(compressed);
-      for (size_t i = 0; i < levels; ++i) {
-        glCompressedTexImage2D(GL_TEXTURE_2D, i, format, width, height, 0, compressed, ptr);
-        width = max(width >> 1, 1);
-        height = max(height >> 1, 1);
-        compressed = getCompressedSize(format, width, height);
-      }
-      sbrk(-compressed);
-    }
-  }
-
-  return texture;
-}
-
 static GLenum CubeFaces[6] = {
   GL_TEXTURE_CUBE_MAP_POSITIVE_X,
   GL_TEXTURE_CUBE_MAP_NEGATIVE_X,
@@ -144,85 +29,242 @@ static GLenum CubeFaces[6] = {
   GL_TEXTURE_CUBE_MAP_NEGATIVE_Z
 };
 
-Texture* Texture::createCube(GLenum format, size_t width, size_t height, size_t levels) {
+Texture* Texture::lruHead_ = nullptr;
+Texture* Texture::lruTail_ = nullptr;
+
+Texture* Texture::create_(GLenum target, GLenum format, size_t width, size_t height, size_t depth, size_t levels) {
   Texture* texture = new Texture;
-  glCreateTexture(texture);
-  glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
-  if (levels == 0) {
-    levels = getLevels(max(width, height));
-  }
-  texture->target_ = GL_TEXTURE_CUBE_MAP;
+  texture->target_ = target;
   texture->format_ = format;
   texture->width_ = width;
   texture->height_ = height;
-  texture->depth_ = 0;
+  texture->depth_ = depth;
   texture->levels_ = levels;
+  texture->allocate_();
+  return texture;
+}
 
-  if (WebGL::version() >= 2) {
-    glTexStorage2D(GL_TEXTURE_CUBE_MAP, levels, format, width, height);
-  } else {
-    size_t compressed = getCompressedSize(format, width, height);
-    if (compressed == 0) {
-      for (size_t i = 0; i < levels; ++i) {
-        for (int j = 0; j < 6; ++j) {
-          glTexImage2D(CubeFaces[j], i, format, width, height, 0, format, GL_UNSIGNED_BYTE, nullptr);
-        }
-        width = max(width >> 1, 1);
-        height = max(height >> 1, 1);
-      }
-    } else {
-      void* ptr = sbrk(compressed);
-      for (size_t i = 0; i < levels; ++i) {
-        for (int j = 0; j < 6; ++j) {
-          glCompressedTexImage2D(CubeFaces[j], i, format, width, height, 0, compressed, ptr);
-        }
-        width = max(width >> 1, 1);
-        height = max(height >> 1, 1);
-        compressed = getCompressedSize(format, width, height);
-      }
-      sbrk(-compressed);
-    }
+Texture* Texture::create2D(GLenum format, size_t width, size_t height, size_t levels) {
+  if (levels == 0) {
+    levels = getLevels(max(width, height));
   }
+  return create_(GL_TEXTURE_2D, format, width, height, 0, levels);
+}
 
-  return texture;
+Texture* Texture::createCube(GLenum format, size_t width, size_t height, size_t levels) {
+  if (levels == 0) {
+    levels = getLevels(max(width, height));
+  }
+  return create_(GL_TEXTURE_CUBE_MAP, format, width, height, 0, levels);
 }
 
 Texture* Texture::create3D(GLenum format, size_t width, size_t height, size_t depth, size_t levels) {
-  Texture* texture = new Texture;
-  glCreateTexture(texture);
-  glBindTexture(GL_TEXTURE_3D, texture);
   if (levels == 0) {
     levels = getLevels(max(width, max(height, depth)));
   }
-  texture->target_ = GL_TEXTURE_3D;
-  texture->format_ = format;
-  texture->width_ = width;
-  texture->height_ = height;
-  texture->depth_ = depth;
-  texture->levels_ = levels;
-
-  glTexStorage3D(GL_TEXTURE_3D, levels, format, width, height, depth);
-
-  return texture;
+  return create_(GL_TEXTURE_3D, format, width, height, depth, levels);
 }
 
 Texture* Texture::create2DArray(GLenum format, size_t width, size_t height, size_t layers, size_t levels) {
-  Texture* texture = new Texture;
-  glCreateTexture(texture);
-  glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
   if (levels == 0) {
     levels = getLevels(max(width, height));
   }
-  texture->target_ = GL_TEXTURE_2D_ARRAY;
-  texture->format_ = format;
-  texture->width_ = width;
-  texture->height_ = height;
-  texture->depth_ = layers;
-  texture->levels_ = levels;
+  return create_(GL_TEXTURE_2D_ARRAY, format, width, height, layers, levels);
+}
 
-  glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, format, width, height, layers);
+// Creates the GL texture and its storage. WebGL1 has no immutable storage, so each
+// level of each face is specified with empty data.
+void Texture::allocate_() {
+  glCreateTexture(this);
+  WebGL::bindTexture(target_, this);
+  if (target_ == GL_TEXTURE_3D || target_ == GL_TEXTURE_2D_ARRAY) {
+    glTexStorage3D(target_, levels_, format_, width_, height_, depth_);
+  } else if (WebGL::version() >= 2) {
+    glTexStorage2D(target_, levels_, format_, width_, height_);
+  } else {
+    const GLenum* faces = (target_ == GL_TEXTURE_CUBE_MAP ? CubeFaces : &target_);
+    int numFaces = (target_ == GL_TEXTURE_CUBE_MAP ? 6 : 1);
+    size_t width = width_;
+    size_t height = height_;
+    size_t scratchSize = getCompressedSize(format_, width, height);
+    // Placeholder data for the compressed levels; not sbrk scratch, since GL calls may allocate
+    void* ptr = (scratchSize ? _mem::malloc(scratchSize) : nullptr);
+    for (size_t i = 0; i < levels_; ++i) {
+      size_t compressed = getCompressedSize(format_, width, height);
+      for (int j = 0; j < numFaces; ++j) {
+        if (compressed) {
+          glCompressedTexImage2D(faces[j], i, format_, width, height, 0, compressed, ptr);
+          FRAME_STAT(textureBytes, compressed);
+        } else {
+          glTexImage2D(faces[j], i, format_, width, height, 0, format_, GL_UNSIGNED_BYTE, nullptr);
+        }
+      }
+      width = max(width >> 1, 1);
+      height = max(height >> 1, 1);
+    }
+    _mem::free(ptr);
+  }
+  trackMemory(category_, memorySize(), 0);
+}
 
-  return texture;
+size_t Texture::memorySize() const {
+  size_t size = 0;
+  size_t width = width_;
+  size_t height = height_;
+  size_t depth = (target_ == GL_TEXTURE_3D ? depth_ : 1);
+  for (size_t i = 0; i < levels_; ++i) {
+    size += getImageSize(format_, width, height) * depth;
+    width = max(width >> 1, 1);
+    height = max(height >> 1, 1);
+    if (target_ == GL_TEXTURE_3D) {
+      depth = max(depth >> 1, 1);
+    }
+  }
+  if (target_ == GL_TEXTURE_CUBE_MAP) {
+    size *= 6;
+  } else if (target_ == GL_TEXTURE_2D_ARRAY) {
+    size *= depth_;
+  }
+  return size;
+}
+
+void Texture::setMemoryCategory(MemoryCategory category) {
+  if (category != category_) {
+    if (resident_) {
+      size_t size = memorySize();
+      trackMemory(category_, 0, size);
+      trackMemory(category, size, 0);
+    }
+    category_ = category;
+  }
+}
+
+void Texture::setEvictable(Loader loader, void* context) {
+  if (!loader_ && loader && resident_) {
+    trackEvictable(memorySize(), 0);
+    lastUse_ = WebGL::frameIndex();
+    lruLink_();
+  } else if (loader_ && !loader) {
+    if (resident_) {
+      trackEvictable(0, memorySize());
+      lruUnlink_();
+    } else {
+      restore();
+    }
+  }
+  loader_ = loader;
+  loaderContext_ = context;
+}
+
+void Texture::markUsed_() {
+  lastUse_ = WebGL::frameIndex();
+  if (loader_ && lruTail_ != this) {
+    lruUnlink_();
+    lruLink_();
+  }
+}
+
+void Texture::lruLink_() {
+  lruPrev_ = lruTail_;
+  lruNext_ = nullptr;
+  if (lruTail_) {
+    lruTail_->lruNext_ = this;
+  } else {
+    lruHead_ = this;
+  }
+  lruTail_ = this;
+}
+
+void Texture::lruUnlink_() {
+  if (lruPrev_) {
+    lruPrev_->lruNext_ = lruNext_;
+  } else {
+    lruHead_ = lruNext_;
+  }
+  if (lruNext_) {
+    lruNext_->lruPrev_ = lruPrev_;
+  } else {
+    lruTail_ = lruPrev_;
+  }
+  lruPrev_ = lruNext_ = nullptr;
+}
+
+// Textures in the list are ordered by last use, so the walk stops at the first one
+// used in the current frame
+void Texture::evict(size_t bytes) {
+  ui32 frame = WebGL::frameIndex();
+  size_t freed = 0;
+  Texture* texture = lruHead_;
+  while (texture && freed < bytes && texture->lastUse_ != frame) {
+    Texture* next = texture->lruNext_;
+    if (texture->category_ == MEMORY_TEXTURE) {
+      size_t size = texture->memorySize();
+      texture->lruUnlink_();
+      WebGL::forgetTexture(texture);
+      glDeleteTexture(texture);
+      texture->resident_ = false;
+      trackEvictable(0, size);
+      trackMemory(texture->category_, 0, size);
+      trackEviction(false);
+      freed += size;
+    }
+    texture = next;
+  }
+}
+
+void Texture::restore() {
+  if (resident_) {
+    return;
+  }
+  resident_ = true;
+  // Parameters set on the texture object are lost with it
+  if (baseLevel_ != 0) {
+    dirtyFlags_ |= fBASE_LEVEL;
+  }
+  if (maxLevel_ != 1000) {
+    dirtyFlags_ |= fMAX_LEVEL;
+  }
+  if (!WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+    if (magFilter_ != GL_LINEAR) {
+      dirtyFlags_ |= fMAG_FILTER;
+    }
+    if (minFilter_ != GL_NEAREST_MIPMAP_LINEAR) {
+      dirtyFlags_ |= fMIN_FILTER;
+    }
+    if (wrapS_ != GL_REPEAT) {
+      dirtyFlags_ |= fWRAP_S;
+    }
+    if (wrapT_ != GL_REPEAT) {
+      dirtyFlags_ |= fWRAP_T;
+    }
+    if (wrapR_ != GL_REPEAT) {
+      dirtyFlags_ |= fWRAP_R;
+    }
+    if (compareFunc_ != GL_LEQUAL) {
+      dirtyFlags_ |= fCOMPARE_FUNC;
+    }
+    if (compareMode_ != GL_NONE) {
+      dirtyFlags_ |= fCOMPARE_MODE;
+    }
+    if (minLod_ != -1000.0f) {
+      dirtyFlags_ |= fMIN_LOD;
+    }
+    if (maxLod_ != 1000.0f) {
+      dirtyFlags_ |= fMAX_LOD;
+    }
+    if (maxAnisotropy_ != 1.0f) {
+      dirtyFlags_ |= fMAX_ANISOTROPY;
+    }
+  }
+  // Marked used first so the budget check in allocate_ can't pick this texture
+  lastUse_ = WebGL::frameIndex();
+  lruLink_();
+  trackEvictable(memorySize(), 0);
+  allocate_();
+  trackEviction(true);
+  if (loader_) {
+    loader_(this, loaderContext_);
+  }
 }
 
 void Texture::subImage2D(int x, int y, size_t width, size_t height, GLenum format, GLenum type, const void* data, int level, GLenum target) {
@@ -231,6 +273,7 @@ void Texture::subImage2D(int x, int y, size_t width, size_t height, GLenum forma
     WebGL::bindBuffer(GL_PIXEL_UNPACK_BUFFER, nullptr);
   }
   glTexSubImage2D(target, level, x, y, width, height, format, type, data);
+  FRAME_STAT(textureBytes, width * height * getPixelSize(format, type));
 }
 void Texture::subImage3D(int x, int y, int z, size_t width, size_t height, size_t depth, GLenum format, GLenum type, const void* data, int level) {
   WebGL::bindTexture(target_, this);
@@ -238,6 +281,7 @@ void Texture::subImage3D(int x, int y, int z, size_t width, size_t height, size_
     WebGL::bindBuffer(GL_PIXEL_UNPACK_BUFFER, nullptr);
   }
   glTexSubImage3D(target_, level, x, y, z, width, height, depth, format, type, data);
+  FRAME_STAT(textureBytes, width * height * depth * getPixelSize(format, type));
 }
 
 void Texture::subImage2DBuffer(int x, int y, size_t width, size_t height, GLenum format, GLenum type, Buffer* buffer, size_t offset, int level, GLenum target) {
@@ -260,7 +304,9 @@ void Texture::copySubImage2D(int dstX, int dstY, int srcX, int srcY, size_t widt
 void Texture::setMagFilter(GLenum value) {
   if (value != magFilter_) {
     magFilter_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_MAG_FILTER, value);
     } else {
       dirtyFlags_ |= fMAG_FILTER;
@@ -270,7 +316,9 @@ void Texture::setMagFilter(GLenum value) {
 void Texture::setMinFilter(GLenum value) {
   if (value != minFilter_) {
     minFilter_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_MIN_FILTER, value);
     } else {
       dirtyFlags_ |= fMIN_FILTER;
@@ -300,7 +348,9 @@ void Texture::setMaxLevel(int value) {
 void Texture::setWrapS(GLenum value) {
   if (value != wrapS_) {
     wrapS_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_WRAP_S, value);
     } else {
       dirtyFlags_ |= fWRAP_S;
@@ -310,7 +360,9 @@ void Texture::setWrapS(GLenum value) {
 void Texture::setWrapT(GLenum value) {
   if (value != wrapT_) {
     wrapT_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_WRAP_T, value);
     } else {
       dirtyFlags_ |= fWRAP_T;
@@ -320,7 +372,9 @@ void Texture::setWrapT(GLenum value) {
 void Texture::setWrapR(GLenum value) {
   if (value != wrapR_) {
     wrapR_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_WRAP_R, value);
     } else {
       dirtyFlags_ |= fWRAP_R;
@@ -330,7 +384,9 @@ void Texture::setWrapR(GLenum value) {
 void Texture::setCompareFunc(GLenum value) {
   if (value != compareFunc_) {
     compareFunc_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_COMPARE_FUNC, value);
     } else {
       dirtyFlags_ |= fCOMPARE_FUNC;
@@ -340,7 +396,9 @@ void Texture::setCompareFunc(GLenum value) {
 void Texture::setCompareMode(GLenum value) {
   if (value != compareMode_) {
     compareMode_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameteri(target_, GL_TEXTURE_COMPARE_MODE, value);
     } else {
       dirtyFlags_ |= fCOMPARE_MODE;
@@ -350,7 +408,9 @@ void Texture::setCompareMode(GLenum value) {
 void Texture::setMinLod(float value) {
   if (value != minLod_) {
     minLod_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameterf(target_, GL_TEXTURE_MIN_LOD, value);
     } else {
       dirtyFlags_ |= fMIN_LOD;
@@ -360,7 +420,9 @@ void Texture::setMinLod(float value) {
 void Texture::setMaxLod(float value) {
   if (value != maxLod_) {
     maxLod_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameterf(target_, GL_TEXTURE_MAX_LOD, value);
     } else {
       dirtyFlags_ |= fMAX_LOD;
@@ -370,7 +432,9 @@ void Texture::setMaxLod(float value) {
 void Texture::setMaxAnisotropy(float value) {
   if (value != maxAnisotropy_) {
     maxAnisotropy_ = value;
-    if (isCurrent_()) {
+    if (WebGL::getFeature(FEATURE_SAMPLER_OBJECTS)) {
+      updateSampler_();
+    } else if (isCurrent_()) {
       glTexParameterf(target_, GL_TEXTURE_MAX_ANISOTROPY, value);
     } else {
       dirtyFlags_ |= fMAX_ANISOTROPY;
@@ -378,12 +442,54 @@ void Texture::setMaxAnisotropy(float value) {
   }
 }
 
+Texture::~Texture() {
+  if (resident_) {
+    WebGL::forgetTexture(this);
+    glDeleteTexture(this);
+    trackMemory(category_, 0, memorySize());
+    if (loader_) {
+      trackEvictable(0, memorySize());
+      lruUnlink_();
+    }
+  }
+}
+
+Sampler* Texture::sampler() {
+  if (!sampler_) {
+    SamplerDesc desc;
+    desc.magFilter = magFilter_;
+    desc.minFilter = minFilter_;
+    desc.wrapS = wrapS_;
+    desc.wrapT = wrapT_;
+    desc.wrapR = wrapR_;
+    desc.compareFunc = compareFunc_;
+    desc.compareMode = compareMode_;
+    desc.minLod = minLod_;
+    desc.maxLod = maxLod_;
+    desc.maxAnisotropy = maxAnisotropy_;
+    sampler_ = Ref<Sampler>::adopt(Sampler::create(desc));
+  }
+  return sampler_;
+}
+
+void Texture::updateSampler_() {
+  sampler_ = nullptr;
+  if (isCurrent_()) {
+    WebGL::bindSampler(TEXTURE_UNIT_CURRENT, sampler());
+  }
+}
+
 bool Texture::isCurrent_() const {
-  return WebGL::getTextureBinding(target_);
+  return WebGL::getTextureBinding(target_) == this;
 }
 
 void Texture::onBind(GLenum target) {
   glBindTexture(target, this);
+  FRAME_STAT(textureBinds, 1);
+  applyParameters();
+}
+
+void Texture::applyParameters() {
   if (dirtyFlags_) {
     if (dirtyFlags_ & fMAG_FILTER) {
       glTexParameteri(target_, GL_TEXTURE_MAG_FILTER, magFilter_);
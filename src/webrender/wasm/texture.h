@@ -1,5 +1,7 @@
 #pragma once
 #include "webgl.h"
+#include "memoryTracker.h"
+#include "sampler.h"
 
 namespace WebGL
 {
@@ -11,9 +13,7 @@ public:
   static Texture* create3D(GLenum format, size_t width, size_t height, size_t depth, size_t levels = 1);
   static Texture* create2DArray(GLenum format, size_t width, size_t height, size_t layers, size_t levels = 1);
 
-  ~Texture() {
-    glDeleteTexture(this);
-  }
+  ~Texture();
 
   GLenum target() const {
     return target_;
@@ -37,6 +37,37 @@ public:
     return levels_;
   }
 
+  // Bytes of storage for all levels, layers and faces
+  size_t memorySize() const;
+  MemoryCategory memoryCategory() const {
+    return category_;
+  }
+  // Frame buffers mark their attachments as render targets, which are never evicted
+  void setMemoryCategory(MemoryCategory category);
+
+  typedef void (*Loader)(Texture* texture, void* context);
+  // Lets the memory budget delete the texture's storage when it goes unused. The
+  // texture object stays valid; the next bind recreates the storage and calls loader
+  // to upload the contents again. nullptr makes the texture permanent again.
+  void setEvictable(Loader loader, void* context = nullptr);
+  bool evictable() const {
+    return loader_ != nullptr;
+  }
+  bool resident() const {
+    return resident_;
+  }
+  // Recreates the storage of an evicted texture; bindTexture does this on demand
+  void restore();
+  // Records a use in the current frame for the eviction order; called by bindTexture
+  void markUsed() {
+    if (lastUse_ != WebGL::frameIndex()) {
+      markUsed_();
+    }
+  }
+  // Evicts least recently used evictable textures that were not used in the current
+  // frame until at least bytes are freed
+  static void evict(size_t bytes);
+
   void image2D(GLenum format, GLenum type, const void* data, int level = 0, GLenum target = GL_TEXTURE_2D) {
     subImage2D(0, 0, width_, height_, format, type, data, level, target);
   }
@@ -137,7 +168,17 @@ public:
     setMaxLod(max);
   }
 
+  // Interned sampler object matching the sampling parameters (WebGL2). Bound along
+  // with the texture; on WebGL1 the parameters are set on the texture instead.
+  Sampler* sampler();
+
   void onBind(GLenum target);
+  // Parameters changed while the texture wasn't bound on the active unit are applied
+  // on the next bind, or by applyParameters() while it is bound there
+  bool parametersDirty() const {
+    return dirtyFlags_ != 0;
+  }
+  void applyParameters();
 
 private:
   Texture() {}
@@ -147,6 +188,16 @@ private:
   size_t height_;
   size_t depth_;
   size_t levels_;
+  MemoryCategory category_ = MEMORY_TEXTURE;
+  bool resident_ = true;
+  Loader loader_ = nullptr;
+  void* loaderContext_ = nullptr;
+  // Evictable textures in order of last use
+  ui32 lastUse_ = 0;
+  Texture* lruPrev_ = nullptr;
+  Texture* lruNext_ = nullptr;
+  static Texture* lruHead_;
+  static Texture* lruTail_;
 
   enum {
     fMAG_FILTER           = 0x0001,
@@ -175,8 +226,15 @@ private:
   float minLod_ = -1000.0f;
   float maxLod_ = 1000.0f;
   float maxAnisotropy_ = 1.0f;
+  Ref<Sampler> sampler_;
 
+  static Texture* create_(GLenum target, GLenum format, size_t width, size_t height, size_t depth, size_t levels);
+  void allocate_();
+  void markUsed_();
+  void lruLink_();
+  void lruUnlink_();
   bool isCurrent_() const;
+  void updateSampler_();
 };
 
 }
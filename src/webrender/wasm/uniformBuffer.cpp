@@ -0,0 +1,266 @@
+#include "uniformBuffer.h"
+#include "buffer.h"
+#include "program.h"
+#include "hash.h"
+#include "malloc.h"
+
+namespace WebGL
+{
+
+UniformBuffer* UniformBuffer::create(size_t capacity) {
+  UniformBuffer* buffer = new UniformBuffer;
+  size_t alignment = glGetInteger(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT);
+  if (alignment) {
+    buffer->alignment_ = alignment;
+  }
+  buffer->frame_ = WebGL::frameIndex();
+  buffer->grow_(capacity);
+  return buffer;
+}
+
+UniformBuffer::~UniformBuffer() {
+  for (ui32 i = 0; i < numRetired_; ++i) {
+    retired_[i]->release();
+  }
+  _mem::free(retired_);
+  buffer_->release();
+  _mem::free(staging_);
+}
+
+void UniformBuffer::grow_(size_t size) {
+  if (buffer_) {
+    upload();
+    if (numRetired_ == maxRetired_) {
+      maxRetired_ = (maxRetired_ ? maxRetired_ * 2 : 4);
+      retired_ = (Buffer**)_mem::realloc(retired_, maxRetired_ * sizeof(Buffer*));
+    }
+    retired_[numRetired_++] = buffer_;
+    _mem::free(staging_);
+  }
+  capacity_ = size;
+  buffer_ = Buffer::create(size, nullptr, GL_DYNAMIC_DRAW, GL_UNIFORM_BUFFER);
+  staging_ = (char*)_mem::malloc(size);
+  offset_ = 0;
+  uploaded_ = 0;
+}
+
+void UniformBuffer::beginFrame_() {
+  frame_ = WebGL::frameIndex();
+  for (ui32 i = 0; i < numRetired_; ++i) {
+    retired_[i]->release();
+  }
+  numRetired_ = 0;
+  if (offset_) {
+    buffer_->orphan();
+    offset_ = 0;
+    uploaded_ = 0;
+  }
+  uploads_ = 0;
+}
+
+void* UniformBuffer::allocate(size_t size, Range& range) {
+  if (frame_ != WebGL::frameIndex()) {
+    beginFrame_();
+  }
+  size_t offset = (offset_ + alignment_ - 1) / alignment_ * alignment_;
+  if (offset + size > capacity_) {
+    size_t capacity = capacity_ * 2;
+    while (capacity < size) {
+      capacity *= 2;
+    }
+    grow_(capacity);
+    offset = 0;
+  }
+  offset_ = offset + size;
+  range.buffer = buffer_;
+  range.offset = offset;
+  range.size = size;
+  return staging_ + offset;
+}
+
+void UniformBuffer::upload() {
+  if (offset_ > uploaded_) {
+    buffer_->setData(uploaded_, offset_ - uploaded_, staging_ + uploaded_);
+    uploaded_ = offset_;
+    uploads_ += 1;
+  }
+}
+
+void UniformBuffer::bind(GLuint index, const Range& range) {
+  bool uploaded = (range.buffer != buffer_ || range.offset + range.size <= uploaded_);
+  assert(uploaded);
+  if (!uploaded) {
+    upload();
+  }
+  WebGL::bindBufferRange(GL_UNIFORM_BUFFER, index, range.buffer, range.offset, range.size);
+}
+
+static bool getMatrixShape(GLenum type, ui32& columns, ui32& rows) {
+  switch (type) {
+  case GL_FLOAT_MAT2:   columns = 2; rows = 2; return true;
+  case GL_FLOAT_MAT3:   columns = 3; rows = 3; return true;
+  case GL_FLOAT_MAT4:   columns = 4; rows = 4; return true;
+  case GL_FLOAT_MAT2x3: columns = 2; rows = 3; return true;
+  case GL_FLOAT_MAT3x2: columns = 3; rows = 2; return true;
+  case GL_FLOAT_MAT2x4: columns = 2; rows = 4; return true;
+  case GL_FLOAT_MAT4x2: columns = 4; rows = 2; return true;
+  case GL_FLOAT_MAT3x4: columns = 3; rows = 4; return true;
+  case GL_FLOAT_MAT4x3: columns = 4; rows = 3; return true;
+  default:
+    return false;
+  }
+}
+
+UniformBlock* UniformBlock::create(Program* program, const char* name) {
+  enum {
+    MAX_NAME_LENGTH = 256,
+  };
+  GLuint blockIndex = glGetUniformBlockIndex(program, name);
+  if (blockIndex == GL_INVALID_INDEX) {
+    return nullptr;
+  }
+  GLint dataSize = 0;
+  GLint count = 0;
+  glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &dataSize);
+  glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORMS, &count);
+
+  // Scratch from malloc: the block and its tables are allocated while it is in use
+  GLint* indices = (GLint*)_mem::malloc(count * 4 * sizeof(GLint));
+  GLint* offsets = indices + count;
+  GLint* arrayStrides = offsets + count;
+  GLint* matrixStrides = arrayStrides + count;
+  if (count) {
+    glGetActiveUniformBlockiv(program, blockIndex, GL_UNIFORM_BLOCK_ACTIVE_UNIFORM_INDICES, indices);
+    glGetActiveUniformsiv(program, count, (const GLuint*)indices, GL_UNIFORM_OFFSET, offsets);
+    glGetActiveUniformsiv(program, count, (const GLuint*)indices, GL_UNIFORM_ARRAY_STRIDE, arrayStrides);
+    glGetActiveUniformsiv(program, count, (const GLuint*)indices, GL_UNIFORM_MATRIX_STRIDE, matrixStrides);
+  }
+
+  UniformBlock* block = new UniformBlock;
+  size_t dataWords = (dataSize + 3) / 4;
+  size_t tableSize = count * sizeof(Uniform) + dataWords * sizeof(ui32);
+  block->uniforms_ = (Uniform*)_mem::malloc(tableSize + count * MAX_NAME_LENGTH);
+  block->data_ = (char*)(block->uniforms_ + count);
+  block->names_ = block->data_ + dataWords * sizeof(ui32);
+  block->numUniforms_ = count;
+  block->dataSize_ = dataSize;
+  memset(block->data_, 0, dataWords * sizeof(ui32));
+
+  ui32 namesSize = 0;
+  for (GLint i = 0; i < count; ++i) {
+    char* name = block->names_ + namesSize;
+    GLint size = 0;
+    GLenum type = 0;
+    name[0] = 0;
+    glGetActiveUniform(program, indices[i], MAX_NAME_LENGTH, nullptr, &size, &type, name);
+    ui32 length = 0;
+    while (name[length]) {
+      ++length;
+    }
+    if (length > 3 && name[length - 3] == '[' && name[length - 2] == '0' && name[length - 1] == ']') {
+      length -= 3;
+      name[length] = 0;
+    }
+
+    Uniform& uniform = block->uniforms_[i];
+    uniform.type = type;
+    uniform.size = (size > 0 ? size : 1);
+    uniform.offset = offsets[i];
+    uniform.arrayStride = (arrayStrides[i] > 0 ? arrayStrides[i] : 0);
+    uniform.matrixStride = (matrixStrides[i] > 0 ? matrixStrides[i] : 0);
+    uniform.nameHash = hashString(name);
+    uniform.name = namesSize;
+    namesSize += length + 1;
+  }
+
+  _mem::free(indices);
+  return block;
+}
+
+UniformBlock::~UniformBlock() {
+  _mem::free(uniforms_);
+}
+
+int UniformBlock::getUniform(const char* name) const {
+  ui32 hash = hashString(name);
+  for (ui32 i = 0; i < numUniforms_; ++i) {
+    if (uniforms_[i].nameHash == hash && stringEqual(names_ + uniforms_[i].name, name)) {
+      return i;
+    }
+  }
+  return INVALID_UNIFORM;
+}
+
+void UniformBlock::setValue_(int index, GLenum baseType, const ui32* value, size_t count, size_t first) {
+  if (index < 0) {
+    return;
+  }
+  const Uniform& uniform = uniforms_[index];
+  GLenum uniformBaseType;
+  ui32 components = getUniformLayout(uniform.type, uniformBaseType);
+  assert(uniformBaseType == baseType);
+  assert(first + count <= uniform.size);
+
+  // std140 pads array elements and matrix columns, so copy column by column
+  ui32 columns = 1;
+  ui32 rows = components;
+  getMatrixShape(uniform.type, columns, rows);
+  for (size_t i = 0; i < count; ++i) {
+    char* element = data_ + uniform.offset + (first + i) * uniform.arrayStride;
+    for (ui32 c = 0; c < columns; ++c) {
+      ui32* dst = (ui32*)(element + c * uniform.matrixStride);
+      for (ui32 r = 0; r < rows; ++r, ++value) {
+        if (dst[r] != *value) {
+          dst[r] = *value;
+          dirty_ = true;
+        }
+      }
+    }
+  }
+}
+
+void UniformBlock::setUniform(int index, float x) {
+  setUniformv(index, &x);
+}
+void UniformBlock::setUniform(int index, float x, float y) {
+  float value[2] = {x, y};
+  setUniformv(index, value);
+}
+void UniformBlock::setUniform(int index, float x, float y, float z) {
+  float value[3] = {x, y, z};
+  setUniformv(index, value);
+}
+void UniformBlock::setUniform(int index, float x, float y, float z, float w) {
+  float value[4] = {x, y, z, w};
+  setUniformv(index, value);
+}
+void UniformBlock::setUniform(int index, i32 x) {
+  setUniformv(index, &x);
+}
+void UniformBlock::setUniform(int index, ui32 x) {
+  setUniformv(index, &x);
+}
+
+void UniformBlock::setUniformv(int index, const float* value, size_t count, size_t first) {
+  setValue_(index, GL_FLOAT, (const ui32*)value, count, first);
+}
+void UniformBlock::setUniformv(int index, const i32* value, size_t count, size_t first) {
+  setValue_(index, GL_INT, (const ui32*)value, count, first);
+}
+void UniformBlock::setUniformv(int index, const ui32* value, size_t count, size_t first) {
+  setValue_(index, GL_UNSIGNED_INT, value, count, first);
+}
+
+const UniformBuffer::Range& UniformBlock::commit(UniformBuffer* buffer) {
+  if (!dirty_ && lastBuffer_ == buffer && lastFrame_ == WebGL::frameIndex()) {
+    return lastRange_;
+  }
+  void* data = buffer->allocate(dataSize_, lastRange_);
+  memcpy(data, data_, dataSize_);
+  dirty_ = false;
+  lastBuffer_ = buffer;
+  lastFrame_ = WebGL::frameIndex();
+  return lastRange_;
+}
+
+}
@@ -4,33 +4,119 @@
 namespace WebGL
 {
 
+// Per-frame streaming storage for uniform block data. Blocks are packed into a CPU
+// staging copy at UNIFORM_BUFFER_OFFSET_ALIGNMENT and uploaded with a single
+// glBufferSubData. That takes filling every range of the frame first and calling
+// upload() once before the first bind; DrawQueue::submit does this for its items.
+// Binding a range that isn't uploaded yet asserts in debug builds and uploads on the
+// spot otherwise, which costs one glBufferSubData per bind when commits and binds
+// alternate.
 class UniformBuffer : public Object<UniformBuffer> {
 public:
-  static UniformBuffer* create(GLenum type) {
-    Shader* shader = new Shader;
-    glCreateShader(shader, type);
-    shader->type_ = type;
-    return shader;
+  struct Range {
+    Buffer* buffer = nullptr;
+    size_t offset = 0;
+    size_t size = 0;
+  };
+
+  static UniformBuffer* create(size_t capacity = 65536);
+  ~UniformBuffer();
+
+  // Reserves size bytes for the current frame and returns the memory to fill. Ranges
+  // stay valid until the end of the frame.
+  void* allocate(size_t size, Range& range);
+  void upload();
+  void bind(GLuint index, const Range& range);
+
+  size_t capacity() const {
+    return capacity_;
   }
-  ~Shader() {
-    glDeleteShader(this);
+  size_t used() const {
+    return offset_;
   }
-
-  void compile(char const* source) {
-    glShaderSource(this, source);
-    glCompileShader(this);
+  // Number of glBufferSubData calls issued in the current frame
+  ui32 uploads() const {
+    return uploads_;
   }
 
 private:
   UniformBuffer() {}
-  GLenum type_;
+  Buffer* buffer_ = nullptr;
+  char* staging_ = nullptr;
+  size_t capacity_ = 0;
+  size_t alignment_ = 256;
+  size_t offset_ = 0;
+  size_t uploaded_ = 0;
+  ui32 uploads_ = 0;
+  ui32 frame_ = 0;
+  // Buffers outgrown during a frame, kept alive for ranges that still refer to them
+  Buffer** retired_ = nullptr;
+  ui32 numRetired_ = 0;
+  ui32 maxRetired_ = 0;
+
+  void beginFrame_();
+  void grow_(size_t size);
 };
 
-class UniformBlock {
+// CPU copy of a uniform block laid out as reflected from a program. Setters write
+// into the copy; commit() packs it into a UniformBuffer, reusing the previous range
+// when nothing changed since the last commit in this frame.
+class UniformBlock : public Object<UniformBlock> {
 public:
-  UniformBuffer* create();
+  // Returns nullptr if the program has no active block with this name
+  static UniformBlock* create(Program* program, const char* name);
+  ~UniformBlock();
+
+  enum {
+    INVALID_UNIFORM = -1,
+  };
+  size_t dataSize() const {
+    return dataSize_;
+  }
+  size_t numUniforms() const {
+    return numUniforms_;
+  }
+  // Member names are matched as reported by the program, without a trailing [0]
+  int getUniform(const char* name) const;
+  const char* uniformName(int index) const {
+    return names_ + uniforms_[index].name;
+  }
+
+  void setUniform(int index, float x);
+  void setUniform(int index, float x, float y);
+  void setUniform(int index, float x, float y, float z);
+  void setUniform(int index, float x, float y, float z, float w);
+  void setUniform(int index, i32 x);
+  void setUniform(int index, ui32 x);
+  // Sets count array elements starting at element first; matrices are column-major
+  void setUniformv(int index, const float* value, size_t count = 1, size_t first = 0);
+  void setUniformv(int index, const i32* value, size_t count = 1, size_t first = 0);
+  void setUniformv(int index, const ui32* value, size_t count = 1, size_t first = 0);
+
+  const UniformBuffer::Range& commit(UniformBuffer* buffer);
 
 private:
+  UniformBlock() {}
+  struct Uniform {
+    ui32 type;
+    ui32 size;
+    ui32 offset;
+    ui32 arrayStride;
+    ui32 matrixStride;
+    ui32 nameHash;
+    ui32 name;
+  };
+  ui32 numUniforms_ = 0;
+  ui32 dataSize_ = 0;
+  Uniform* uniforms_ = nullptr;
+  char* data_ = nullptr;
+  char* names_ = nullptr;
+  bool dirty_ = true;
+  UniformBuffer* lastBuffer_ = nullptr;
+  ui32 lastFrame_ = 0;
+  UniformBuffer::Range lastRange_;
+
+  void setValue_(int index, GLenum baseType, const ui32* value, size_t count, size_t first);
 };
 
 }
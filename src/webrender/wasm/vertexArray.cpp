@@ -1,16 +1,37 @@
 #include "vertexArray.h"
 #include "buffer.h"
+#include "frameStats.h"
 
 namespace WebGL
 {
 
 ui32 VertexArray::enabledMask_ = 0;
 
+bool VertexLayout::operator==(const VertexLayout& other) const {
+  if (numAttributes != other.numAttributes || stride != other.stride) {
+    return false;
+  }
+  const ui32* lhs = (const ui32*)attributes;
+  const ui32* rhs = (const ui32*)other.attributes;
+  size_t words = numAttributes * sizeof(Attribute) / sizeof(ui32);
+  for (size_t i = 0; i < words; ++i) {
+    if (lhs[i] != rhs[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
 
 void VertexArray::setAttribute(int index, Buffer* buffer, size_t size, GLenum type, bool normalized, size_t stride, size_t offset, size_t divisor) {
   Attribute& info = attributes_[index];
+  if (info.buffer == buffer && info.size == size && info.type == type && info.normalized == normalized &&
+      info.stride == stride && info.offset == offset && info.divisor == divisor) {
+    return;
+  }
   bool wasEnabled = (info.buffer != nullptr);
-  info.buffer = buffer;
+  bool divisorChanged = (!wasEnabled || info.divisor != divisor);
+  info.buffer = Ref<Buffer>::borrow(buffer);
   info.size = size;
   info.type = type;
   info.normalized = normalized;
@@ -24,7 +45,7 @@ void VertexArray::setAttribute(int index, Buffer* buffer, size_t size, GLenum ty
     }
     WebGL::bindBuffer(GL_ARRAY_BUFFER, buffer);
     glVertexAttribPointer(index, size, type, normalized, stride, offset);
-    if (WebGL::getFeature(FEATURE_INSTANCED_RENDERING)) {
+    if (divisorChanged && WebGL::getFeature(FEATURE_INSTANCED_RENDERING)) {
       glVertexAttribDivisor(index, divisor);
     }
   } else {
@@ -46,7 +67,7 @@ void VertexArray::unsetAttribute(int index) {
 
 void VertexArray::setIndices(Buffer* indices) {
   if (indices_ != indices) {
-    indices_ = indices;
+    indices_ = Ref<Buffer>::borrow(indices);
     if (isCurrent_()) {
       WebGL::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices);
     } else {
@@ -56,6 +77,7 @@ void VertexArray::setIndices(Buffer* indices) {
 }
 
 void VertexArray::onBind() {
+  FRAME_STAT(vertexArrayBinds, 1);
   bool instanced = WebGL::getFeature(FEATURE_INSTANCED_RENDERING);
   if (WebGL::getFeature(FEATURE_VERTEX_ARRAY)) {
     glBindVertexArray(this);
@@ -79,7 +101,7 @@ void VertexArray::onBind() {
       }
       if (dirtyFlags_ & fINDICES) {
         // Can't use WebGL::bindBuffer because it doesn't correctly track VAO bindings
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indices_.get());
       }
       dirtyFlags_ = 0;
     }
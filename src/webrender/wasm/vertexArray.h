@@ -1,9 +1,39 @@
 #pragma once
 #include "webgl.h"
+#include "buffer.h"
 
 namespace WebGL
 {
 
+// Interleaved vertex format: attributes of one buffer with a common stride
+struct VertexLayout {
+  enum {
+    MAX_ATTRIBUTES = 8,
+  };
+  struct Attribute {
+    ui32 index;
+    ui32 size;
+    ui32 type;
+    ui32 normalized;
+    ui32 offset;
+  };
+  Attribute attributes[MAX_ATTRIBUTES];
+  ui32 numAttributes = 0;
+  ui32 stride = 0;
+
+  void add(ui32 index, ui32 size, GLenum type, bool normalized, ui32 offset) {
+    assert(numAttributes < MAX_ATTRIBUTES);
+    Attribute& attribute = attributes[numAttributes++];
+    attribute.index = index;
+    attribute.size = size;
+    attribute.type = type;
+    attribute.normalized = (normalized ? 1 : 0);
+    attribute.offset = offset;
+  }
+
+  bool operator==(const VertexLayout& other) const;
+};
+
 class VertexArray : public Object<VertexArray> {
 public:
   static VertexArray* create() {
@@ -30,7 +60,7 @@ private:
   static ui32 enabledMask_;
   VertexArray() {}
   struct Attribute {
-    Buffer* buffer = nullptr;
+    Ref<Buffer> buffer;
     size_t size;
     GLenum type;
     bool normalized;
@@ -44,7 +74,7 @@ private:
   };
   ui32 dirtyFlags_ = 0;
   Attribute attributes_[MAX_ATTRIBUTES];
-  Buffer* indices_ = nullptr;
+  Ref<Buffer> indices_;
 
   bool isCurrent_() const;
 };
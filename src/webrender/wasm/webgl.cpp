@@ -6,6 +6,11 @@
 #include "shader.h"
 #include "program.h"
 #include "vertexArray.h"
+#include "pipelineState.h"
+#include "sampler.h"
+#include "memoryTracker.h"
+#include "frameStats.h"
+#include "destroyQueue.h"
 
 namespace WebGL
 {
@@ -15,21 +20,41 @@ enum {
   NUM_RENDERBUFFER_SLOTS = 1,
   NUM_FRAMEBUFFER_SLOTS = 2,
   NUM_TEXTURE_SLOTS = 4,
+  NUM_UNIFORM_BUFFER_SLOTS = 24,
 };
 
+// Bound objects are held by reference, so nothing is destroyed while the cache still
+// points at it and a new object at the same address can't look bound
 static struct WebGLInstance {
   WebGLInstance();
 
   int version_;
   ui32 features_ = 0;
-  Buffer* bufferBinding_[NUM_BUFFER_SLOTS];
-  FrameBuffer* frameBufferBinding_[NUM_FRAMEBUFFER_SLOTS];
-  RenderBuffer* renderBufferBinding_[NUM_RENDERBUFFER_SLOTS];
+  Ref<Buffer> bufferBinding_[NUM_BUFFER_SLOTS];
+  struct BufferRange {
+    Ref<Buffer> buffer;
+    size_t offset = 0;
+    size_t size = 0;
+  } uniformBufferBinding_[NUM_UNIFORM_BUFFER_SLOTS];
+  Ref<FrameBuffer> frameBufferBinding_[NUM_FRAMEBUFFER_SLOTS];
+  Ref<RenderBuffer> renderBufferBinding_[NUM_RENDERBUFFER_SLOTS];
   size_t maxTextureUnits_;
   ui32 activeTexture_ = 0;
-  Texture** textureBindings_[NUM_TEXTURE_SLOTS];
-  Program* program_ = nullptr;
-  VertexArray* vertexArray_ = nullptr;
+  Ref<Texture>* textureBindings_[NUM_TEXTURE_SLOTS];
+  Ref<Sampler>* samplerBindings_;
+  ui32* textureUnitUse_;
+  ui32 textureUseCounter_ = 0;
+  Ref<Program> program_;
+  Ref<VertexArray> vertexArray_;
+  Ref<PipelineState> pipelineState_;
+  // GL defaults applied by setPipelineState(nullptr), created on first use
+  Ref<PipelineState> defaultPipelineState_;
+  PipelineDesc pipeline_;
+  GLint viewport_[4];
+  GLint scissor_[4];
+  ui32 frameIndex_ = 0;
+  StateStats frameStats_;
+  StateStats lastFrameStats_;
 } instance_;
 
 static int getBufferSlot(GLenum target) {
@@ -81,20 +106,6 @@ static int getTextureSlot(GLenum target) {
     return 0;
   }
 }
-static GLenum getTextureTarget(int slot) {
-  switch (slot) {
-  case 0:
-    return GL_TEXTURE_2D;
-  case 1:
-    return GL_TEXTURE_CUBE_MAP;
-  case 2:
-    return GL_TEXTURE_3D;
-  case 3:
-    return GL_TEXTURE_2D_ARRAY;
-  default:
-    return GL_TEXTURE_2D;
-  }
-}
 
 WebGLInstance::WebGLInstance() {
   version_ = glVersion();
@@ -105,19 +116,41 @@ WebGLInstance::WebGLInstance() {
   if (version_ >= 2 || glGetExtension("ANGLE_instanced_arrays")) {
     features_ |= FEATURE_INSTANCED_RENDERING;
   }
-  
-  for (int i = 0; i < NUM_BUFFER_SLOTS; ++i) {
-    bufferBinding_[i] = nullptr;
+  if (version_ >= 2) {
+    features_ |= FEATURE_SAMPLER_OBJECTS;
+    features_ |= FEATURE_FENCE_SYNC;
+  }
+  if (glGetExtension(version_ >= 2 ? "EXT_disjoint_timer_query_webgl2" : "EXT_disjoint_timer_query")) {
+    features_ |= FEATURE_TIMER_QUERY;
+  }
+  if (glGetExtension("KHR_parallel_shader_compile")) {
+    features_ |= FEATURE_PARALLEL_COMPILE;
   }
-  renderBufferBinding_[0] = nullptr;
+  if (glGetExtension("WEBGL_multi_draw")) {
+    features_ |= FEATURE_MULTI_DRAW;
+  }
+  
   maxTextureUnits_ = glGetInteger(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS);
-  Texture** texPtr = (Texture**)sbrk(sizeof(Texture*) * maxTextureUnits_ * NUM_TEXTURE_SLOTS);
+  // Zero filled Refs are null
+  Ref<Texture>* texPtr = (Ref<Texture>*)sbrk(sizeof(Ref<Texture>) * maxTextureUnits_ * NUM_TEXTURE_SLOTS);
+  memset(texPtr, 0, sizeof(Ref<Texture>) * maxTextureUnits_ * NUM_TEXTURE_SLOTS);
   for (int i = 0; i < NUM_TEXTURE_SLOTS; ++i) {
     textureBindings_[i] = texPtr + maxTextureUnits_ * i;
-    for (int j = 0; j < maxTextureUnits_; ++j) {
-      textureBindings_[i][j] = nullptr;
-    }
   }
+  samplerBindings_ = (Ref<Sampler>*)sbrk(sizeof(Ref<Sampler>) * maxTextureUnits_);
+  memset(samplerBindings_, 0, sizeof(Ref<Sampler>) * maxTextureUnits_);
+  textureUnitUse_ = (ui32*)sbrk(sizeof(ui32) * maxTextureUnits_);
+  for (size_t i = 0; i < maxTextureUnits_; ++i) {
+    textureUnitUse_[i] = 0;
+  }
+  viewport_[0] = scissor_[0] = 0;
+  viewport_[1] = scissor_[1] = 0;
+  viewport_[2] = scissor_[2] = glCanvasWidth();
+  viewport_[3] = scissor_[3] = glCanvasHeight();
+
+#ifdef GL_FRAME_STATS
+  glFrameStats(&frameStats_);
+#endif
 }
 
 int version() {
@@ -133,17 +166,33 @@ Buffer* getBufferBinding(GLenum target) {
 void bindBuffer(GLenum target, Buffer* buffer) {
   int slot = getBufferSlot(target);
   if (instance_.bufferBinding_[slot] != buffer) {
-    instance_.bufferBinding_[slot] = buffer;
+    instance_.bufferBinding_[slot] = Ref<Buffer>::borrow(buffer);
     buffer->onBind(target);
+  } else {
+    FRAME_STAT(redundantBinds, 1);
   }
 }
 
+void bindBufferRange(GLenum target, GLuint index, Buffer* buffer, size_t offset, size_t size) {
+  instance_.bufferBinding_[getBufferSlot(target)] = Ref<Buffer>::borrow(buffer);
+  if (target == GL_UNIFORM_BUFFER && index < NUM_UNIFORM_BUFFER_SLOTS) {
+    WebGLInstance::BufferRange& range = instance_.uniformBufferBinding_[index];
+    if (range.buffer == buffer && range.offset == offset && range.size == size) {
+      return;
+    }
+    range.buffer = Ref<Buffer>::borrow(buffer);
+    range.offset = offset;
+    range.size = size;
+  }
+  glBindBufferRange(target, index, buffer, offset, size);
+}
+
 RenderBuffer* getRenderBufferBinding() {
   return instance_.renderBufferBinding_[0];
 }
 void bindRenderBuffer(RenderBuffer* renderBuffer) {
   if (instance_.renderBufferBinding_[0] != renderBuffer) {
-    instance_.renderBufferBinding_[0] = renderBuffer;
+    instance_.renderBufferBinding_[0] = Ref<RenderBuffer>::borrow(renderBuffer);
     renderBuffer->onBind(GL_RENDERBUFFER);
   }
 }
@@ -154,15 +203,29 @@ FrameBuffer* getFrameBufferBinding(GLenum target) {
 void bindFrameBuffer(GLenum target, FrameBuffer* frameBuffer) {
   if (target == GL_FRAMEBUFFER) {
     if (instance_.frameBufferBinding_[0] != frameBuffer || instance_.frameBufferBinding_[1] != frameBuffer) {
-      instance_.frameBufferBinding_[0] = frameBuffer;
-      instance_.frameBufferBinding_[1] = frameBuffer;
-      frameBuffer->onBind(target);
+      instance_.frameBufferBinding_[0] = Ref<FrameBuffer>::borrow(frameBuffer);
+      instance_.frameBufferBinding_[1] = instance_.frameBufferBinding_[0];
+      if (frameBuffer) {
+        frameBuffer->onBind(target);
+      } else {
+        glBindFramebuffer(target, nullptr);
+        FRAME_STAT(frameBufferSwitches, 1);
+      }
+    } else {
+      FRAME_STAT(redundantBinds, 1);
     }
   } else {
     int slot = getFrameBufferSlot(target);
     if (instance_.frameBufferBinding_[slot] != frameBuffer) {
-      instance_.frameBufferBinding_[slot] = frameBuffer;
-      frameBuffer->onBind(target);
+      instance_.frameBufferBinding_[slot] = Ref<FrameBuffer>::borrow(frameBuffer);
+      if (frameBuffer) {
+        frameBuffer->onBind(target);
+      } else {
+        glBindFramebuffer(target, nullptr);
+        FRAME_STAT(frameBufferSwitches, 1);
+      }
+    } else {
+      FRAME_STAT(redundantBinds, 1);
     }
   }
 }
@@ -177,6 +240,13 @@ Texture* getTextureBinding(GLenum target, ui32 unit) {
     return instance_.textureBindings_[getTextureSlot(target)][unit];
   }
 }
+static void setActiveTexture_(ui32 unit) {
+  if (instance_.activeTexture_ != unit) {
+    instance_.activeTexture_ = unit;
+    glActiveTexture(GL_TEXTURE0 + unit);
+  }
+}
+
 void bindTexture(GLenum target, Texture* texture, ui32 unit) {
   if (unit == TEXTURE_UNIT_CURRENT) {
     unit = instance_.activeTexture_;
@@ -184,19 +254,114 @@ void bindTexture(GLenum target, Texture* texture, ui32 unit) {
   if (unit >= instance_.maxTextureUnits_) {
     return;
   }
+  if (texture) {
+    if (!texture->resident()) {
+      // Restoring binds through the active unit, so it must not be another draw's
+      setActiveTexture_(unit);
+      texture->restore();
+    }
+    texture->markUsed();
+  }
   int slot = getTextureSlot(target);
   if (instance_.textureBindings_[slot][unit] != texture) {
-    if (instance_.activeTexture_ != unit) {
-      instance_.activeTexture_ = unit;
-      glActiveTexture(GL_TEXTURE0 + unit);
-      for (int i = 0; i < NUM_TEXTURE_SLOTS; ++i) {
-        if (instance_.textureBindings_[i][unit]) {
-          instance_.textureBindings_[i][unit]->onBind(getTextureTarget(i));
+    // Bindings of the other targets on the new unit are still in place
+    setActiveTexture_(unit);
+    instance_.textureBindings_[slot][unit] = Ref<Texture>::borrow(texture);
+    if (texture) {
+      texture->onBind(target);
+    } else {
+      glBindTexture(target, nullptr);
+      FRAME_STAT(textureBinds, 1);
+    }
+  } else {
+    FRAME_STAT(redundantBinds, 1);
+    if (texture && texture->parametersDirty()) {
+      setActiveTexture_(unit);
+      texture->applyParameters();
+    }
+  }
+  if (texture && (instance_.features_ & FEATURE_SAMPLER_OBJECTS)) {
+    bindSampler(unit, texture->sampler());
+  }
+}
+void forgetTexture(Texture* texture) {
+  for (int slot = 0; slot < NUM_TEXTURE_SLOTS; ++slot) {
+    for (size_t unit = 0; unit < instance_.maxTextureUnits_; ++unit) {
+      if (instance_.textureBindings_[slot][unit] == texture) {
+        instance_.textureBindings_[slot][unit] = nullptr;
+      }
+    }
+  }
+}
+
+Sampler* getSamplerBinding(ui32 unit) {
+  if (unit == TEXTURE_UNIT_CURRENT) {
+    unit = instance_.activeTexture_;
+  }
+  if (unit >= instance_.maxTextureUnits_) {
+    return nullptr;
+  } else {
+    return instance_.samplerBindings_[unit];
+  }
+}
+void bindSampler(ui32 unit, Sampler* sampler) {
+  if (unit == TEXTURE_UNIT_CURRENT) {
+    unit = instance_.activeTexture_;
+  }
+  if (unit >= instance_.maxTextureUnits_ || instance_.samplerBindings_[unit] == sampler) {
+    return;
+  }
+  instance_.samplerBindings_[unit] = Ref<Sampler>::borrow(sampler);
+  glBindSampler(unit, sampler);
+}
+
+void bindTextures(Texture* const* textures, size_t count, ui32* units) {
+  size_t numUnits = instance_.maxTextureUnits_;
+  assert(count <= numUnits);
+  ui32 stamp = ++instance_.textureUseCounter_;
+  ui32* lastUse = instance_.textureUnitUse_;
+
+  // Claim units of resident textures first so misses can't evict them
+  ui32 missing = 0;
+  for (size_t i = 0; i < count; ++i) {
+    Ref<Texture>* bindings = instance_.textureBindings_[getTextureSlot(textures[i]->target())];
+    units[i] = TEXTURE_UNIT_CURRENT;
+    for (size_t unit = 0; unit < numUnits; ++unit) {
+      if (bindings[unit] == textures[i]) {
+        units[i] = unit;
+        lastUse[unit] = stamp;
+        textures[i]->markUsed();
+        if (textures[i]->parametersDirty()) {
+          setActiveTexture_(unit);
+          textures[i]->applyParameters();
+        }
+        if (instance_.features_ & FEATURE_SAMPLER_OBJECTS) {
+          bindSampler(unit, textures[i]->sampler());
         }
+        break;
+      }
+    }
+    if (units[i] == TEXTURE_UNIT_CURRENT) {
+      missing += 1;
+    }
+  }
+  instance_.frameStats_.textureHits += count - missing;
+  instance_.frameStats_.textureMisses += missing;
+
+  for (size_t i = 0; i < count && missing; ++i) {
+    if (units[i] != TEXTURE_UNIT_CURRENT) {
+      continue;
+    }
+    size_t victim = 0;
+    for (size_t unit = 1; unit < numUnits; ++unit) {
+      if (stamp - lastUse[unit] > stamp - lastUse[victim]) {
+        victim = unit;
       }
     }
-    instance_.textureBindings_[slot][unit] = texture;
-    texture->onBind(target);
+    units[i] = victim;
+    lastUse[victim] = stamp;
+    bindTexture(textures[i]->target(), textures[i], victim);
+    missing -= 1;
   }
 }
 
@@ -205,8 +370,15 @@ Program* getProgram() {
 }
 void useProgram(Program* program) {
   if (instance_.program_ != program) {
-    instance_.program_ = program;
-    glUseProgram(program);
+    instance_.program_ = Ref<Program>::borrow(program);
+    if (program) {
+      program->onBind();
+    } else {
+      glUseProgram(nullptr);
+    }
+    FRAME_STAT(programSwitches, 1);
+  } else {
+    FRAME_STAT(redundantBinds, 1);
   }
 }
 
@@ -215,9 +387,160 @@ VertexArray* getVertexArrayBinding() {
 }
 void bindVertexArray(VertexArray* vertexArray) {
   if (instance_.vertexArray_ != vertexArray) {
-    instance_.vertexArray_ = vertexArray;
+    instance_.vertexArray_ = Ref<VertexArray>::borrow(vertexArray);
     vertexArray->onBind();
+  } else {
+    FRAME_STAT(redundantBinds, 1);
+  }
+}
+
+PipelineState* getPipelineState() {
+  return instance_.pipelineState_;
+}
+void setPipelineState(PipelineState* state) {
+  if (instance_.pipelineState_ == state) {
+    instance_.frameStats_.callsElided += PipelineState::NUM_STATE_CALLS;
+    return;
+  }
+  instance_.pipelineState_ = Ref<PipelineState>::borrow(state);
+
+  ui32 calls;
+  if (state) {
+    calls = state->onBind(instance_.pipeline_);
+  } else {
+    if (!instance_.defaultPipelineState_) {
+      instance_.defaultPipelineState_ = Ref<PipelineState>::adopt(PipelineState::create(PipelineDesc()));
+    }
+    calls = instance_.defaultPipelineState_->onBind(instance_.pipeline_);
+  }
+  instance_.frameStats_.stateChanges += 1;
+  instance_.frameStats_.callsIssued += calls;
+  instance_.frameStats_.callsElided += PipelineState::NUM_STATE_CALLS - calls;
+}
+
+// A multi-draw call counts as one draw
+void multiDrawArrays(GLenum mode, const GLint* firsts, const GLsizei* counts, size_t drawCount) {
+  if (instance_.features_ & FEATURE_MULTI_DRAW) {
+    glMultiDrawArrays(mode, firsts, counts, (GLsizei)drawCount);
+#ifdef GL_FRAME_STATS
+    FRAME_STAT(draws, 1);
+    for (size_t i = 0; i < drawCount; ++i) {
+      FRAME_STAT(triangles, countTriangles_(mode, counts[i], 1));
+    }
+#endif
+    return;
+  }
+  for (size_t i = 0; i < drawCount; ++i) {
+    glDrawArrays(mode, firsts[i], counts[i]);
+    FRAME_DRAW(mode, counts[i], 1);
+  }
+}
+void multiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets, size_t drawCount) {
+  if (instance_.features_ & FEATURE_MULTI_DRAW) {
+    glMultiDrawElements(mode, counts, type, offsets, (GLsizei)drawCount);
+#ifdef GL_FRAME_STATS
+    FRAME_STAT(draws, 1);
+    for (size_t i = 0; i < drawCount; ++i) {
+      FRAME_STAT(triangles, countTriangles_(mode, counts[i], 1));
+    }
+#endif
+    return;
+  }
+  for (size_t i = 0; i < drawCount; ++i) {
+    glDrawElements(mode, counts[i], type, offsets[i]);
+    FRAME_DRAW(mode, counts[i], 1);
+  }
+}
+void multiDrawElementsInstanced(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets,
+                                const GLsizei* instanceCounts, size_t drawCount) {
+  if (instance_.features_ & FEATURE_MULTI_DRAW) {
+    glMultiDrawElementsInstanced(mode, counts, type, offsets, instanceCounts, (GLsizei)drawCount);
+#ifdef GL_FRAME_STATS
+    FRAME_STAT(draws, 1);
+    for (size_t i = 0; i < drawCount; ++i) {
+      FRAME_STAT(triangles, countTriangles_(mode, counts[i], instanceCounts[i]));
+    }
+#endif
+    return;
+  }
+  assert(instance_.features_ & FEATURE_INSTANCED_RENDERING);
+  for (size_t i = 0; i < drawCount; ++i) {
+    glDrawElementsInstanced(mode, counts[i], type, offsets[i], instanceCounts[i]);
+    FRAME_DRAW(mode, counts[i], instanceCounts[i]);
+  }
+}
+
+static void setRect(GLint* rect, GLint x, GLint y, GLsizei width, GLsizei height, void (*func)(GLint, GLint, GLsizei, GLsizei)) {
+  if (rect[0] != x || rect[1] != y || rect[2] != (GLint)width || rect[3] != (GLint)height) {
+    rect[0] = x;
+    rect[1] = y;
+    rect[2] = width;
+    rect[3] = height;
+    func(x, y, width, height);
+    instance_.frameStats_.callsIssued += 1;
+  } else {
+    instance_.frameStats_.callsElided += 1;
+  }
+}
+void setViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
+  setRect(instance_.viewport_, x, y, width, height, glViewport);
+}
+void setScissor(GLint x, GLint y, GLsizei width, GLsizei height) {
+  setRect(instance_.scissor_, x, y, width, height, glScissor);
+}
+
+const StateStats& getStateStats() {
+  return instance_.lastFrameStats_;
+}
+
+void shutdown() {
+  for (int i = 0; i < NUM_BUFFER_SLOTS; ++i) {
+    instance_.bufferBinding_[i] = nullptr;
+  }
+  for (int i = 0; i < NUM_UNIFORM_BUFFER_SLOTS; ++i) {
+    instance_.uniformBufferBinding_[i] = WebGLInstance::BufferRange();
+  }
+  for (int i = 0; i < NUM_FRAMEBUFFER_SLOTS; ++i) {
+    instance_.frameBufferBinding_[i] = nullptr;
+  }
+  instance_.renderBufferBinding_[0] = nullptr;
+  for (size_t unit = 0; unit < instance_.maxTextureUnits_; ++unit) {
+    for (int slot = 0; slot < NUM_TEXTURE_SLOTS; ++slot) {
+      instance_.textureBindings_[slot][unit] = nullptr;
+    }
+    instance_.samplerBindings_[unit] = nullptr;
+  }
+  instance_.program_ = nullptr;
+  instance_.vertexArray_ = nullptr;
+  instance_.pipelineState_ = nullptr;
+  instance_.defaultPipelineState_ = nullptr;
+  destroyReleased();
+#ifdef GL_COMMAND_BUFFER
+  GLCommands::flush();
+#endif
+#ifdef GL_LEAK_CHECK
+  reportLeaks_();
+#endif
+}
+
+ui32 frameIndex() {
+  return instance_.frameIndex_;
+}
+void endFrame() {
+  collectReleased_(instance_.frameIndex_);
+  instance_.lastFrameStats_ = instance_.frameStats_;
+  instance_.frameStats_ = StateStats();
+  instance_.frameIndex_ += 1;
+#ifdef GL_FRAME_STATS
+  swapFrameStats_(instance_.frameIndex_);
+#endif
+  enforceMemoryBudget();
+#ifdef GL_COMMAND_BUFFER
+  GLCommands::flush();
+  if (GLCommands::capturing_) {
+    GLCommands::captureEndFrame_(instance_.frameIndex_ - 1);
   }
+#endif
 }
 
 }
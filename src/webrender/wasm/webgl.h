@@ -2,6 +2,7 @@
 
 #include "common.h"
 #include "glbindings.h"
+#include "ref.h"
 
 namespace WebGL
 {
@@ -23,6 +24,11 @@ public:
 
 protected:
   Object() {};
+
+private:
+  SizedPool& sizedPool_() const override {
+    return SizedAllocator<sizeof(T)>::pool();
+  }
 };
 
 class Buffer;
@@ -32,10 +38,20 @@ class Texture;
 class Shader;
 class Program;
 class VertexArray;
+class PipelineState;
+class Sampler;
+class Sync;
+class Query;
+class StreamBuffer;
 
 enum {
   FEATURE_VERTEX_ARRAY            = 0x0001,
   FEATURE_INSTANCED_RENDERING     = 0x0002,
+  FEATURE_SAMPLER_OBJECTS         = 0x0004,
+  FEATURE_FENCE_SYNC              = 0x0008,
+  FEATURE_TIMER_QUERY             = 0x0010,
+  FEATURE_PARALLEL_COMPILE        = 0x0020,
+  FEATURE_MULTI_DRAW              = 0x0040,
 };
 
 int version();
@@ -47,6 +63,9 @@ enum {
 
 Buffer* getBufferBinding(GLenum target);
 void bindBuffer(GLenum target, Buffer* buffer);
+// Indexed binding (GL_UNIFORM_BUFFER, GL_TRANSFORM_FEEDBACK_BUFFER); also replaces
+// the generic binding for target
+void bindBufferRange(GLenum target, GLuint index, Buffer* buffer, size_t offset, size_t size);
 
 RenderBuffer* getRenderBufferBinding();
 void bindRenderBuffer(RenderBuffer* renderBuffer);
@@ -55,7 +74,20 @@ FrameBuffer* getFrameBufferBinding(GLenum target);
 void bindFrameBuffer(GLenum target, FrameBuffer* frameBuffer);
 
 Texture* getTextureBinding(GLenum target, ui32 unit = TEXTURE_UNIT_CURRENT);
+// Also restores evicted textures and marks the texture as used for eviction order
 void bindTexture(GLenum target, Texture* texture, ui32 unit = TEXTURE_UNIT_CURRENT);
+// Drops a texture from the binding cache when its GL object is deleted, which
+// unbinds it in GL
+void forgetTexture(Texture* texture);
+// Sampler bound to a texture unit (WebGL2). bindTexture also binds the texture's own
+// sampler, so an override has to follow the bindTexture call.
+Sampler* getSamplerBinding(ui32 unit = TEXTURE_UNIT_CURRENT);
+void bindSampler(ui32 unit, Sampler* sampler);
+
+// Picks texture units for a draw. Textures already bound to a unit keep it, the rest
+// replace the least recently used bindings; units receives the unit of each texture.
+// Units stay valid until the next call or a manual bindTexture.
+void bindTextures(Texture* const* textures, size_t count, ui32* units);
 
 Program* getProgram();
 void useProgram(Program* program);
@@ -63,4 +95,40 @@ void useProgram(Program* program);
 VertexArray* getVertexArrayBinding();
 void bindVertexArray(VertexArray* vertexArray);
 
+PipelineState* getPipelineState();
+// Binds a pipeline state, issuing only the calls that differ from the current state.
+// nullptr restores the GL defaults.
+void setPipelineState(PipelineState* state);
+
+// Several draws with the current state in one call (WEBGL_multi_draw), or one call
+// per draw without the extension. Offsets are in bytes. Shaders can't use gl_DrawID
+// since the fallback has no way to set it.
+void multiDrawArrays(GLenum mode, const GLint* firsts, const GLsizei* counts, size_t drawCount);
+void multiDrawElements(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets, size_t drawCount);
+void multiDrawElementsInstanced(GLenum mode, const GLsizei* counts, GLenum type, const GLintptr* offsets,
+                                const GLsizei* instanceCounts, size_t drawCount);
+
+void setViewport(GLint x, GLint y, GLsizei width, GLsizei height);
+void setScissor(GLint x, GLint y, GLsizei width, GLsizei height);
+
+struct StateStats {
+  ui32 stateChanges = 0;
+  ui32 callsIssued = 0;
+  ui32 callsElided = 0;
+  // bindTextures results: textures found on a unit vs bound to a new one
+  ui32 textureHits = 0;
+  ui32 textureMisses = 0;
+};
+// Stats for the last completed frame
+const StateStats& getStateStats();
+
+ui32 frameIndex();
+// Drops every binding and destroys all released objects; objects still alive after
+// that are leaks, which debug builds report (destroyQueue.h)
+void shutdown();
+
+// Marks the end of a frame: destroys released objects the GPU is done with, rolls over
+// per-frame stats, enforces the memory budget and flushes batched commands.
+void endFrame();
+
 }
@@ -1,14 +1,44 @@
 import * as GL from './constants';
+import createCommandDecoder from './commands';
 
 export default function createBindings(renderer, memory) {
   const {
     context: gl,
     objects_,
+    handles_,
     objectsReverse_,
     uniformLocations_,
     uniformLocationsReverse_,
   } = renderer;
 
+  // Object handles (wasm/alloc.h) are a slot index in the low 24 bits and a generation
+  // above, so a handle kept past its object's deletion resolves to null
+  const HANDLE_INDEX_MASK = 0xFFFFFF;
+  function object(handle) {
+    const index = handle & HANDLE_INDEX_MASK;
+    return handles_[index] === (handle | 0) ? objects_[index] : null;
+  }
+  function setObject(handle, obj) {
+    const index = handle & HANDLE_INDEX_MASK;
+    while (objects_.length < index) {
+      objects_.push(null);
+      handles_.push(0);
+    }
+    objects_[index] = obj;
+    handles_[index] = handle | 0;
+    objectsReverse_.set(obj, handle);
+  }
+  function deleteObject(handle) {
+    const obj = object(handle);
+    if (obj !== null) {
+      const index = handle & HANDLE_INDEX_MASK;
+      objects_[index] = null;
+      handles_[index] = 0;
+      objectsReverse_.delete(obj);
+    }
+    return obj;
+  }
+
   // Memory access functions
   const {
     arrayBuffer,
@@ -129,18 +159,18 @@ export default function createBindings(renderer, memory) {
   // Explicit uniform setter
   function bindUniform(func) {
     return function(location, ...args) {
-      func.call(gl, uniformLocations_.get(location), ...args);
+      func.call(gl, uniformLocations_[location], ...args);
     };
   }
   // Uniform 
   function bindUniformv(func, type, getView, size) {
     if (isWebGL2) {
       return function(location, count, offset) {
-        func.call(gl, uniformLocations_.get(location), getView(), offset / type.BYTES_PER_ELEMENT, count * size);
+        func.call(gl, uniformLocations_[location], getView(), offset / type.BYTES_PER_ELEMENT, count * size);
       };
     } else {
       return function(location, count, offset) {
-        func.call(gl, uniformLocations_.get(location), new type(arrayBuffer(), offset, count * size));
+        func.call(gl, uniformLocations_[location], new type(arrayBuffer(), offset, count * size));
       };
     }
   }
@@ -149,11 +179,11 @@ export default function createBindings(renderer, memory) {
   function bindUniformMatrixv(func, size) {
     if (isWebGL2) {
       return function(location, count, transpose, offset) {
-        func.call(gl, uniformLocations_.get(location), transpose, float32View(), offset >> 2, count * size);
+        func.call(gl, uniformLocations_[location], transpose, float32View(), offset >> 2, count * size);
       };
     } else {
       return function(location, count, transpose, offset) {
-        func.call(gl, uniformLocations_.get(location), transpose, new Float32Array(arrayBuffer(), offset, count * size));
+        func.call(gl, uniformLocations_[location], transpose, new Float32Array(arrayBuffer(), offset, count * size));
       };
     }
   }
@@ -234,7 +264,7 @@ export default function createBindings(renderer, memory) {
 
     // Buffers
     glBindBuffer(target, buffer) {
-      gl.bindBuffer(target, objects_.get(buffer));
+      gl.bindBuffer(target, object(buffer));
     },
     glBufferData(target, size, data, usage) {
       if (data) {
@@ -248,18 +278,15 @@ export default function createBindings(renderer, memory) {
     },
     glCreateBuffer(index) {
       const buffer = gl.createBuffer();
-      objects_.set(index, buffer);
-      objectsReverse_.set(buffer, index);
+      setObject(index, buffer);
     },
     glDeleteBuffer(index) {
-      const buffer = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(buffer);
+      const buffer = deleteObject(index);
       gl.deleteBuffer(buffer);
     },
     glGetBufferParameter: gl.getBufferParameter.bind(gl),
     glIsBuffer(buffer) {
-      return objects_.has(buffer) && gl.isBuffer(objects_.get(buffer));
+      return gl.isBuffer(object(buffer));
     },
     // WebGL2
     glCopyBufferSubData: bindOptional(gl.copyBufferSubData),
@@ -269,25 +296,22 @@ export default function createBindings(renderer, memory) {
 
     // Framebuffers
     glBindFramebuffer(target, framebuffer) {
-      gl.bindFramebuffer(target, objects_.get(framebuffer));
+      gl.bindFramebuffer(target, object(framebuffer));
     },
     glCheckFramebufferStatus: gl.checkFramebufferStatus.bind(gl),
     glCreateFramebuffer(index) {
       const framebuffer = gl.createFramebuffer();
-      objects_.set(index, framebuffer);
-      objectsReverse_.set(framebuffer, index);
+      setObject(index, framebuffer);
     },
     glDeleteFramebuffer(index) {
-      const framebuffer = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(framebuffer);
+      const framebuffer = deleteObject(index);
       gl.deleteFramebuffer(framebuffer);
     },
     glFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer) {
-      gl.framebufferRenderbuffer(target, attachment, renderbuffertarget, objects_.get(renderbuffer));
+      gl.framebufferRenderbuffer(target, attachment, renderbuffertarget, object(renderbuffer));
     },
     glFramebufferTexture2D(target, attachment, textarget, texture, level) {
-      gl.framebufferTexture2D(target, attachment, textarget, objects_.get(texture), level);
+      gl.framebufferTexture2D(target, attachment, textarget, object(texture), level);
     },
     glGetFramebufferAttachmentParameter(target, attachment, pname) {
       const result = gl.getFramebufferAttachmentParameter(target, attachment, pname);
@@ -297,7 +321,7 @@ export default function createBindings(renderer, memory) {
       return result;
     },
     glIsFramebuffer(framebuffer) {
-      return objects_.has(framebuffer) && gl.isFramebuffer(objects_.get(framebuffer));
+      return gl.isFramebuffer(object(framebuffer));
     },
     glReadPixels(x, y, width, height, format, type, pixels) {
       gl.readPixels(x, y, width, height, format, type, typedData(type, pixels));
@@ -306,7 +330,7 @@ export default function createBindings(renderer, memory) {
     // WebGL2
     glBlitFramebuffer: bindOptional(gl.blitFramebuffer),
     glFramebufferTextureLayer(target, attachment, texture, level, layer) {
-      gl.framebufferTextureLayer(target, attachment, objects_.get(texture), level, layer);
+      gl.framebufferTextureLayer(target, attachment, object(texture), level, layer);
     },
     glInvalidateFramebuffer(target, numAttachments, attachments) {
       const view = uint32View();
@@ -330,22 +354,19 @@ export default function createBindings(renderer, memory) {
 
     // Renderbuffers
     glBindRenderbuffer(target, renderbuffer) {
-      gl.bindRenderbuffer(target, objects_.get(renderbuffer));
+      gl.bindRenderbuffer(target, object(renderbuffer));
     },
     glCreateRenderbuffer(index) {
       const renderbuffer = gl.createRenderbuffer();
-      objects_.set(index, renderbuffer);
-      objectsReverse_.set(renderbuffer, index);
+      setObject(index, renderbuffer);
     },
     glDeleteRenderbuffer(index) {
-      const renderbuffer = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(renderbuffer);
+      const renderbuffer = deleteObject(index);
       gl.deleteRenderbuffer(renderbuffer);
     },
     glGetRenderbufferParameter: gl.getRenderbufferParameter.bind(gl),
     glIsRenderbuffer(renderbuffer) {
-      return objects_.has(renderbuffer) && gl.isRenderbuffer(objects_.get(renderbuffer));
+      return gl.isRenderbuffer(object(renderbuffer));
     },
     glRenderbufferStorage: gl.renderbufferStorage.bind(gl),
     // WebGL2
@@ -360,7 +381,7 @@ export default function createBindings(renderer, memory) {
 
     // Textures
     glBindTexture(target, texture) {
-      gl.bindTexture(target, objects_.get(texture));
+      gl.bindTexture(target, object(texture));
     },
     glCompressedTexImage2D(target, level, internalformat, width, height, border, imageSize, data) {
       gl.compressedTexImage2D(target, level, internalformat, width, height, border, new Uint8Array(arrayBuffer(), data, imageSize));
@@ -374,13 +395,10 @@ export default function createBindings(renderer, memory) {
     glCopyTexSubImage2D: gl.copyTexSubImage2D.bind(gl),
     glCreateTexture(index) {
       const texture = gl.createTexture();
-      objects_.set(index, texture);
-      objectsReverse_.set(texture, index);
+      setObject(index, texture);
     },
     glDeleteTexture(index) {
-      const texture = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(texture);
+      const texture = deleteObject(index);
       gl.deleteTexture(texture);
     },
     glGenerateMipmap: gl.generateMipmap.bind(gl),
@@ -393,7 +411,7 @@ export default function createBindings(renderer, memory) {
       float32View()[params >> 2] = gl.getTexParameter(target, pname);
     },
     glIsTexture(texture) {
-      return objects_.has(texture) && gl.isTexture(objects_.get(texture));
+      return gl.isTexture(object(texture));
     },
     glTexImage2D(target, level, internalformat, width, height, border, format, type, data) {
       if (data) {
@@ -437,59 +455,53 @@ export default function createBindings(renderer, memory) {
 
     // Programs and shaders
     glAttachShader(program, shader) {
-      gl.attachShader(objects_.get(program), objects_.get(shader));
+      gl.attachShader(object(program), object(shader));
     },
     glBindAttribLocation(program, index, name) {
-      gl.bindAttribLocation(objects_.get(program), index, readString(name));
+      gl.bindAttribLocation(object(program), index, readString(name));
     },
     glCompileShader(shader) {
-      gl.compileShader(objects_.get(shader));
+      gl.compileShader(object(shader));
     },
     glCreateProgram(index) {
       const program = gl.createProgram();
-      objects_.set(index, program);
-      objectsReverse_.set(program, index);
+      setObject(index, program);
     },
     glCreateShader(index, type) {
       const shader = gl.createShader(type);
-      objects_.set(index, shader);
-      objectsReverse_.set(shader, index);
+      setObject(index, shader);
     },
     glDeleteProgram(index) {
-      const program = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(program);
+      const program = deleteObject(index);
       gl.deleteProgram(program);
     },
     glDeleteShader(index) {
-      const shader = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(shader);
+      const shader = deleteObject(index);
       gl.deleteShader(shader);
     },
     glDetachShader(program, shader) {
-      gl.detachShader(objects_.get(program), objects_.get(shader));
+      gl.detachShader(object(program), object(shader));
     },
     glGetAttachedShaders(program, maxCount, count, shaders) {
-      const result = gl.getAttachedShaders(program);
+      const result = gl.getAttachedShaders(object(program));
       const length = Math.min(maxCount, result.length);
       const view = uint32View();
       shaders >>= 2;
       for (let i = 0; i < length; ++i) {
-        view[shaders + i] = objects_.get(result[i]);
+        view[shaders + i] = objectsReverse_.get(result[i]);
       }
       if (count) {
         view[count >> 2] = length;
       }
     },
     glGetProgrami(program, pname) {
-      return gl.getProgramParameter(objects_.get(program), pname);
+      return gl.getProgramParameter(object(program), pname);
     },
     glGetProgramInfoLog(program, maxLength, length, infoLog) {
-      writeString(gl.getProgramInfoLog(objects_.get(program)), maxLength, length, infoLog);
+      writeString(gl.getProgramInfoLog(object(program)), maxLength, length, infoLog);
     },
     glGetShaderi(shader, pname) {
-      return gl.getShaderParameter(objects_.get(shader), pname);
+      return gl.getShaderParameter(object(shader), pname);
     },
     glGetShaderPrecisionFormat(shaderType, precisionType, range, precision) {
       const format = gl.getShaderPrecisionFormat(shaderType, precisionType);
@@ -500,28 +512,28 @@ export default function createBindings(renderer, memory) {
       view[precision >> 2] = format.precision;
     },
     glGetShaderInfoLog(shader, maxLength, length, infoLog) {
-      writeString(gl.getShaderInfoLog(objects_.get(shader)), maxLength, length, infoLog);
+      writeString(gl.getShaderInfoLog(object(shader)), maxLength, length, infoLog);
     },
     glGetShaderSource(shader, bufSize, length, source) {
-      writeString(gl.getShaderSource(objects_.get(shader)), bufSize, length, source);
+      writeString(gl.getShaderSource(object(shader)), bufSize, length, source);
     },
     glIsProgram(program) {
-      return objects_.has(program) && gl.isProgram(objects_.get(program));
+      return gl.isProgram(object(program));
     },
     glIsShader(shader) {
-      return objects_.has(shader) && gl.isShader(objects_.get(shader));
+      return gl.isShader(object(shader));
     },
     glLinkProgram(program) {
-      gl.linkProgram(objects_.get(program));
+      gl.linkProgram(object(program));
     },
     glShaderSource(shader, source) {
-      gl.shaderSource(objects_.get(shader), readString(source));
+      gl.shaderSource(object(shader), readString(source));
     },
     glUseProgram(program) {
-      gl.useProgram(objects_.get(program));
+      gl.useProgram(object(program));
     },
     glValidateProgram(program) {
-      gl.validateProgram(objects_.get(program));
+      gl.validateProgram(object(program));
     },
     // WebGL2
     glGetFragDataLocation(program, name) {
@@ -532,40 +544,40 @@ export default function createBindings(renderer, memory) {
     glDisableVertexAttribArray: gl.disableVertexAttribArray.bind(gl),
     glEnableVertexAttribArray: gl.enableVertexAttribArray.bind(gl),
     glGetActiveAttrib(program, index, bufSize, length, size, type, name) {
-      const info = gl.getActiveAttrib(objects_.get(program), index);
+      const info = gl.getActiveAttrib(object(program), index);
       const view = uint32View();
       view[size >> 2] = info.size;
       view[type >> 2] = info.type;
       writeString(info.name, bufSize, length, name);
     },
     glGetActiveUniform(program, index, bufSize, length, size, type, name) {
-      const info = gl.getActiveUniform(objects_.get(program), index);
+      const info = gl.getActiveUniform(object(program), index);
       const view = uint32View();
       view[size >> 2] = info.size;
       view[type >> 2] = info.type;
       writeString(info.name, bufSize, length, name);
     },
     glGetAttribLocation(program, name) {
-      return gl.getAttribLocation(objects_.get(program), readString(name));
+      return gl.getAttribLocation(object(program), readString(name));
     },
     glGetUniformfv(program, location, params) {
-      const result = gl.getUniform(objects_.get(program), uniformLocations_.get(location));
+      const result = gl.getUniform(object(program), uniformLocations_[location]);
       writeFloat32(result, params);
     },
     glGetUniformiv(program, location, params) {
-      const result = gl.getUniform(objects_.get(program), uniformLocations_.get(location));
+      const result = gl.getUniform(object(program), uniformLocations_[location]);
       writeInt32(result, params);
     },
     glGetUniformuiv(program, location, params) {
-      const result = gl.getUniform(objects_.get(program), uniformLocations_.get(location));
+      const result = gl.getUniform(object(program), uniformLocations_[location]);
       writeUint32(result, params);
     },
     glGetUniformLocation(program, name) {
-      const location = gl.getUniformLocation(objects_.get(program), readString(name));
+      const location = gl.getUniformLocation(object(program), readString(name));
       let index = uniformLocationsReverse_.get(location);
       if (index == null) {
-        index = uniformLocations_.size + 1;
-        uniformLocations_.set(index, location);
+        index = uniformLocations_.length;
+        uniformLocations_.push(location);
         uniformLocationsReverse_.set(location, index);
       }
       return index;
@@ -693,20 +705,17 @@ export default function createBindings(renderer, memory) {
     // Query objects (WebGL2)
     glCreateQuery(index) {
       const query = gl.createQuery();
-      objects_.set(index, query);
-      objectsReverse_.set(query, index);
+      setObject(index, query);
     },
     glDeleteQuery(index) {
-      const query = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(query);
+      const query = deleteObject(index);
       gl.deleteQuery(query);
     },
     glIsQuery(query) {
-      return objects_.has(query) && gl.isQuery(objects_.get(query));
+      return gl.isQuery(object(query));
     },
     glBeginQuery(target, query) {
-      gl.beginQuery(target, objects_.get(query));
+      gl.beginQuery(target, object(query));
     },
     glEndQuery: bindOptional(gl.endQuery),
     glGetQuery(target, pname) {
@@ -726,75 +735,73 @@ export default function createBindings(renderer, memory) {
       int32View()[params >> 2] = result;
     },
     glGetQueryParameter(query, pname) {
-      return gl.getQueryParameter(objects_.get(query), pname);
+      return gl.getQueryParameter(object(query), pname);
     },
     glGetQueryObjectiv(id, pname, params) {
-      int32View()[params >> 2] = gl.getQueryParameter(objects_.get(id), pname);
+      int32View()[params >> 2] = gl.getQueryParameter(object(id), pname);
     },
     glGetQueryObjectuiv(id, pname, params) {
-      uint32View()[params >> 2] = gl.getQueryParameter(objects_.get(id), pname);
+      uint32View()[params >> 2] = gl.getQueryParameter(object(id), pname);
     },
 
     // Sampler objects (WebGL2)
     glCreateSampler(index) {
       const sampler = gl.createSampler();
-      objects_.set(index, sampler);
-      objectsReverse_.set(sampler, index);
+      setObject(index, sampler);
     },
     glDeleteSampler(index) {
-      const sampler = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(sampler);
+      const sampler = deleteObject(index);
       gl.deleteSampler(sampler);
     },
     glBindSampler(unit, sampler) {
-      gl.bindSampler(unit, objects_.get(sampler));
+      gl.bindSampler(unit, object(sampler));
     },
     glIsSampler(sampler) {
-      return objects_.has(sampler) && gl.isSampler(objects_.get(sampler));
+      return gl.isSampler(object(sampler));
+    },
+    glSamplerParameteri(sampler, pname, param) {
+      gl.samplerParameteri(object(sampler), pname, param);
+    },
+    glSamplerParameterf(sampler, pname, param) {
+      gl.samplerParameterf(object(sampler), pname, param);
     },
-    glSamplerParameteri: bindOptional(gl.samplerParameteri),
-    glSamplerParameterf: bindOptional(gl.samplerParameterf),
     glGetSamplerParameteri(sampler, pname) {
-      return gl.getSamplerParameter(objects_.get(sampler), pname);
+      return gl.getSamplerParameter(object(sampler), pname);
     },
     glGetSamplerParameterf(sampler, pname) {
-      return gl.getSamplerParameter(objects_.get(sampler), pname);
+      return gl.getSamplerParameter(object(sampler), pname);
     },
     glGetSamplerParameteriv(sampler, pname, params) {
-      int32View()[params >> 2] = gl.getSamplerParameter(objects_.get(sampler), pname);
+      int32View()[params >> 2] = gl.getSamplerParameter(object(sampler), pname);
     },
     glGetSamplerParameterfv(sampler, pname, params) {
-      float32View()[params >> 2] = gl.getSamplerParameter(objects_.get(sampler), pname);
+      float32View()[params >> 2] = gl.getSamplerParameter(object(sampler), pname);
     },
 
     // Sync objects (WebGL2)
     glFenceSync(index, condition, flags) {
       const sync = gl.fenceSync(condition, flags);
-      objects_.set(index, sync);
-      objectsReverse_.set(sync, index);
+      setObject(index, sync);
     },
     glDeleteSync(index) {
-      const sync = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(sync);
+      const sync = deleteObject(index);
       gl.deleteSync(sync);
     },
     glIsSync(sync) {
-      return objects_.has(sync) && gl.isSync(objects_.get(sync));
+      return gl.isSync(object(sync));
     },
     glClientWaitSync(sync, flags, timeout) {
-      return gl.clientWaitSync(objects_.get(sync), flags, timeout);
+      return gl.clientWaitSync(object(sync), flags, timeout);
     },
     glWaitSync(sync, flags, timeout) {
-      return gl.waitSync(objects_.get(sync), flags, timeout);
+      return gl.waitSync(object(sync), flags, timeout);
     },
     glGetSynci(sync, pname) {
-      return gl.getSyncParameter(objects_.get(sync), pname);
+      return gl.getSyncParameter(object(sync), pname);
     },
     glGetSynciv(sync, pname, bufSize, length, values) {
       const view = int32View();
-      view[values >> 2] = gl.getSyncParameter(objects_.get(sync), pname);
+      view[values >> 2] = gl.getSyncParameter(object(sync), pname);
       if (length) {
         view[length >> 2] = 1;
       }
@@ -803,20 +810,17 @@ export default function createBindings(renderer, memory) {
     // Transform feedback (WebGL2)
     glCreateTransformFeedback(index) {
       const transformFeedback = gl.createTransformFeedback();
-      objects_.set(index, transformFeedback);
-      objectsReverse_.set(transformFeedback, index);
+      setObject(index, transformFeedback);
     },
     glDeleteTransformFeedback(index) {
-      const transformFeedback = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(transformFeedback);
+      const transformFeedback = deleteObject(index);
       gl.deleteTransformFeedback(transformFeedback);
     },
     glIsTransformFeedback(transformFeedback) {
-      return objects_.has(transformFeedback) && gl.isTransformFeedback(objects_.get(transformFeedback));
+      return gl.isTransformFeedback(object(transformFeedback));
     },
     glBindTransformFeedback(target, transformFeedback) {
-      gl.bindTransformFeedback(target, objects_.get(transformFeedback));
+      gl.bindTransformFeedback(target, object(transformFeedback));
     },
     glBeginTransformFeedback: bindOptional(gl.beginTransformFeedback),
     glEndTransformFeedback: bindOptional(gl.endTransformFeedback),
@@ -827,10 +831,10 @@ export default function createBindings(renderer, memory) {
       for (let i = 0; i < count; ++i) {
         tmpArray[i] = readString(view[varyings + i]);
       }
-      gl.transformFeedbackVaryings(objects_.get(program), tmpArray, bufferMode);
+      gl.transformFeedbackVaryings(object(program), tmpArray, bufferMode);
     },
     glGetTransformFeedbackVarying(program, index, bufSize, length, size, type, name) {
-      const info = gl.getTransformFeedbackVarying(objects_.get(program), index);
+      const info = gl.getTransformFeedbackVarying(object(program), index);
       const view = uint32View();
       view[size >> 2] = info.size;
       view[type >> 2] = info.type;
@@ -841,10 +845,10 @@ export default function createBindings(renderer, memory) {
 
     // Uniform buffer objects (WebGL2)
     glBindBufferBase(target, index, buffer) {
-      gl.bindBufferBase(target, index, objects_.get(buffer));
+      gl.bindBufferBase(target, index, object(buffer));
     },
     glBindBufferRange(target, index, buffer, offset, size) {
-      gl.bindBufferRange(target, index, objects_.get(buffer), offset, size);
+      gl.bindBufferRange(target, index, object(buffer), offset, size);
     },
     glGetUniformIndices(program, uniformCount, uniformNames, uniformIndices) {
       const view = uint32View();
@@ -853,7 +857,7 @@ export default function createBindings(renderer, memory) {
       for (let i = 0; i < uniformCount; ++i) {
         tmpArray[i] = readString(view[uniformNames + i]);
       }
-      view.set(gl.getUniformIndices(objects_.get(program), tmpArray), uniformIndices >> 2);
+      view.set(gl.getUniformIndices(object(program), tmpArray), uniformIndices >> 2);
     },
     glGetActiveUniformsiv(program, uniformCount, uniformIndices, pname, params) {
       const view = uint32View();
@@ -862,39 +866,36 @@ export default function createBindings(renderer, memory) {
       for (let i = 0; i < uniformCount; ++i) {
         tmpArray[i] = view[uniformIndices + i];
       }
-      const results = gl.getActiveUniforms(objects_.get(program), tmpArray, pname);
+      const results = gl.getActiveUniforms(object(program), tmpArray, pname);
       view.set(results, params >> 2);
     },
     glGetUniformBlockIndex(program, uniformBlockName) {
-      gl.getUniformBlockIndex(objects_.get(program), readString(uniformBlockName));
+      return gl.getUniformBlockIndex(object(program), readString(uniformBlockName));
     },
     glGetActiveUniformBlockiv(program, uniformBlockIndex, pname, params) {
-      writeInt32(params, gl.getActiveUniformBlockParameter(objects_.get(program), uniformBlockIndex, pname));
+      writeInt32(gl.getActiveUniformBlockParameter(object(program), uniformBlockIndex, pname), params);
     },
     glGetActiveUniformBlockName(program, uniformBlockIndex, bufSize, length, uniformBlockName) {
-      writeString(gl.getActiveUniformBlockName(objects_.get(program), uniformBlockIndex), bufSize, length, uniformBlockName);
+      writeString(gl.getActiveUniformBlockName(object(program), uniformBlockIndex), bufSize, length, uniformBlockName);
     },
     glUniformBlockBinding(program, uniformBlockIndex, uniformBlockBinding) {
-      gl.uniformBlockBinding(objects_.get(program), uniformBlockIndex, uniformBlockBinding);
+      gl.uniformBlockBinding(object(program), uniformBlockIndex, uniformBlockBinding);
     },
 
     // Vertex array objects (WebGL2)
-    glCreateVertexArray() {
+    glCreateVertexArray(index) {
       const vertexArray = gl.createVertexArray();
-      objects_.set(index, vertexArray);
-      objectsReverse_.set(vertexArray, index);
+      setObject(index, vertexArray);
     },
     glDeleteVertexArray(index) {
-      const vertexArray = objects_.get(index);
-      objects_.delete(index);
-      objectsReverse_.delete(vertexArray);
+      const vertexArray = deleteObject(index);
       gl.deleteVertexArray(vertexArray);
     },
     glIsVertexArray(vertexArray) {
-      return objects_.has(vertexArray) && gl.isVertexArray(objects_.get(vertexArray));
+      return gl.isVertexArray(object(vertexArray));
     },
     glBindVertexArray(vertexArray) {
-      gl.bindVertexArray(objects_.get(vertexArray));
+      gl.bindVertexArray(object(vertexArray));
     },
 
     // Working with extensions
@@ -975,24 +976,21 @@ export default function createBindings(renderer, memory) {
     bindExtension("EXT_disjoint_timer_query", {
       glCreateQuery(ext, index) {
         const query = ext.createQueryEXT();
-        objects_.set(index, query);
-        objectsReverse_.set(query, index);
+        setObject(index, query);
       },
       glDeleteQuery(ext, index) {
-        const query = objects_.get(index);
-        objects_.delete(index);
-        objectsReverse_.delete(query);
+        const query = deleteObject(index);
         ext.deleteQueryEXT(query);
       },
       glIsQuery(ext, query) {
-        return objects_.has(query) && ext.isQueryEXT(objects_.get(query));
+        return ext.isQueryEXT(object(query));
       },
       glBeginQuery(ext, target, query) {
-        ext.beginQueryEXT(target, objects_.get(query));
+        ext.beginQueryEXT(target, object(query));
       },
       glEndQuery: "endQueryEXT",
       glQueryCounter(ext, query, target) {
-        ext.queryCounterEXT(objects_.get(query), target);
+        ext.queryCounterEXT(object(query), target);
       },
       glGetQuery(ext, target, pname) {
         const result = ext.getQueryEXT(target, pname);
@@ -1011,33 +1009,30 @@ export default function createBindings(renderer, memory) {
         int32View()[params >> 2] = result;
       },
       glGetQueryParameter(ext, query, pname) {
-        return ext.getQueryObjectEXT(objects_.get(query), pname);
+        return ext.getQueryObjectEXT(object(query), pname);
       },
-      glGetQueryObjectiv(id, pname, params) {
-        int32View()[params >> 2] = gl.ext.getQueryObjectEXT(objects_.get(id), pname);
+      glGetQueryObjectiv(ext, id, pname, params) {
+        int32View()[params >> 2] = ext.getQueryObjectEXT(object(id), pname);
       },
-      glGetQueryObjectuiv(id, pname, params) {
-        uint32View()[params >> 2] = gl.ext.getQueryObjectEXT(objects_.get(id), pname);
+      glGetQueryObjectuiv(ext, id, pname, params) {
+        uint32View()[params >> 2] = ext.getQueryObjectEXT(object(id), pname);
       },
     });
 
     bindExtension("OES_vertex_array_object", {
       glCreateVertexArray(ext, index) {
         const vertexArray = ext.createVertexArrayOES();
-        objects_.set(index, vertexArray);
-        objectsReverse_.set(vertexArray, index);
+        setObject(index, vertexArray);
       },
       glDeleteVertexArray(ext, index) {
-        const vertexArray = objects_.get(index);
-        objects_.delete(index);
-        objectsReverse_.delete(vertexArray);
+        const vertexArray = deleteObject(index);
         ext.deleteVertexArrayOES(vertexArray);
       },
       glIsVertexArray(ext, vertexArray) {
-        return objects_.has(vertexArray) && ext.isVertexArrayOES(objects_.get(vertexArray));
+        return ext.isVertexArrayOES(object(vertexArray));
       },
       glBindVertexArray(ext, vertexArray) {
-        ext.bindVertexArrayOES(objects_.get(vertexArray));
+        ext.bindVertexArrayOES(object(vertexArray));
       },
     });
 
@@ -1055,14 +1050,30 @@ export default function createBindings(renderer, memory) {
   } else {
     bindExtension("EXT_disjoint_timer_query_webgl2", {
       glQueryCounter(ext, query, target) {
-        ext.queryCounterEXT(objects_.get(query), target);
+        ext.queryCounterEXT(object(query), target);
       },
     });
   }
 
   bindExtension("WEBGL_debug_shaders", {
     glGetTranslatedShaderSource(ext, shader, maxSize, length, data) {
-      writeString(ext.getTranslatedShaderSource(objects_.get(shader)), maxSize, length, data);
+      writeString(ext.getTranslatedShaderSource(object(shader)), maxSize, length, data);
+    },
+  });
+
+  // Counts, firsts and offsets are 32-bit arrays in linear memory
+  bindExtension("WEBGL_multi_draw", {
+    glMultiDrawArrays(ext, mode, firsts, counts, drawCount) {
+      const view = int32View();
+      ext.multiDrawArraysWEBGL(mode, view, firsts >> 2, view, counts >> 2, drawCount);
+    },
+    glMultiDrawElements(ext, mode, counts, type, offsets, drawCount) {
+      const view = int32View();
+      ext.multiDrawElementsWEBGL(mode, view, counts >> 2, type, view, offsets >> 2, drawCount);
+    },
+    glMultiDrawElementsInstanced(ext, mode, counts, type, offsets, instanceCounts, drawCount) {
+      const view = int32View();
+      ext.multiDrawElementsInstancedWEBGL(mode, view, counts >> 2, type, view, offsets >> 2, view, instanceCounts >> 2, drawCount);
     },
   });
 
@@ -1075,5 +1086,34 @@ export default function createBindings(renderer, memory) {
     },
   });
 
+  // Frame stats
+  bindings.glFrameStats = function(stats) {
+    renderer.frameStats_ = stats;
+  };
+
+  // Command buffer
+  bindings.glExecuteCommands = createCommandDecoder(bindings, memory);
+  bindings.glSaveTrace = function(trace, size) {
+    if (renderer.onTrace) {
+      renderer.onTrace(arrayBuffer().slice(trace, trace + size));
+    }
+  };
+
+  // Leak check: objects still alive at shutdown, as WebGL objects or, for objects
+  // without one, their handles
+  bindings.glReportLeaks = function(handles, count) {
+    const view = uint32View();
+    const leaked = [];
+    for (let i = 0; i < count; ++i) {
+      const handle = view[(handles >> 2) + i];
+      leaked.push(object(handle) || handle);
+    }
+    if (renderer.onLeaks) {
+      renderer.onLeaks(leaked);
+    } else {
+      console.warn(`${count} GL object(s) leaked`, leaked);
+    }
+  };
+
   return bindings;
 }